@@ -9,6 +9,7 @@
 #include "common/RedtapeWindows.h"
 #endif
 
+#include <cerrno>
 #include <limits>
 
 // --------------------------------------------------------------------------------------
@@ -62,6 +63,19 @@ void Threading::WorkSema::WaitForWork()
 
 void Threading::WorkSema::WaitForWorkWithSpin()
 {
+	u32 spun_ns;
+	u64 slept_ns;
+	WaitForWorkWithSpin(SPIN_TIME_NS, &spun_ns, &slept_ns);
+}
+
+static u64 TicksToNanoseconds(u64 ticks)
+{
+	return static_cast<u64>(static_cast<double>(ticks) * (1e9 / static_cast<double>(GetTickFrequency())));
+}
+
+void Threading::WorkSema::WaitForWorkWithSpin(u32 spin_ns, u32* spun_ns, u64* slept_ns)
+{
+	*slept_ns = 0;
 	s32 value = m_state.load(std::memory_order_relaxed);
 	pxAssert(!IsDead(value));
 	while (IsReadyForSleep(value))
@@ -77,16 +91,19 @@ void Threading::WorkSema::WaitForWorkWithSpin()
 	u32 waited = 0;
 	while (value < 0)
 	{
-		if (waited > SPIN_TIME_NS)
+		if (waited >= spin_ns)
 		{
 			if (!m_state.compare_exchange_weak(value, STATE_SLEEPING, std::memory_order_relaxed))
 				continue;
+			const u64 start = GetCPUTicks();
 			m_sema.Wait();
+			*slept_ns = TicksToNanoseconds(GetCPUTicks() - start);
 			break;
 		}
 		waited += ShortSpin();
 		value = m_state.load(std::memory_order_relaxed);
 	}
+	*spun_ns = waited;
 	// Clear back to STATE_RUNNING_0 (but preserve waiting empty flag)
 	m_state.fetch_and(STATE_FLAG_WAITING_EMPTY, std::memory_order_acquire);
 }
@@ -108,20 +125,31 @@ bool Threading::WorkSema::WaitForEmpty()
 }
 
 bool Threading::WorkSema::WaitForEmptyWithSpin()
+{
+	u32 spun_ns;
+	u64 slept_ns;
+	return WaitForEmptyWithSpin(SPIN_TIME_NS, &spun_ns, &slept_ns);
+}
+
+bool Threading::WorkSema::WaitForEmptyWithSpin(u32 spin_ns, u32* spun_ns, u64* slept_ns)
 {
 	s32 value = m_state.load(std::memory_order_acquire);
 	u32 waited = 0;
+	*slept_ns = 0;
 	while (true)
 	{
+		*spun_ns = waited;
 		if (value < 0)
 			return !IsDead(value); // STATE_SLEEPING or STATE_SPINNING, queue is empty!
-		if (waited > SPIN_TIME_NS && m_state.compare_exchange_weak(value, value | STATE_FLAG_WAITING_EMPTY, std::memory_order_acquire))
+		if (waited >= spin_ns && m_state.compare_exchange_weak(value, value | STATE_FLAG_WAITING_EMPTY, std::memory_order_acquire))
 			break;
 		waited += ShortSpin();
 		value = m_state.load(std::memory_order_acquire);
 	}
 	pxAssertMsg(!(value & STATE_FLAG_WAITING_EMPTY), "Multiple threads attempted to wait for empty (not currently supported)");
+	const u64 start = GetCPUTicks();
 	m_empty_sema.Wait();
+	*slept_ns = TicksToNanoseconds(GetCPUTicks() - start);
 	return !IsDead(m_state.load(std::memory_order_relaxed));
 }
 
@@ -171,7 +199,9 @@ void Threading::KernelSemaphore::Wait()
 #ifdef _WIN32
 	WaitForSingleObject(m_sema, INFINITE);
 #else
-	sem_wait(&m_sema);
+	// Interrupted by signals, e.g. from the JIT profiler.
+	while (sem_wait(&m_sema) != 0 && errno == EINTR)
+		;
 #endif
 }
 
@@ -143,6 +143,14 @@ namespace Threading
 		bool TryWait();
 	};
 
+	/// Running totals of the time spent spinning and sleeping on a WorkSema
+	/// Written by the waiting thread, may be read from any thread
+	struct WorkSemaWaitTimes
+	{
+		std::atomic<u64> spin_ns{0};
+		std::atomic<u64> sleep_ns{0};
+	};
+
 	/// A semaphore for notifying a work-processing thread of new work in a (separate) queue
 	///
 	/// Usage:
@@ -207,12 +215,17 @@ namespace Threading
 		void WaitForWork();
 		/// Wait for work to be added to the queue, spinning for a bit before sleeping the thread
 		void WaitForWorkWithSpin();
+		/// Wait for work to be added to the queue, spinning for up to `spin_ns` before sleeping the thread
+		/// `spun_ns` receives the time spent spinning, `slept_ns` the time spent asleep (zero if the spin caught the work)
+		void WaitForWorkWithSpin(u32 spin_ns, u32* spun_ns, u64* slept_ns);
 		/// Wait for the worker thread to finish processing all entries in the queue or die
 		/// Returns false if the thread is dead
 		bool WaitForEmpty();
 		/// Wait for the worker thread to finish processing all entries in the queue or die, spinning a bit before sleeping the thread
 		/// Returns false if the thread is dead
 		bool WaitForEmptyWithSpin();
+		/// Like WaitForEmptyWithSpin, but spinning for up to `spin_ns`, and reporting the time spent spinning and asleep
+		bool WaitForEmptyWithSpin(u32 spin_ns, u32* spun_ns, u64* slept_ns);
 		/// Called by the worker thread to notify others of its death
 		/// Dead threads don't process work, and WaitForEmpty will return instantly even though there may be work in the queue
 		void Kill();
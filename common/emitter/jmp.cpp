@@ -193,7 +193,9 @@ namespace x86Emitter
 		}
 
 		if (is_s8(displacement8))
-			xJcc8(comparison, displacement8);
+		{
+			xRecordRelocation(xReloc_Rel8, xJcc8(comparison, displacement8), target);
+		}
 		else
 		{
 			// Perform a 32 bit jump instead. :(
@@ -204,6 +206,7 @@ namespace x86Emitter
 			pxAssertMsg(distance >= -0x80000000LL && distance < 0x80000000LL, "Jump target is too far away, needs an indirect register");
 
 			*bah = (s32)distance;
+			xRecordRelocation(xReloc_Rel32, bah, target);
 		}
 	}
 
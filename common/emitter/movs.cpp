@@ -129,6 +129,7 @@ namespace x86Emitter
 		{
 			u8 opcode = 0xb8 | to.Id;
 			xOpAccWrite(to.GetPrefix16(), opcode, 0, to);
+			xRecordRelocation(xReloc_Abs64, xGetPtr(), (const void*)imm);
 			xWrite64(imm);
 		}
 	}
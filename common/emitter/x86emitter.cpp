@@ -50,6 +50,7 @@
 
 thread_local u8* x86Ptr;
 thread_local XMMSSEType g_xmmtypes[iREGCNT_XMM] = {XMMT_INT};
+static thread_local std::vector<x86Emitter::xRelocation>* s_relocation_log;
 
 bool x86Emitter::use_avx;
 
@@ -82,6 +83,17 @@ namespace x86Emitter
 		xWrite(val);
 	}
 
+	void xSetRelocationLog(std::vector<xRelocation>* log)
+	{
+		s_relocation_log = log;
+	}
+
+	void xRecordRelocation(xRelocationType type, void* field, const void* target)
+	{
+		if (s_relocation_log) [[unlikely]]
+			s_relocation_log->push_back({static_cast<u8*>(field), target, type});
+	}
+
 	// Empty initializers are due to frivolously pointless GCC errors (it demands the
 	// objects be initialized even though they have no actual variable members).
 
@@ -311,6 +323,7 @@ const xRegister32
 			SibSB(0, Sib_EIZ, Sib_UseDisp32);
 		}
 
+		xRecordRelocation((displacement == ripRelative) ? xReloc_Rel32 : xReloc_Abs32, x86Ptr, address);
 		xWrite<s32>((s32)displacement);
 	}
 
@@ -386,6 +399,7 @@ const xRegister32
 			{
 				ModRM(0, regfield, ModRm_UseSib);
 				SibSB(info.Scale, info.Index.Id, Sib_UseDisp32);
+				xRecordRelocation(xReloc_Abs32, x86Ptr, (const void*)info.Displacement);
 				xWrite<s32>(info.Displacement);
 				return;
 			}
@@ -402,9 +416,14 @@ const xRegister32
 		if (displacement_size != 0)
 		{
 			if (displacement_size == 1)
+			{
 				xWrite<s8>(info.Displacement);
+			}
 			else
+			{
+				xRecordRelocation(xReloc_Abs32, x86Ptr, (const void*)info.Displacement);
 				xWrite<s32>(info.Displacement);
+			}
 		}
 	}
 
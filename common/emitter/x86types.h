@@ -7,6 +7,8 @@
 #include "common/Assertions.h"
 #include "common/Pcsx2Defs.h"
 
+#include <vector>
+
 static const uint iREGCNT_XMM = 16;
 static const uint iREGCNT_GPR = 16;
 
@@ -144,6 +146,33 @@ namespace x86Emitter
 
 	extern JccComparisonType xInvertCond(JccComparisonType src);
 
+	// --------------------------------------------------------------------------------------
+	//  xRelocation
+	// --------------------------------------------------------------------------------------
+	// Describes a host address which was encoded into the instruction stream.  Relocations are
+	// only recorded while a log is installed with xSetRelocationLog(), which lets a recompiler
+	// move generated code elsewhere (or persist it) without re-emitting it.
+	//
+	// Forward jumps (xForwardJump and the legacy J32 helpers) are patched after the fact and are
+	// not recorded, so they must only ever target code within the same buffer.
+	enum xRelocationType : u8
+	{
+		xReloc_Rel8, // s8 displacement, relative to the end of the instruction
+		xReloc_Rel32, // s32 displacement, relative to the end of the instruction (includes RIP-relative operands)
+		xReloc_Abs32, // s32 absolute displacement (no base register, or [reg+disp32])
+		xReloc_Abs64, // 64-bit immediate
+	};
+
+	struct xRelocation
+	{
+		u8* field; // address of the displacement/immediate in the code buffer
+		const void* target; // address which was encoded
+		xRelocationType type;
+	};
+
+	extern void xSetRelocationLog(std::vector<xRelocation>* log);
+	extern void xRecordRelocation(xRelocationType type, void* field, const void* target);
+
 	class xAddressVoid;
 
 	// --------------------------------------------------------------------------------------
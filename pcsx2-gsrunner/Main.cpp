@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
 // SPDX-License-Identifier: GPL-3.0+
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <csignal>
@@ -25,6 +26,7 @@
 #include "common/ProgressCallback.h"
 #include "common/SettingsWrapper.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 
 #include "pcsx2/PrecompiledHeader.h"
 
@@ -62,6 +64,11 @@ namespace GSRunner
 	static void SettingsOverride();
 	static bool ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& params);
 	static void DumpStats();
+	static void RecordBenchmarkFrame(s32 loop_number);
+	static bool WriteBenchmarkResults(const std::string& dump_filename);
+	static bool CollectBatchDumps(const std::string& path);
+	static bool RunBatch(VMBootParameters& params);
+	static bool WriteBatchManifest();
 
 	static bool CreatePlatformWindow();
 	static void DestroyPlatformWindow();
@@ -76,9 +83,27 @@ static constexpr u32 WINDOW_HEIGHT = 480;
 static MemorySettingsInterface s_settings_interface;
 
 static std::string s_output_prefix;
+static std::string s_output_dir;
 static s32 s_loop_count = 1;
+static std::optional<u32> s_dump_start_frame;
+static std::optional<u64> s_dump_start_draw;
 static std::optional<bool> s_use_window;
 static bool s_no_console = false;
+static u32 s_benchmark_runs = 0;
+static u32 s_benchmark_warmup = 1;
+static std::string s_benchmark_output;
+static std::vector<std::string> s_batch_dumps;
+static std::string s_batch_manifest;
+static std::optional<u32> s_trim_start;
+static u32 s_trim_end = 0;
+static std::string s_trim_output;
+static bool s_trim_reached = false;
+
+/// Frames to keep playing past the end of the trim range, so the new dump can finish on its own.
+static constexpr u32 TRIM_EXTRA_FRAMES = 4;
+
+static std::mutex s_last_error_lock;
+static std::string s_last_error;
 
 // Owned by the GS thread.
 static u32 s_dump_frame_number = 0;
@@ -99,6 +124,48 @@ static u64 s_total_uploads = 0;
 static u64 s_total_readbacks = 0;
 static u32 s_total_frames = 0;
 static u32 s_total_drawn_frames = 0;
+static bool s_trim_queued = false;
+
+struct BenchmarkCounters
+{
+	u64 draws;
+	u64 draw_calls;
+	u64 render_passes;
+	u64 barriers;
+	u64 copies;
+	u64 uploads;
+	u64 readbacks;
+};
+
+struct BenchmarkFrame
+{
+	double wall_ms;
+	double gs_cpu_ms;
+	double sw_cpu_ms;
+};
+
+struct BenchmarkRun
+{
+	std::vector<BenchmarkFrame> frames;
+	BenchmarkCounters start_counters;
+};
+
+static std::vector<BenchmarkRun> s_benchmark_results;
+
+struct BatchResult
+{
+	std::string path;
+	std::string error;
+	double seconds;
+	u32 frames;
+	u32 drawn_frames;
+	BenchmarkCounters counters;
+};
+
+static std::vector<BatchResult> s_batch_results;
+static Common::Timer::Value s_benchmark_last_time = 0;
+static u64 s_benchmark_last_gs_time = 0;
+static u64 s_benchmark_last_sw_time = 0;
 
 bool GSRunner::InitializeConfig()
 {
@@ -173,6 +240,10 @@ void Host::ReportErrorAsync(const std::string_view title, const std::string_view
 		ERROR_LOG("ReportErrorAsync: {}: {}", title, message);
 	else if (!message.empty())
 		ERROR_LOG("ReportErrorAsync: {}", message);
+
+	// Batch mode records the reason a dump failed in the manifest.
+	std::unique_lock lock(s_last_error_lock);
+	s_last_error = message;
 }
 
 void Host::OpenURL(const std::string_view url)
@@ -227,7 +298,15 @@ void Host::ReleaseRenderWindow()
 
 void Host::BeginPresentFrame()
 {
-	if (s_loop_number == 0 && !s_output_prefix.empty())
+	if (s_trim_start.has_value() && !s_trim_queued && s_dump_frame_number >= s_trim_start.value())
+	{
+		// The renderer writes the state at this point, then records the following frames.
+		// Only the dump is wanted, not a screenshot next to it.
+		GSQueueSnapshot(s_trim_output + ".png", (s_trim_end >= s_dump_frame_number) ? (s_trim_end - s_dump_frame_number + 1) : 1,
+			false);
+		s_trim_queued = true;
+	}
+	else if (s_loop_number == 0 && !s_output_prefix.empty())
 	{
 		// when we wrap around, don't race other files
 		GSJoinSnapshotThreads();
@@ -237,35 +316,33 @@ void Host::BeginPresentFrame()
 		GSQueueSnapshot(dump_path);
 	}
 
-	if (GSIsHardwareRenderer())
-	{
-		const u32 last_draws = s_total_internal_draws;
-		const u32 last_uploads = s_total_uploads;
+	// Software renderers only have the draw counter, but benchmarks still want it.
+	const u32 last_draws = s_total_internal_draws;
+	const u32 last_uploads = s_total_uploads;
 
-		static constexpr auto update_stat = [](GSPerfMon::counter_t counter, u64& dst, double& last) {
-			// perfmon resets every 30 frames to zero
-			const double val = g_perfmon.GetCounter(counter);
-			dst += static_cast<u64>((val < last) ? val : (val - last));
-			last = val;
-		};
+	static constexpr auto update_stat = [](GSPerfMon::counter_t counter, u64& dst, double& last) {
+		// perfmon resets every 30 frames to zero
+		const double val = g_perfmon.GetCounter(counter);
+		dst += static_cast<u64>((val < last) ? val : (val - last));
+		last = val;
+	};
 
-		update_stat(GSPerfMon::Draw, s_total_internal_draws, s_last_internal_draws);
-		update_stat(GSPerfMon::DrawCalls, s_total_draws, s_last_draws);
-		update_stat(GSPerfMon::RenderPasses, s_total_render_passes, s_last_render_passes);
-		update_stat(GSPerfMon::Barriers, s_total_barriers, s_last_barriers);
-		update_stat(GSPerfMon::TextureCopies, s_total_copies, s_last_copies);
-		update_stat(GSPerfMon::TextureUploads, s_total_uploads, s_last_uploads);
-		update_stat(GSPerfMon::Readbacks, s_total_readbacks, s_last_readbacks);
+	update_stat(GSPerfMon::Draw, s_total_internal_draws, s_last_internal_draws);
+	update_stat(GSPerfMon::DrawCalls, s_total_draws, s_last_draws);
+	update_stat(GSPerfMon::RenderPasses, s_total_render_passes, s_last_render_passes);
+	update_stat(GSPerfMon::Barriers, s_total_barriers, s_last_barriers);
+	update_stat(GSPerfMon::TextureCopies, s_total_copies, s_last_copies);
+	update_stat(GSPerfMon::TextureUploads, s_total_uploads, s_last_uploads);
+	update_stat(GSPerfMon::Readbacks, s_total_readbacks, s_last_readbacks);
 
-		const bool idle_frame = s_total_frames && (last_draws == s_total_internal_draws && last_uploads == s_total_uploads);
+	const bool idle_frame = s_total_frames && (last_draws == s_total_internal_draws && last_uploads == s_total_uploads);
 
-		if (!idle_frame)
-			s_total_drawn_frames++;
+	if (!idle_frame)
+		s_total_drawn_frames++;
 
-		s_total_frames++;
+	s_total_frames++;
 
-		std::atomic_thread_fence(std::memory_order_release);
-	}
+	std::atomic_thread_fence(std::memory_order_release);
 }
 
 void Host::RequestResizeHostDisplay(s32 width, s32 height)
@@ -353,7 +430,8 @@ void Host::RequestExitBigPicture()
 
 void Host::RequestVMShutdown(bool allow_confirm, bool allow_save_state, bool default_save_state)
 {
-	VMManager::SetState(VMState::Stopping);
+	// In batch mode, the VM is kept alive for the next dump.
+	VMManager::SetState(s_batch_dumps.empty() ? VMState::Stopping : VMState::Paused);
 }
 
 void Host::OnAchievementsLoginSuccess(const char* username, u32 points, u32 sc_points, u32 unread_messages)
@@ -448,9 +526,32 @@ static void PrintCommandLineHelp(const char* progname)
 	std::fprintf(stderr, "  -dumprangef NF[,LF,BF]: Start dumping from frame NF (base 0), stops after LF frames, "
 		"and only those frames that are multiples of BF (intersection of -dumprange and -dumprangef used).\n"
 		"Defaults to 0,-1,1 (all frames). Only used if -dump is used.\n");
+	std::fprintf(stderr, "    Both ranges start playback at the nearest keyframe before them, if the dump has keyframes.\n");
 	std::fprintf(stderr, "  -loop <count>: Loops dump playback N times. Defaults to 1. 0 will loop infinitely.\n");
+	std::fprintf(stderr, "  -stream: Streams packets from disk instead of loading the whole dump into memory.\n");
+	std::fprintf(stderr, "  -benchmark <runs>: Replays the dump for the given number of timed runs, overrides -loop.\n");
+	std::fprintf(stderr, "  -warmup <runs>: Untimed runs before benchmarking. Defaults to 1.\n");
+	std::fprintf(stderr, "  -benchmarkout <file>: Writes benchmark results to the file, as CSV if it ends in .csv,\n"
+		"    otherwise JSON. Defaults to JSON on stdout.\n");
+	std::fprintf(stderr, "  -batch <dir|file>: Replays every dump in the directory, or listed one per line in the file,\n"
+		"    in a single process. Frames are dumped to dumpdir/name/name_frameN.png.\n");
+	std::fprintf(stderr, "  -manifest <file>: Writes per-dump batch results to the file as JSON. Defaults to stdout.\n");
+	std::fprintf(stderr, "  -trim <start>[,<end>]: Writes frames start to end (defaults to start) to a new dump, then exits.\n");
+	std::fprintf(stderr, "  -trimout <filename>: Filename for the trimmed dump, without extension.\n"
+		"    Defaults to the dump name with _trimN-M appended.\n");
+	std::fprintf(stderr, "  -compression <none|xz|zstd>: Compression for trimmed dumps. Defaults to zstd.\n");
+	std::fprintf(stderr, "  -compressionlevel <level>: Compression level for trimmed dumps, 1-9 for xz and 1-22 for zstd.\n"
+		"    Defaults to the compressor's default.\n");
+	std::fprintf(stderr, "  -keyframes: Writes seek keyframes to trimmed dumps. Older builds can't replay these dumps.\n");
 	std::fprintf(stderr, "  -renderer <renderer>: Sets the graphics renderer. Defaults to Auto.\n");
+	std::fprintf(stderr, "    nullhw runs the hardware renderer on a headless device which draws nothing.\n");
 	std::fprintf(stderr, "  -swthreads <threads>: Sets the number of threads for the software renderer.\n");
+	std::fprintf(stderr, "  -swtiled: Distributes software renderer work by screen tiles instead of scanlines.\n");
+	std::fprintf(stderr, "  -swprofile: Logs software renderer time per scanline selector on shutdown.\n");
+	std::fprintf(stderr, "  -swparalleltex: Converts large software renderer texture updates on worker threads.\n");
+	std::fprintf(stderr, "  -swcoalesce: Merges small consecutive software renderer draws into batches.\n");
+	std::fprintf(stderr, "  -swhiz: Skips occluded spans in the software renderer using per-block min depth.\n");
+	std::fprintf(stderr, "  -swwait <sleep|spin|adaptive>: Sets how software renderer threads wait for work. Defaults to spin.\n");
 	std::fprintf(stderr, "  -window: Forces a window to be displayed.\n");
 	std::fprintf(stderr, "  -surfaceless: Disables showing a window.\n");
 	std::fprintf(stderr, "  -logfile <filename>: Writes emu log to filename.\n");
@@ -461,6 +562,16 @@ static void PrintCommandLineHelp(const char* progname)
 	std::fprintf(stderr, "\n");
 }
 
+static std::string_view GetDumpTitle(std::string_view filename)
+{
+	// strip off all extensions
+	std::string_view title(Path::GetFileTitle(filename));
+	if (StringUtil::EndsWithNoCase(title, ".gs"))
+		title = Path::GetFileTitle(title);
+
+	return StringUtil::StripWhitespace(title);
+}
+
 void GSRunner::InitializeConsole()
 {
 	const char* var = std::getenv("PCSX2_NOCONSOLE");
@@ -556,6 +667,7 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 					by = std::max(1, StringUtil::FromChars<int>(split[2]).value_or(1));
 				}
 				s_settings_interface.SetIntValue("EmuCore/GS", "SaveDrawStart", start);
+				s_dump_start_draw = static_cast<u64>(std::max(start, 0));
 				s_settings_interface.SetIntValue("EmuCore/GS", "SaveDrawCount", num);
 				s_settings_interface.SetIntValue("EmuCore/GS", "SaveDrawBy", by);
 				continue;
@@ -581,6 +693,7 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 					by = std::max(1, StringUtil::FromChars<int>(split[2]).value_or(1));
 				}
 				s_settings_interface.SetIntValue("EmuCore/GS", "SaveFrameStart", start);
+				s_dump_start_frame = static_cast<u32>(std::max(start, 0));
 				s_settings_interface.SetIntValue("EmuCore/GS", "SaveFrameCount", num);
 				s_settings_interface.SetIntValue("EmuCore/GS", "SaveFrameBy", by);
 				continue;
@@ -601,6 +714,96 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 				Console.WriteLn("Looping dump playback %d times.", s_loop_count);
 				continue;
 			}
+			else if (CHECK_ARG_PARAM("-benchmark"))
+			{
+				s_benchmark_runs = std::max(StringUtil::FromChars<u32>(argv[++i]).value_or(1), 1u);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-warmup"))
+			{
+				s_benchmark_warmup = StringUtil::FromChars<u32>(argv[++i]).value_or(1);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-benchmarkout"))
+			{
+				s_benchmark_output = argv[++i];
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-batch"))
+			{
+				if (!CollectBatchDumps(std::string(StringUtil::StripWhitespace(argv[++i]))))
+					return false;
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-manifest"))
+			{
+				s_batch_manifest = argv[++i];
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-trim"))
+			{
+				const std::vector<std::string_view> split = StringUtil::SplitString(argv[++i], ',');
+				const std::optional<u32> start = split.empty() ? std::nullopt : StringUtil::FromChars<u32>(split[0]);
+				const std::optional<u32> end = (split.size() > 1) ? StringUtil::FromChars<u32>(split[1]) : start;
+				if (!start.has_value() || !end.has_value() || end.value() < start.value())
+				{
+					Console.Error("Invalid trim range specified.");
+					return false;
+				}
+
+				s_trim_start = start;
+				s_trim_end = end.value();
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-trimout"))
+			{
+				s_trim_output = StringUtil::StripWhitespace(argv[++i]);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-compression"))
+			{
+				const char* cname = argv[++i];
+
+				GSDumpCompressionMethod method;
+				if (StringUtil::Strcasecmp(cname, "none") == 0)
+					method = GSDumpCompressionMethod::Uncompressed;
+				else if (StringUtil::Strcasecmp(cname, "xz") == 0)
+					method = GSDumpCompressionMethod::LZMA;
+				else if (StringUtil::Strcasecmp(cname, "zstd") == 0)
+					method = GSDumpCompressionMethod::Zstandard;
+				else
+				{
+					Console.Error("Unknown compression method '%s'", cname);
+					return false;
+				}
+
+				s_settings_interface.SetIntValue("EmuCore/GS", "GSDumpCompression", static_cast<int>(method));
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-compressionlevel"))
+			{
+				const int level = StringUtil::FromChars<int>(argv[++i]).value_or(0);
+				if (level < 1 || level > 22)
+				{
+					Console.Error("Invalid compression level");
+					return false;
+				}
+
+				s_settings_interface.SetIntValue("EmuCore/GS", "GSDumpCompressionLevel", level);
+				continue;
+			}
+			else if (CHECK_ARG("-keyframes"))
+			{
+				Console.WriteLn("Writing keyframes to trimmed dumps.");
+				s_settings_interface.SetBoolValue("EmuCore/GS", "GSDumpKeyframes", true);
+				continue;
+			}
+			else if (CHECK_ARG("-stream"))
+			{
+				Console.WriteLn("Streaming dump packets from disk.");
+				GSDumpReplayer::SetStreaming(true);
+				continue;
+			}
 			else if (CHECK_ARG_PARAM("-renderer"))
 			{
 				const char* rname = argv[++i];
@@ -628,6 +831,8 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 #endif
 				else if (StringUtil::Strcasecmp(rname, "sw") == 0)
 					type = GSRendererType::SW;
+				else if (StringUtil::Strcasecmp(rname, "nullhw") == 0)
+					type = GSRendererType::NullHW;
 				else
 				{
 					Console.Error("Unknown renderer '%s'", rname);
@@ -651,6 +856,57 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 				s_settings_interface.SetIntValue("EmuCore/GS", "SWExtraThreads", swthreads);
 				continue;
 			}
+			else if (CHECK_ARG("-swtiled"))
+			{
+				Console.WriteLn("Using tile-binned software rendering threads");
+				s_settings_interface.SetBoolValue("EmuCore/GS", "extrathreads_tiled", true);
+				continue;
+			}
+			else if (CHECK_ARG("-swprofile"))
+			{
+				Console.WriteLn("Profiling software renderer selectors");
+				s_settings_interface.SetBoolValue("EmuCore/GS", "SWSelectorProfiling", true);
+				continue;
+			}
+			else if (CHECK_ARG("-swparalleltex"))
+			{
+				Console.WriteLn("Converting software renderer textures on worker threads");
+				s_settings_interface.SetBoolValue("EmuCore/GS", "SWParallelTextureUpdate", true);
+				continue;
+			}
+			else if (CHECK_ARG("-swcoalesce"))
+			{
+				Console.WriteLn("Enabling software renderer draw coalescing");
+				s_settings_interface.SetBoolValue("EmuCore/GS", "SWDrawCoalescing", true);
+				continue;
+			}
+			else if (CHECK_ARG("-swhiz"))
+			{
+				Console.WriteLn("Enabling software renderer hierarchical Z");
+				s_settings_interface.SetBoolValue("EmuCore/GS", "SWHierarchicalZ", true);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-swwait"))
+			{
+				const char* wname = argv[++i];
+
+				GSSWWorkerWait wait;
+				if (StringUtil::Strcasecmp(wname, "sleep") == 0)
+					wait = GSSWWorkerWait::Sleep;
+				else if (StringUtil::Strcasecmp(wname, "spin") == 0)
+					wait = GSSWWorkerWait::Spin;
+				else if (StringUtil::Strcasecmp(wname, "adaptive") == 0)
+					wait = GSSWWorkerWait::Adaptive;
+				else
+				{
+					Console.Error("Unknown software thread wait mode '%s'", wname);
+					return false;
+				}
+
+				Console.WriteLn("Using '%s' software thread wait mode", wname);
+				s_settings_interface.SetIntValue("EmuCore/GS", "SWWorkerWait", static_cast<int>(wait));
+				continue;
+			}
 			else if (CHECK_ARG_PARAM("-renderhacks"))
 			{
 				std::string str(argv[++i]);
@@ -761,18 +1017,81 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 		params.filename += argv[i];
 	}
 
-	if (params.filename.empty())
+	if (!s_batch_dumps.empty())
+	{
+		if (!params.filename.empty())
+		{
+			Console.Error("A dump filename can't be combined with -batch.");
+			return false;
+		}
+
+		if (s_benchmark_runs > 0)
+		{
+			Console.Error("-benchmark can't be combined with -batch.");
+			return false;
+		}
+	}
+	else if (params.filename.empty())
 	{
 		Console.Error("No dump filename provided.");
 		return false;
 	}
-
-	if (!VMManager::IsGSDumpFileName(params.filename))
+	else if (!VMManager::IsGSDumpFileName(params.filename))
 	{
 		Console.Error("Provided filename is not a GS dump.");
 		return false;
 	}
 
+	if (s_trim_start.has_value())
+	{
+		if (!s_batch_dumps.empty() || s_benchmark_runs > 0)
+		{
+			Console.Error("-trim can't be combined with -batch or -benchmark.");
+			return false;
+		}
+
+		if (s_trim_output.empty())
+		{
+			s_trim_output = Path::Combine(Path::GetDirectory(params.filename),
+				fmt::format("{}_trim{}-{}", GetDumpTitle(params.filename), s_trim_start.value(), s_trim_end));
+		}
+		else if (VMManager::IsGSDumpFileName(s_trim_output))
+		{
+			// The writer adds the extension for the compression method.
+			s_trim_output = Path::Combine(Path::GetDirectory(s_trim_output), GetDumpTitle(s_trim_output));
+		}
+
+		// Start from the nearest keyframe, and stop once the range has been written.
+		if (!s_dump_start_frame.has_value() && !s_dump_start_draw.has_value())
+			s_dump_start_frame = s_trim_start;
+		s_loop_count = 1;
+
+		// -compression can come after -compressionlevel, so the range is checked once both are known.
+		const int level = s_settings_interface.GetIntValue("EmuCore/GS", "GSDumpCompressionLevel", 0);
+		if (level > 0)
+		{
+			const GSDumpCompressionMethod method = static_cast<GSDumpCompressionMethod>(s_settings_interface.GetIntValue(
+				"EmuCore/GS", "GSDumpCompression", static_cast<int>(GSDumpCompressionMethod::Zstandard)));
+			if (method == GSDumpCompressionMethod::LZMA && level > 9)
+			{
+				Console.Error("Invalid compression level for xz, must be 1-9");
+				return false;
+			}
+			else if (method == GSDumpCompressionMethod::Uncompressed)
+			{
+				Console.Warning("Ignoring compression level for uncompressed dump");
+			}
+		}
+
+		Console.WriteLn(fmt::format("Trimming frames {} to {} into {}", s_trim_start.value(), s_trim_end, s_trim_output));
+	}
+
+	if (s_benchmark_runs > 0)
+	{
+		s_loop_count = static_cast<s32>(s_benchmark_warmup + s_benchmark_runs);
+		Console.WriteLn("Benchmarking %u runs after %u warmup runs.", s_benchmark_runs, s_benchmark_warmup);
+	}
+
 	if (s_settings_interface.GetBoolValue("EmuCore/GS", "DumpGSData") && !dumpdir.empty())
 	{
 		if (s_settings_interface.GetStringValue("EmuCore/GS", "HWDumpDirectory").empty())
@@ -785,15 +1104,11 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 		s_output_prefix = "";
 	}
 
-	// set up the frame dump directory
-	if (!s_output_prefix.empty())
+	// set up the frame dump directory, batches do it per dump
+	s_output_dir = std::exchange(s_output_prefix, {});
+	if (!s_output_dir.empty() && s_batch_dumps.empty())
 	{
-		// strip off all extensions
-		std::string_view title(Path::GetFileTitle(params.filename));
-		if (StringUtil::EndsWithNoCase(title, ".gs"))
-			title = Path::GetFileTitle(title);
-
-		s_output_prefix = Path::Combine(s_output_prefix, StringUtil::StripWhitespace(title));
+		s_output_prefix = Path::Combine(s_output_dir, GetDumpTitle(params.filename));
 		Console.WriteLn(fmt::format("Saving dumps as {}_frameN.png", s_output_prefix));
 	}
 
@@ -852,6 +1167,396 @@ void GSRunner::DumpStats()
 	Console.WriteLn("============================================");
 }
 
+void GSRunner::RecordBenchmarkFrame(s32 loop_number)
+{
+	const Common::Timer::Value now = Common::Timer::GetCurrentValue();
+	const u64 gs_time = MTGS::GetThreadHandle().GetCPUTime();
+	u64 sw_time = 0;
+	for (u32 i = 0; i < PerformanceMetrics::GetGSSWThreadCount(); i++)
+		sw_time += PerformanceMetrics::GetGSSWThreadCPUTime(i);
+
+	// Loop numbers count down to zero, the first runs are warmup.
+	const s32 run = static_cast<s32>(s_benchmark_runs) - 1 - loop_number;
+	if (s_benchmark_last_time != 0 && run >= 0 && static_cast<u32>(run) < s_benchmark_runs)
+	{
+		while (s_benchmark_results.size() <= static_cast<u32>(run))
+		{
+			s_benchmark_results.push_back({{}, {s_total_internal_draws, s_total_draws, s_total_render_passes,
+												   s_total_barriers, s_total_copies, s_total_uploads, s_total_readbacks}});
+		}
+
+		const double ticks_to_ms = 1000.0 / static_cast<double>(Threading::GetThreadTicksPerSecond());
+		s_benchmark_results[run].frames.push_back({Common::Timer::ConvertValueToMilliseconds(now - s_benchmark_last_time),
+			static_cast<double>(gs_time - s_benchmark_last_gs_time) * ticks_to_ms,
+			static_cast<double>(sw_time - s_benchmark_last_sw_time) * ticks_to_ms});
+	}
+
+	s_benchmark_last_time = now;
+	s_benchmark_last_gs_time = gs_time;
+	s_benchmark_last_sw_time = sw_time;
+}
+
+namespace
+{
+	struct BenchmarkStats
+	{
+		double total;
+		double mean;
+		double median;
+		double p95;
+		double p99;
+		double min;
+		double max;
+	};
+} // namespace
+
+static BenchmarkStats ComputeBenchmarkStats(const std::vector<BenchmarkFrame>& frames, double (*get)(const BenchmarkFrame&))
+{
+	BenchmarkStats ret = {};
+	if (frames.empty())
+		return ret;
+
+	std::vector<double> values;
+	values.reserve(frames.size());
+	for (const BenchmarkFrame& frame : frames)
+		values.push_back(get(frame));
+	std::sort(values.begin(), values.end());
+
+	// Nearest-rank percentiles.
+	const size_t count = values.size();
+	const auto percentile = [&values, count](double p) {
+		const size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(count)));
+		return values[std::clamp<size_t>(rank, 1, count) - 1];
+	};
+
+	for (const double value : values)
+		ret.total += value;
+	ret.mean = ret.total / static_cast<double>(count);
+	ret.median = (count & 1) ? values[count / 2] : ((values[count / 2 - 1] + values[count / 2]) * 0.5);
+	ret.p95 = percentile(0.95);
+	ret.p99 = percentile(0.99);
+	ret.min = values.front();
+	ret.max = values.back();
+	return ret;
+}
+
+static std::string EscapeJSONString(std::string_view str)
+{
+	std::string ret;
+	ret.reserve(str.size());
+	for (const char ch : str)
+	{
+		if (ch == '"' || ch == '\\')
+		{
+			ret.push_back('\\');
+			ret.push_back(ch);
+		}
+		else if (static_cast<unsigned char>(ch) < 0x20)
+		{
+			fmt::format_to(std::back_inserter(ret), "\\u{:04x}", static_cast<unsigned>(ch));
+		}
+		else
+		{
+			ret.push_back(ch);
+		}
+	}
+
+	return ret;
+}
+
+bool GSRunner::WriteBenchmarkResults(const std::string& dump_filename)
+{
+	std::atomic_thread_fence(std::memory_order_acquire);
+
+	static constexpr std::pair<const char*, double (*)(const BenchmarkFrame&)> timings[] = {
+		{"wall_ms", [](const BenchmarkFrame& f) { return f.wall_ms; }},
+		{"cpu_ms", [](const BenchmarkFrame& f) { return f.gs_cpu_ms + f.sw_cpu_ms; }},
+		{"gs_cpu_ms", [](const BenchmarkFrame& f) { return f.gs_cpu_ms; }},
+		{"sw_cpu_ms", [](const BenchmarkFrame& f) { return f.sw_cpu_ms; }},
+	};
+	static constexpr const char* counter_names[] = {
+		"draws", "draw_calls", "render_passes", "barriers", "copies", "uploads", "readbacks"};
+
+	const bool csv = StringUtil::EndsWithNoCase(s_benchmark_output, ".csv");
+	const BenchmarkCounters end_counters = {s_total_internal_draws, s_total_draws, s_total_render_passes,
+		s_total_barriers, s_total_copies, s_total_uploads, s_total_readbacks};
+
+	std::string out;
+	if (csv)
+	{
+		out += "run,frames";
+		for (const auto& [name, get] : timings)
+		{
+			for (const char* stat : {"mean", "median", "p95", "p99"})
+				fmt::format_to(std::back_inserter(out), ",{}_{}", name, stat);
+		}
+		for (const char* name : counter_names)
+			fmt::format_to(std::back_inserter(out), ",{}", name);
+		out += '\n';
+	}
+	else
+	{
+		fmt::format_to(std::back_inserter(out), "{{\n  \"dump\": \"{}\",\n  \"renderer\": \"{}\",\n  \"warmup_runs\": {},\n  \"runs\": [",
+			EscapeJSONString(dump_filename), Pcsx2Config::GSOptions::GetRendererName(EmuConfig.GS.Renderer),
+			s_benchmark_warmup);
+	}
+
+	for (size_t i = 0; i < s_benchmark_results.size(); i++)
+	{
+		const BenchmarkRun& run = s_benchmark_results[i];
+		const BenchmarkCounters& start = run.start_counters;
+		const BenchmarkCounters& end = (i + 1 < s_benchmark_results.size()) ? s_benchmark_results[i + 1].start_counters : end_counters;
+		const u64 counters[] = {end.draws - start.draws, end.draw_calls - start.draw_calls,
+			end.render_passes - start.render_passes, end.barriers - start.barriers, end.copies - start.copies,
+			end.uploads - start.uploads, end.readbacks - start.readbacks};
+
+		if (csv)
+		{
+			fmt::format_to(std::back_inserter(out), "{},{}", i, run.frames.size());
+			for (const auto& [name, get] : timings)
+			{
+				const BenchmarkStats stats = ComputeBenchmarkStats(run.frames, get);
+				fmt::format_to(std::back_inserter(out), ",{:.4f},{:.4f},{:.4f},{:.4f}", stats.mean, stats.median, stats.p95, stats.p99);
+			}
+			for (const u64 value : counters)
+				fmt::format_to(std::back_inserter(out), ",{}", value);
+			out += '\n';
+			continue;
+		}
+
+		fmt::format_to(std::back_inserter(out), "{}\n    {{\n      \"run\": {},\n      \"frames\": {},", (i > 0) ? "," : "", i,
+			run.frames.size());
+		for (const auto& [name, get] : timings)
+		{
+			const BenchmarkStats stats = ComputeBenchmarkStats(run.frames, get);
+			fmt::format_to(std::back_inserter(out),
+				"\n      \"{}\": {{\"total\": {:.4f}, \"mean\": {:.4f}, \"median\": {:.4f}, \"p95\": {:.4f}, \"p99\": {:.4f}, "
+				"\"min\": {:.4f}, \"max\": {:.4f}}},",
+				name, stats.total, stats.mean, stats.median, stats.p95, stats.p99, stats.min, stats.max);
+		}
+		out += "\n      \"counters\": {";
+		for (size_t j = 0; j < std::size(counters); j++)
+			fmt::format_to(std::back_inserter(out), "{}\"{}\": {}", (j > 0) ? ", " : "", counter_names[j], counters[j]);
+		out += "},\n      \"frame_cpu_ms\": [";
+		for (size_t j = 0; j < run.frames.size(); j++)
+			fmt::format_to(std::back_inserter(out), "{}{:.4f}", (j > 0) ? ", " : "", run.frames[j].gs_cpu_ms + run.frames[j].sw_cpu_ms);
+		out += "]\n    }";
+	}
+
+	if (!csv)
+		out += "\n  ]\n}\n";
+
+	if (s_benchmark_output.empty())
+	{
+		std::fputs(out.c_str(), stdout);
+		std::fflush(stdout);
+		return true;
+	}
+
+	if (!FileSystem::WriteStringToFile(s_benchmark_output.c_str(), out))
+	{
+		Console.ErrorFmt("Failed to write benchmark results to {}", s_benchmark_output);
+		return false;
+	}
+
+	Console.WriteLnFmt("Wrote benchmark results to {}", s_benchmark_output);
+	return true;
+}
+
+bool GSRunner::CollectBatchDumps(const std::string& path)
+{
+	if (FileSystem::DirectoryExists(path.c_str()))
+	{
+		FileSystem::FindResultsArray files;
+		FileSystem::FindFiles(path.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_SORT_BY_NAME, &files);
+		for (const FILESYSTEM_FIND_DATA& fd : files)
+		{
+			if (VMManager::IsGSDumpFileName(fd.FileName))
+				s_batch_dumps.push_back(fd.FileName);
+		}
+	}
+	else
+	{
+		std::optional<std::string> list = FileSystem::ReadFileToString(path.c_str());
+		if (!list.has_value())
+		{
+			Console.ErrorFmt("Failed to read batch list {}", path);
+			return false;
+		}
+
+		// One dump per line, blank lines and lines starting with # are ignored.
+		for (const std::string_view line : StringUtil::SplitString(list.value(), '\n'))
+		{
+			const std::string_view filename = StringUtil::StripWhitespace(line);
+			if (!filename.empty() && filename.front() != '#')
+				s_batch_dumps.emplace_back(filename);
+		}
+	}
+
+	if (s_batch_dumps.empty())
+	{
+		Console.ErrorFmt("No GS dumps found in {}", path);
+		return false;
+	}
+
+	Console.WriteLnFmt("Replaying {} dumps in batch mode.", s_batch_dumps.size());
+	return true;
+}
+
+bool GSRunner::RunBatch(VMBootParameters& params)
+{
+	bool vm_started = false;
+	for (const std::string& path : s_batch_dumps)
+	{
+		BatchResult& result = s_batch_results.emplace_back();
+		result.path = path;
+
+		{
+			std::unique_lock lock(s_last_error_lock);
+			s_last_error.clear();
+		}
+
+		// The first dump which opens boots the VM, the rest reuse it, along with the GS device.
+		bool opened;
+		if (!vm_started)
+		{
+			Error error;
+			params.filename = path;
+			opened = vm_started = (VMManager::Initialize(params, &error) == VMBootResult::StartupSuccess);
+			if (!opened)
+				result.error = error.GetDescription();
+		}
+		else
+		{
+			opened = VMManager::ChangeGSDump(path);
+		}
+
+		if (!opened)
+		{
+			if (result.error.empty())
+			{
+				std::unique_lock lock(s_last_error_lock);
+				result.error = s_last_error.empty() ? std::string("Failed to open dump.") : s_last_error;
+			}
+
+			Console.ErrorFmt("Skipping {}: {}", path, result.error);
+			continue;
+		}
+
+		Console.WriteLnFmt("Replaying {}", path);
+
+		std::string output_prefix;
+		if (!s_output_dir.empty())
+		{
+			// Same layout as test_run_dumps.py, one directory per dump.
+			const std::string_view title = GetDumpTitle(path);
+			const std::string dir = Path::Combine(s_output_dir, title);
+			if (FileSystem::DirectoryExists(dir.c_str()) || FileSystem::CreateDirectoryPath(dir.c_str(), false))
+				output_prefix = Path::Combine(dir, title);
+			else
+				Console.ErrorFmt("Failed to create output directory {}", dir);
+		}
+
+		MTGS::RunOnGSThread([output_prefix = std::move(output_prefix)]() mutable {
+			s_output_prefix = std::move(output_prefix);
+			s_dump_frame_number = 0;
+			s_loop_number = s_loop_count;
+			s_total_internal_draws = 0;
+			s_total_draws = 0;
+			s_total_render_passes = 0;
+			s_total_barriers = 0;
+			s_total_copies = 0;
+			s_total_uploads = 0;
+			s_total_readbacks = 0;
+			s_total_frames = 0;
+			s_total_drawn_frames = 0;
+		});
+
+		const Common::Timer timer;
+		GSDumpReplayer::SetLoopCount(s_loop_count);
+		VMManager::SetState(VMState::Running);
+		while (VMManager::GetState() == VMState::Running)
+			VMManager::Execute();
+
+		// Pausing waits for the GS thread, so the counters are final.
+		std::atomic_thread_fence(std::memory_order_acquire);
+		result.seconds = timer.GetTimeSeconds();
+		result.frames = s_total_frames;
+		result.drawn_frames = s_total_drawn_frames;
+		result.counters = {s_total_internal_draws, s_total_draws, s_total_render_passes, s_total_barriers,
+			s_total_copies, s_total_uploads, s_total_readbacks};
+		DumpStats();
+
+		if (VMManager::GetState() != VMState::Paused)
+		{
+			Console.Error("VM stopped, abandoning the rest of the batch.");
+			break;
+		}
+	}
+
+	if (vm_started)
+		VMManager::Shutdown(false);
+
+	return WriteBatchManifest();
+}
+
+bool GSRunner::WriteBatchManifest()
+{
+	static constexpr const char* counter_names[] = {
+		"draws", "draw_calls", "render_passes", "barriers", "copies", "uploads", "readbacks"};
+
+	u32 failed = 0;
+	std::string out = "{\n  \"dumps\": [";
+	for (size_t i = 0; i < s_batch_results.size(); i++)
+	{
+		const BatchResult& result = s_batch_results[i];
+		fmt::format_to(std::back_inserter(out), "{}\n    {{\n      \"dump\": \"{}\",", (i > 0) ? "," : "",
+			EscapeJSONString(result.path));
+		if (!result.error.empty())
+		{
+			fmt::format_to(std::back_inserter(out), "\n      \"status\": \"failed\",\n      \"error\": \"{}\"\n    }}",
+				EscapeJSONString(result.error));
+			failed++;
+			continue;
+		}
+
+		const u64 counters[] = {result.counters.draws, result.counters.draw_calls, result.counters.render_passes,
+			result.counters.barriers, result.counters.copies, result.counters.uploads, result.counters.readbacks};
+		fmt::format_to(std::back_inserter(out),
+			"\n      \"status\": \"ok\",\n      \"seconds\": {:.4f},\n      \"frames\": {},\n      \"drawn_frames\": {},"
+			"\n      \"counters\": {{",
+			result.seconds, result.frames, result.drawn_frames);
+		for (size_t j = 0; j < std::size(counters); j++)
+			fmt::format_to(std::back_inserter(out), "{}\"{}\": {}", (j > 0) ? ", " : "", counter_names[j], counters[j]);
+		out += "}\n    }";
+	}
+
+	// Dumps after an abandoned batch never ran.
+	for (size_t i = s_batch_results.size(); i < s_batch_dumps.size(); i++)
+	{
+		fmt::format_to(std::back_inserter(out), "{}\n    {{\n      \"dump\": \"{}\",\n      \"status\": \"skipped\"\n    }}",
+			(i > 0) ? "," : "", EscapeJSONString(s_batch_dumps[i]));
+		failed++;
+	}
+
+	out += "\n  ]\n}\n";
+
+	Console.WriteLnFmt("Batch finished, {} of {} dumps replayed.", s_batch_dumps.size() - failed, s_batch_dumps.size());
+
+	if (s_batch_manifest.empty())
+	{
+		std::fputs(out.c_str(), stdout);
+		std::fflush(stdout);
+	}
+	else if (!FileSystem::WriteStringToFile(s_batch_manifest.c_str(), out))
+	{
+		Console.ErrorFmt("Failed to write batch manifest to {}", s_batch_manifest);
+		return false;
+	}
+
+	return (failed == 0);
+}
+
 #ifdef _WIN32
 // We can't handle unicode in filenames if we don't use wmain on Win32.
 #define main real_main
@@ -867,7 +1572,19 @@ static void CPUThreadMain(VMBootParameters* params, std::atomic<int>* ret)
 		VMManager::ApplySettings();
 		GSDumpReplayer::SetIsDumpRunner(true);
 
-		if (VMManager::Initialize(*params) == VMBootResult::StartupSuccess)
+		// Skip straight to the dump range, when the dump has keyframes.
+		if (s_dump_start_frame.has_value() || s_dump_start_draw.has_value())
+		{
+			GSDumpReplayer::SetSeekTarget(s_dump_start_frame.value_or(std::numeric_limits<u32>::max()),
+				s_dump_start_draw.value_or(std::numeric_limits<u64>::max()));
+		}
+
+		if (!s_batch_dumps.empty())
+		{
+			if (GSRunner::RunBatch(*params))
+				ret->store(EXIT_SUCCESS);
+		}
+		else if (VMManager::Initialize(*params) == VMBootResult::StartupSuccess)
 		{
 			// run until end
 			GSDumpReplayer::SetLoopCount(s_loop_count);
@@ -876,7 +1593,10 @@ static void CPUThreadMain(VMBootParameters* params, std::atomic<int>* ret)
 				VMManager::Execute();
 			VMManager::Shutdown(false);
 			GSRunner::DumpStats();
-			ret->store(EXIT_SUCCESS);
+			if (s_trim_start.has_value() && !s_trim_reached)
+				Console.Error("The dump ended before the trim range started.");
+			else if (s_benchmark_runs == 0 || GSRunner::WriteBenchmarkResults(params->filename))
+				ret->store(EXIT_SUCCESS);
 		}
 	}
 
@@ -923,6 +1643,19 @@ void Host::PumpMessagesOnCPUThread()
 	// update GS thread copy of frame number
 	MTGS::RunOnGSThread([frame_number = GSDumpReplayer::GetFrameNumber()]() { s_dump_frame_number = frame_number; });
 	MTGS::RunOnGSThread([loop_number = GSDumpReplayer::GetLoopCount()]() { s_loop_number = loop_number; });
+
+	// This runs on the GS thread once the frame has been presented, so the time since the last call covers it fully.
+	if (s_benchmark_runs > 0)
+		MTGS::RunOnGSThread([loop_number = GSDumpReplayer::GetLoopCount()]() { GSRunner::RecordBenchmarkFrame(loop_number); });
+
+	// Shutting down flushes the GS thread, which closes the trimmed dump.
+	if (s_trim_start.has_value())
+	{
+		const u32 frame_number = GSDumpReplayer::GetFrameNumber();
+		s_trim_reached |= (frame_number >= s_trim_start.value());
+		if (frame_number > s_trim_end + TRIM_EXTRA_FRAMES)
+			Host::RequestVMShutdown(false, false, false);
+	}
 }
 
 s32 Host::Internal::GetTranslatedStringImpl(
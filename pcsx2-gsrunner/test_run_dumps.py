@@ -18,17 +18,8 @@ def get_gs_name(path):
     return None
 
 
-def run_regression_test(runner, dumpdir, renderer, upscale, renderhacks, parallel, gspath):
+def get_runner_args(runner, renderer, upscale, renderhacks, parallel):
     args = [runner]
-    gsname = get_gs_name(gspath)
-
-    real_dumpdir = os.path.join(dumpdir, gsname).strip()
-    # Safe creation and skip if folder exists
-    try:
-        os.makedirs(real_dumpdir)
-    except FileExistsError:
-        # Folder already exists → skip this game
-        return
 
     if renderer is not None:
         args.extend(["-renderer", renderer])
@@ -39,9 +30,6 @@ def run_regression_test(runner, dumpdir, renderer, upscale, renderhacks, paralle
     if renderhacks is not None:
         args.extend(["-renderhacks", renderhacks])
 
-    args.extend(["-dumpdir", real_dumpdir])
-    args.extend(["-logfile", os.path.join(real_dumpdir, "emulog.txt")])
-
     # loop a couple of times for those stubborn merge/interlace dumps that don't render anything
     # the first time around
     args.extend(["-loop", "2"])
@@ -52,7 +40,10 @@ def run_regression_test(runner, dumpdir, renderer, upscale, renderhacks, paralle
 
     # run surfaceless, we don't want tons of windows popping up
     args.append("-surfaceless");
+    return args
+
 
+def run_runner(args):
     # disable output console entirely
     environ = os.environ.copy()
     environ["PCSX2_NOCONSOLE"] = "1"
@@ -67,13 +58,45 @@ def run_regression_test(runner, dumpdir, renderer, upscale, renderhacks, paralle
         except OSError:
             pass
 
+    #print("Running '%s'" % (" ".join(args)))
+    subprocess.run(args, env=environ, stdin=subprocess.DEVNULL, stderr=subprocess.DEVNULL, stdout=subprocess.DEVNULL, creationflags=creationflags)
+
+
+def run_regression_test(runner, dumpdir, renderer, upscale, renderhacks, parallel, gspath):
+    gsname = get_gs_name(gspath)
+
+    real_dumpdir = os.path.join(dumpdir, gsname).strip()
+    # Safe creation and skip if folder exists
+    try:
+        os.makedirs(real_dumpdir)
+    except FileExistsError:
+        # Folder already exists → skip this game
+        return
+
+    args = get_runner_args(runner, renderer, upscale, renderhacks, parallel)
+    args.extend(["-dumpdir", real_dumpdir])
+    args.extend(["-logfile", os.path.join(real_dumpdir, "emulog.txt")])
     args.append("--")
     args.append(gspath)
+    run_runner(args)
+
+
+def run_regression_batch(runner, dumpdir, renderer, upscale, renderhacks, parallel, batch):
+    index, gamepaths = batch
+    listpath = os.path.join(dumpdir, "batch%u.txt" % index)
+    with open(listpath, "w") as f:
+        f.write("\n".join(gamepaths) + "\n")
+
+    # the runner creates the per-dump directories itself
+    args = get_runner_args(runner, renderer, upscale, renderhacks, parallel)
+    args.extend(["-dumpdir", dumpdir])
+    args.extend(["-logfile", os.path.join(dumpdir, "emulog%u.txt" % index)])
+    args.extend(["-manifest", os.path.join(dumpdir, "manifest%u.json" % index)])
+    args.extend(["-batch", listpath])
+    run_runner(args)
 
-    #print("Running '%s'" % (" ".join(args)))
-    subprocess.run(args, env=environ, stdin=subprocess.DEVNULL, stderr=subprocess.DEVNULL, stdout=subprocess.DEVNULL, creationflags=creationflags)
 
-def run_regression_tests(runner, gsdir, dumpdir, renderer, upscale, renderhacks, parallel=1):
+def run_regression_tests(runner, gsdir, dumpdir, renderer, upscale, renderhacks, parallel=1, batch=False):
     paths = glob.glob(gsdir + "/*.*", recursive=True)
     gamepaths = list(filter(lambda x: get_gs_name(x) is not None, paths))
 
@@ -84,7 +107,20 @@ def run_regression_tests(runner, gsdir, dumpdir, renderer, upscale, renderhacks,
 
     print("Found %u GS dumps" % len(gamepaths))
 
-    if parallel <= 1:
+    if batch:
+        # skip games which already have output, same as the per-process runs
+        gamepaths = list(filter(lambda x: not os.path.exists(os.path.join(dumpdir, get_gs_name(x)).strip()), gamepaths))
+        batches = [(i, gamepaths[i::parallel]) for i in range(max(parallel, 1)) if gamepaths[i::parallel]]
+        print("Processing %u games in %u batches" % (len(gamepaths), len(batches)))
+        func = partial(run_regression_batch, runner, dumpdir, renderer, upscale, renderhacks, parallel)
+        if len(batches) <= 1:
+            for b in batches:
+                func(b)
+        else:
+            pool = multiprocessing.Pool(len(batches))
+            pool.map(func, batches, chunksize=1)
+            pool.close()
+    elif parallel <= 1:
         for game in gamepaths:
             run_regression_test(runner, dumpdir, renderer, upscale, renderhacks, parallel, game)
     else:
@@ -110,10 +146,11 @@ if __name__ == "__main__":
     parser.add_argument("-upscale", action="store", type=float, default=1, help="Upscaling multiplier to use")
     parser.add_argument("-renderhacks", action="store", required=False, type=str.strip, help="Enable HW Rendering hacks")
     parser.add_argument("-parallel", action="store", type=int, default=1, help="Number of processes to run")
+    parser.add_argument("-batch", action="store_true", help="Replay dumps in batches, one runner process per parallel job")
 
     args = parser.parse_args()
 
-    if not run_regression_tests(args.runner, os.path.realpath(args.gsdir), os.path.realpath(args.dumpdir), args.renderer, args.upscale, args.renderhacks, args.parallel):
+    if not run_regression_tests(args.runner, os.path.realpath(args.gsdir), os.path.realpath(args.dumpdir), args.renderer, args.upscale, args.renderhacks, args.parallel, args.batch):
         sys.exit(1)
     else:
         sys.exit(0)
@@ -127,6 +127,7 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* settings_dialog,
 	SettingWidgetBinder::BindWidgetToIntSetting(sif, m_sw.extraSWThreads, "EmuCore/GS", "extrathreads", 2);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_sw.swAutoFlush, "EmuCore/GS", "autoflush_sw", true);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_sw.swMipmap, "EmuCore/GS", "mipmap", true);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_sw.swTileBinning, "EmuCore/GS", "extrathreads_tiled", false);
 
 	//////////////////////////////////////////////////////////////////////////
 	// HW Renderer Fixes
@@ -576,6 +577,10 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* settings_dialog,
 
 		dialog()->registerWidgetHelp(
 			m_sw.swMipmap, tr("Mipmapping"), tr("Checked"), tr("Enables mipmapping, which some games require to render correctly."));
+
+		dialog()->registerWidgetHelp(m_sw.swTileBinning, tr("Tile-Binned Threading"), tr("Unchecked"),
+			tr("Splits the screen into tiles which any rendering thread can pick up, instead of giving each thread fixed rows. "
+			   "Scales better with a high number of software rendering threads."));
 	}
 
 	// Hardware Fixes tab
@@ -278,6 +278,7 @@ enum class GSRendererType : s8
 	VK = 14,
 	Metal = 17,
 	DX12 = 15,
+	NullHW = 18,
 };
 
 enum class GSVSyncMode : u8
@@ -373,6 +374,13 @@ enum class GSScreenshotFormat : u8
 	Count,
 };
 
+enum class GSSWWorkerWait : u8
+{
+	Sleep, // Sleep on the semaphore straight away.
+	Spin, // Spin for SPIN_TIME_NS, then sleep, like WorkSema's other waiters.
+	Adaptive, // Tune the spin length from the waits seen.
+};
+
 enum class GSDumpCompressionMethod : u8
 {
 	Uncompressed,
@@ -599,11 +607,11 @@ struct Pcsx2Config
 	{
 		BITFIELD32()
 		bool
-			Enabled : 1, // universal toggle for the profiler.
-			RecBlocks_EE : 1, // Enables per-block profiling for the EE recompiler [unimplemented]
-			RecBlocks_IOP : 1, // Enables per-block profiling for the IOP recompiler [unimplemented]
-			RecBlocks_VU0 : 1, // Enables per-block profiling for the VU0 recompiler [unimplemented]
-			RecBlocks_VU1 : 1; // Enables per-block profiling for the VU1 recompiler [unimplemented]
+			Enabled : 1, // universal toggle for the profiler, see DebugTools/JitProfiler.h.
+			RecBlocks_EE : 1, // Attributes samples to EE recompiler blocks
+			RecBlocks_IOP : 1, // Attributes samples to IOP recompiler blocks
+			RecBlocks_VU0 : 1, // Attributes samples to VU0 recompiler blocks
+			RecBlocks_VU1 : 1; // Attributes samples to VU1 recompiler blocks
 		BITFIELD_END
 
 		// Default is Disabled, with all recs enabled underneath.
@@ -647,6 +655,12 @@ struct Pcsx2Config
 			EnableFastmem : 1;
 		bool
 			PauseOnTLBMiss : 1;
+		bool
+			EnableEETranslationCache : 1; // Persist relocatable EE blocks to disk between sessions.
+		bool
+			EnableEESuperblocks : 1; // Recompile hot EE blocks along their dominant fall-through path.
+		bool
+			EnableEEDeferredCompilation : 1; // Interpret new EE blocks until they're warm, and spread compilation across frames.
 		BITFIELD_END
 
 		RecompilerOptions();
@@ -761,6 +775,11 @@ struct Pcsx2Config
 					HWSpinCPUForReadbacks : 1,
 					GPUPaletteConversion : 1,
 					AutoFlushSW : 1,
+					SWExtraThreadsTiled : 1,
+					SWSelectorProfiling : 1,
+					SWParallelTextureUpdate : 1,
+					SWDrawCoalescing : 1,
+					SWHierarchicalZ : 1,
 					PreloadFrameWithGSData : 1,
 					Mipmap : 1,
 					HWMipmap : 1,
@@ -779,6 +798,7 @@ struct Pcsx2Config
 					FXAA : 1,
 					ShadeBoost : 1,
 					DumpGSData : 1,
+					GSDumpKeyframes : 1,
 					SaveRT : 1,
 					SaveFrame : 1,
 					SaveTexture : 1,
@@ -830,6 +850,7 @@ struct Pcsx2Config
 		BiFiltering TextureFiltering = BiFiltering::PS2;
 		TexturePreloadingLevel TexturePreloading = TexturePreloadingLevel::Full;
 		GSDumpCompressionMethod GSDumpCompression = GSDumpCompressionMethod::Zstandard;
+		s8 GSDumpCompressionLevel = 0; // 0 uses the compressor's default
 		GSHardwareDownloadMode HWDownloadMode = GSHardwareDownloadMode::Enabled;
 		GSCASMode CASMode = GSCASMode::Disabled;
 		u8 Dithering = 2;
@@ -864,8 +885,10 @@ struct Pcsx2Config
 		u8 ShadeBoost_Gamma = DEFAULT_SHADEBOOST_GAMMA;
 		u8 PNGCompressionLevel = 1;
 
+		u16 TextureHashCacheBudget = 768; // MB, 0 = no limit beyond the entry count.
 		u16 SWExtraThreads = 2;
 		u16 SWExtraThreadsHeight = 4;
+		GSSWWorkerWait SWWorkerWait = GSSWWorkerWait::Spin;
 
 		int SaveDrawStart = 0;
 		int SaveDrawCount = 5000;
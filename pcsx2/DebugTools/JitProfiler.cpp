@@ -0,0 +1,560 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "DebugTools/JitProfiler.h"
+#include "DebugTools/SymbolGuardian.h"
+#include "VMManager.h"
+
+#include "common/Console.h"
+#include "common/Error.h"
+#include "common/FileSystem.h"
+#include "common/HostSys.h"
+#include "common/Path.h"
+#include "common/Threading.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#if defined(_WIN32)
+#include "common/RedtapeWindows.h"
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <pthread.h>
+#else
+#include <csignal>
+#include <pthread.h>
+#include <ucontext.h>
+#endif
+
+namespace JitProfiler
+{
+	namespace
+	{
+		struct BlockInfo
+		{
+			u32 size;
+			u32 pc;
+			Source source;
+		};
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+		// Each sampled thread answers SIGPROF through its own slot, so a signal which is
+		// delivered after the sampler gave up on it can't be taken as another thread's answer.
+		struct SignalSlot
+		{
+			std::atomic<u32> request{0};
+			std::atomic<u32> response{0};
+			std::atomic<uptr> pc{0};
+		};
+#endif
+
+		struct ThreadInfo
+		{
+			const char* name;
+#if defined(_WIN32)
+			DWORD id;
+			HANDLE handle;
+#elif defined(__APPLE__)
+			pthread_t thread;
+			mach_port_t port;
+#else
+			pthread_t thread;
+			SignalSlot* slot;
+#endif
+		};
+
+		struct SampleKey
+		{
+			const char* thread;
+			Source source; // Count for samples outside of recompiled blocks.
+			u32 pc;
+
+			bool operator<(const SampleKey& rhs) const
+			{
+				return std::tie(thread, source, pc) < std::tie(rhs.thread, rhs.source, rhs.pc);
+			}
+		};
+	} // namespace
+
+	static constexpr u32 SAMPLE_RATE = 1000;
+	static constexpr u32 HOT_LIST_SIZE = 100;
+
+	static const char* const s_source_names[] = {"EE", "IOP", "VU0", "VU1"};
+	static_assert(std::size(s_source_names) == static_cast<size_t>(Source::Count));
+
+	static bool IsSampling();
+	static void StartSampling(u32 sources);
+	static void SamplerThreadEntryPoint();
+	static bool SampleThread(const ThreadInfo& thread, uptr* pc);
+	static std::string FormatFunctionName(Source source, u32 pc);
+	static void WriteReport(double seconds);
+
+	// Bitmask of sources which blocks are registered for. Zero when the profiler is stopped.
+	static std::atomic<u32> s_tracked_sources{0};
+
+	// Host code ranges of registered blocks, keyed by start address.
+	static std::mutex s_block_mutex;
+	static std::map<uptr, BlockInfo> s_blocks;
+
+	static std::mutex s_thread_mutex;
+	static std::vector<ThreadInfo> s_threads;
+
+	static Threading::Thread s_sampler_thread;
+	static std::atomic_bool s_sampler_stop{false};
+	static u64 s_start_ticks = 0;
+
+	// Owned by the sampler thread while it is running.
+	static std::map<SampleKey, u32> s_samples;
+	static u32 s_missed_samples = 0;
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+	// The sampled thread answers a SIGPROF with its pc, through its own slot.
+	static thread_local SignalSlot s_signal_slot;
+	static bool s_signal_handler_installed = false;
+
+	static void SignalHandler(int sig, siginfo_t* info, void* ctx);
+#endif
+} // namespace JitProfiler
+
+bool JitProfiler::IsSampling()
+{
+	return s_sampler_thread.Joinable();
+}
+
+void JitProfiler::ApplyConfig(const Pcsx2Config::ProfilerOptions& options)
+{
+	u32 sources = 0;
+	if (options.Enabled)
+	{
+		sources |= options.RecBlocks_EE ? (1u << static_cast<u32>(Source::EE)) : 0;
+		sources |= options.RecBlocks_IOP ? (1u << static_cast<u32>(Source::IOP)) : 0;
+		sources |= options.RecBlocks_VU0 ? (1u << static_cast<u32>(Source::VU0)) : 0;
+		sources |= options.RecBlocks_VU1 ? (1u << static_cast<u32>(Source::VU1)) : 0;
+	}
+
+	if (!options.Enabled)
+		Stop();
+	else if (!IsSampling())
+		StartSampling(sources);
+	else
+		s_tracked_sources.store(sources, std::memory_order_release);
+}
+
+void JitProfiler::StartSampling(u32 sources)
+{
+#if !defined(_WIN32) && !defined(__APPLE__)
+	// Never uninstalled, since a late signal would otherwise terminate the process.
+	if (!s_signal_handler_installed)
+	{
+		struct sigaction sa = {};
+		sa.sa_flags = SA_SIGINFO | SA_RESTART;
+		sa.sa_sigaction = SignalHandler;
+		sigemptyset(&sa.sa_mask);
+		if (sigaction(SIGPROF, &sa, nullptr) != 0)
+		{
+			Console.Error("JitProfiler: Failed to install SIGPROF handler.");
+			return;
+		}
+
+		s_signal_handler_installed = true;
+	}
+#endif
+
+	{
+		std::unique_lock lock(s_block_mutex);
+		s_blocks.clear();
+	}
+	s_samples.clear();
+	s_missed_samples = 0;
+	s_start_ticks = GetCPUTicks();
+	s_tracked_sources.store(sources, std::memory_order_release);
+
+	s_sampler_stop.store(false, std::memory_order_release);
+	s_sampler_thread.Start(&SamplerThreadEntryPoint);
+
+	Console.WriteLn("JitProfiler: Sampling started.");
+}
+
+void JitProfiler::Stop()
+{
+	if (!IsSampling())
+		return;
+
+	s_sampler_stop.store(true, std::memory_order_release);
+	s_sampler_thread.Join();
+	s_tracked_sources.store(0, std::memory_order_release);
+
+	const double seconds = static_cast<double>(GetCPUTicks() - s_start_ticks) / static_cast<double>(GetTickFrequency());
+	WriteReport(seconds);
+
+	s_samples.clear();
+	std::unique_lock lock(s_block_mutex);
+	s_blocks.clear();
+}
+
+void JitProfiler::RegisterBlock(Source source, const void* code, size_t size, u32 pc)
+{
+	if (!(s_tracked_sources.load(std::memory_order_acquire) & (1u << static_cast<u32>(source))) || size == 0)
+		return;
+
+	const uptr start = reinterpret_cast<uptr>(code);
+
+	std::unique_lock lock(s_block_mutex);
+
+	// microVU compiles fall-through blocks inline, so they're registered before the block which
+	// contains them. Those always come last, so the outer block ends where the first one starts.
+	const auto next = s_blocks.upper_bound(start);
+	if (next != s_blocks.end() && next->first < start + size)
+		size = next->first - start;
+
+	s_blocks.insert_or_assign(start, BlockInfo{static_cast<u32>(size), pc, source});
+}
+
+void JitProfiler::InvalidateBlocks(const void* start, const void* end)
+{
+	if (!s_tracked_sources.load(std::memory_order_acquire))
+		return;
+
+	std::unique_lock lock(s_block_mutex);
+	s_blocks.erase(s_blocks.lower_bound(reinterpret_cast<uptr>(start)), s_blocks.lower_bound(reinterpret_cast<uptr>(end)));
+}
+
+void JitProfiler::RegisterThread(const char* name)
+{
+	ThreadInfo info;
+	info.name = name;
+#if defined(_WIN32)
+	info.id = GetCurrentThreadId();
+	info.handle = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_QUERY_INFORMATION, FALSE, info.id);
+	if (!info.handle)
+	{
+		Console.Error("JitProfiler: Failed to open thread handle for %s.", name);
+		return;
+	}
+#elif defined(__APPLE__)
+	info.thread = pthread_self();
+	info.port = pthread_mach_thread_np(info.thread);
+#else
+	info.thread = pthread_self();
+	info.slot = &s_signal_slot;
+#endif
+
+	std::unique_lock lock(s_thread_mutex);
+	s_threads.push_back(info);
+}
+
+void JitProfiler::UnregisterThread()
+{
+	std::unique_lock lock(s_thread_mutex);
+	for (auto it = s_threads.begin(); it != s_threads.end(); ++it)
+	{
+#if defined(_WIN32)
+		if (it->id != GetCurrentThreadId())
+			continue;
+		CloseHandle(it->handle);
+#else
+		if (!pthread_equal(it->thread, pthread_self()))
+			continue;
+#endif
+		s_threads.erase(it);
+		return;
+	}
+}
+
+void JitProfiler::SamplerThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("JIT Profiler");
+
+	const u64 interval = GetTickFrequency() / SAMPLE_RATE;
+	u64 next = GetCPUTicks();
+
+	std::vector<std::pair<const char*, uptr>> pcs;
+	pcs.reserve(8);
+
+	while (!s_sampler_stop.load(std::memory_order_acquire))
+	{
+		// Don't try to catch up after a stall, that would just bias the samples.
+		next = std::max(next + interval, GetCPUTicks());
+		Threading::SleepUntil(next);
+
+		// Idle time while paused would only drown out the interesting samples.
+		if (VMManager::GetState() != VMState::Running)
+			continue;
+
+		pcs.clear();
+		{
+			std::unique_lock lock(s_thread_mutex);
+			for (const ThreadInfo& thread : s_threads)
+			{
+				uptr pc;
+				if (SampleThread(thread, &pc))
+					pcs.emplace_back(thread.name, pc);
+				else
+					s_missed_samples++;
+			}
+		}
+
+		std::unique_lock lock(s_block_mutex);
+		for (const auto& [thread, pc] : pcs)
+		{
+			SampleKey key = {thread, Source::Count, 0};
+			auto it = s_blocks.upper_bound(pc);
+			if (it != s_blocks.begin() && pc < (--it)->first + it->second.size)
+			{
+				key.source = it->second.source;
+				key.pc = it->second.pc;
+			}
+
+			s_samples[key]++;
+		}
+	}
+}
+
+#if defined(_WIN32)
+
+bool JitProfiler::SampleThread(const ThreadInfo& thread, uptr* pc)
+{
+	// Nothing which could take a lock held by the target, such as allocating, can happen
+	// between suspending and resuming it.
+	if (SuspendThread(thread.handle) == static_cast<DWORD>(-1))
+		return false;
+
+	CONTEXT ctx = {};
+	ctx.ContextFlags = CONTEXT_CONTROL;
+	const bool result = GetThreadContext(thread.handle, &ctx);
+	ResumeThread(thread.handle);
+
+#if defined(_M_X86)
+	*pc = static_cast<uptr>(ctx.Rip);
+#elif defined(_M_ARM64)
+	*pc = static_cast<uptr>(ctx.Pc);
+#endif
+	return result;
+}
+
+#elif defined(__APPLE__)
+
+bool JitProfiler::SampleThread(const ThreadInfo& thread, uptr* pc)
+{
+	if (thread_suspend(thread.port) != KERN_SUCCESS)
+		return false;
+
+#if defined(_M_X86)
+	x86_thread_state64_t state;
+	mach_msg_type_number_t count = x86_THREAD_STATE64_COUNT;
+	const bool result = (thread_get_state(thread.port, x86_THREAD_STATE64, reinterpret_cast<thread_state_t>(&state), &count) == KERN_SUCCESS);
+	*pc = static_cast<uptr>(state.__rip);
+#elif defined(_M_ARM64)
+	arm_thread_state64_t state;
+	mach_msg_type_number_t count = ARM_THREAD_STATE64_COUNT;
+	const bool result = (thread_get_state(thread.port, ARM_THREAD_STATE64, reinterpret_cast<thread_state_t>(&state), &count) == KERN_SUCCESS);
+	*pc = static_cast<uptr>(arm_thread_state64_get_pc(state));
+#endif
+
+	thread_resume(thread.port);
+	return result;
+}
+
+#else
+
+void JitProfiler::SignalHandler(int sig, siginfo_t* info, void* ctx)
+{
+#if defined(__linux__) && defined(_M_X86)
+	const uptr pc = static_cast<uptr>(static_cast<ucontext_t*>(ctx)->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__linux__) && defined(_M_ARM64)
+	const uptr pc = static_cast<uptr>(static_cast<ucontext_t*>(ctx)->uc_mcontext.pc);
+#elif defined(__FreeBSD__) && defined(_M_X86)
+	const uptr pc = static_cast<uptr>(static_cast<ucontext_t*>(ctx)->uc_mcontext.mc_rip);
+#elif defined(__FreeBSD__) && defined(_M_ARM64)
+	const uptr pc = static_cast<uptr>(static_cast<ucontext_t*>(ctx)->uc_mcontext.mc_gpregs.gp_elr);
+#endif
+
+	// A late signal answers whatever request is current, which is still this thread's pc.
+	s_signal_slot.pc.store(pc, std::memory_order_relaxed);
+	s_signal_slot.response.store(s_signal_slot.request.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+bool JitProfiler::SampleThread(const ThreadInfo& thread, uptr* pc)
+{
+	SignalSlot* slot = thread.slot;
+	const u32 request = slot->request.load(std::memory_order_relaxed) + 1;
+	slot->request.store(request, std::memory_order_relaxed);
+	if (pthread_kill(thread.thread, SIGPROF) != 0)
+		return false;
+
+	// Signals are delivered promptly, even to blocked threads. Give up after a millisecond.
+	const u64 timeout = GetCPUTicks() + (GetTickFrequency() / 1000);
+	while (slot->response.load(std::memory_order_acquire) != request)
+	{
+		if (GetCPUTicks() >= timeout)
+			return false;
+
+		std::this_thread::yield();
+	}
+
+	*pc = slot->pc.load(std::memory_order_relaxed);
+	return true;
+}
+
+#endif
+
+std::string JitProfiler::FormatFunctionName(Source source, u32 pc)
+{
+	const SymbolGuardian* guardian = nullptr;
+	if (source == Source::EE)
+		guardian = &R5900SymbolGuardian;
+	else if (source == Source::IOP)
+		guardian = &R3000SymbolGuardian;
+
+	// VU microprograms don't have symbols.
+	if (!guardian)
+		return {};
+
+	FunctionInfo function = guardian->FunctionOverlappingAddress(pc);
+	if (function.name.empty())
+		return "[unknown]";
+
+	// Spaces and semicolons are separators in the collapsed stack format.
+	std::replace(function.name.begin(), function.name.end(), ' ', '_');
+	std::replace(function.name.begin(), function.name.end(), ';', '_');
+	return std::move(function.name);
+}
+
+void JitProfiler::WriteReport(double seconds)
+{
+	if (s_samples.empty())
+	{
+		Console.WriteLn("JitProfiler: Sampling stopped, no samples were collected.");
+		return;
+	}
+
+	struct BlockSamples
+	{
+		Source source;
+		u32 pc;
+		u32 count;
+		std::string function;
+	};
+
+	struct FunctionSamples
+	{
+		Source source;
+		std::string function;
+		u32 count;
+	};
+
+	// Blocks are merged across threads for the hot list, but not for the stacks.
+	u32 total = 0;
+	u32 host = 0;
+	std::map<std::pair<Source, u32>, BlockSamples> blocks;
+	std::map<std::pair<Source, std::string>, u32> functions;
+	std::map<std::string, u32> stacks;
+	for (const auto& [key, count] : s_samples)
+	{
+		total += count;
+		if (key.source == Source::Count)
+		{
+			host += count;
+			stacks[fmt::format("{};[host]", key.thread)] += count;
+			continue;
+		}
+
+		auto it = blocks.find({key.source, key.pc});
+		if (it == blocks.end())
+		{
+			it = blocks.emplace(std::make_pair(key.source, key.pc),
+				BlockSamples{key.source, key.pc, 0, FormatFunctionName(key.source, key.pc)}).first;
+		}
+		it->second.count += count;
+
+		const char* source_name = s_source_names[static_cast<u32>(key.source)];
+		if (it->second.function.empty())
+			stacks[fmt::format("{};{};{:04X}", key.thread, source_name, key.pc)] += count;
+		else
+			stacks[fmt::format("{};{};{};{:08X}", key.thread, source_name, it->second.function, key.pc)] += count;
+	}
+
+	for (const auto& [key, block] : blocks)
+	{
+		if (!block.function.empty())
+			functions[{block.source, block.function}] += block.count;
+	}
+
+	std::string serial = VMManager::GetDiscSerial();
+	if (serial.empty())
+		serial = "unknown";
+	Path::SanitizeFileName(&serial);
+
+	char timestamp[16] = {};
+	const time_t cur_time = time(nullptr);
+	std::strftime(timestamp, sizeof(timestamp), "%Y%m%d%H%M%S", localtime(&cur_time));
+
+	const std::string base_path(Path::Combine(EmuFolders::Logs, fmt::format("jitprofile_{}_{}", serial, timestamp)));
+	const std::string stacks_path(base_path + ".folded");
+	const std::string hot_path(base_path + ".txt");
+
+	Error error;
+	auto fp = FileSystem::OpenManagedCFile(stacks_path.c_str(), "wb", &error);
+	if (!fp)
+	{
+		Console.ErrorFmt("JitProfiler: Failed to open {}: {}", stacks_path, error.GetDescription());
+		return;
+	}
+
+	for (const auto& [stack, count] : stacks)
+		fmt::print(fp.get(), "{} {}\n", stack, count);
+	fp.reset();
+
+	fp = FileSystem::OpenManagedCFile(hot_path.c_str(), "wb", &error);
+	if (!fp)
+	{
+		Console.ErrorFmt("JitProfiler: Failed to open {}: {}", hot_path, error.GetDescription());
+		return;
+	}
+
+	const auto percent = [total](u32 count) { return (static_cast<double>(count) * 100.0) / static_cast<double>(total); };
+
+	fmt::print(fp.get(), "# {} samples over {:.1f} seconds at {} Hz, {} missed.\n", total, seconds, SAMPLE_RATE, s_missed_samples);
+	fmt::print(fp.get(), "# {} samples ({:.2f}%) were outside of recompiled blocks. These include time spent waiting,\n", host, percent(host));
+	fmt::print(fp.get(), "# e.g. on the frame limiter, so disable it when measuring CPU cost.\n\n");
+
+	std::vector<FunctionSamples> sorted_functions;
+	sorted_functions.reserve(functions.size());
+	for (const auto& [key, count] : functions)
+		sorted_functions.push_back({key.first, key.second, count});
+	std::sort(sorted_functions.begin(), sorted_functions.end(),
+		[](const FunctionSamples& lhs, const FunctionSamples& rhs) { return lhs.count > rhs.count; });
+
+	fmt::print(fp.get(), "Hot functions:\n{:>8} {:>8}  {:<6} {}\n", "Samples", "Percent", "Source", "Function");
+	for (size_t i = 0; i < std::min<size_t>(sorted_functions.size(), HOT_LIST_SIZE); i++)
+	{
+		const FunctionSamples& fs = sorted_functions[i];
+		fmt::print(fp.get(), "{:>8} {:>7.2f}%  {:<6} {}\n", fs.count, percent(fs.count),
+			s_source_names[static_cast<u32>(fs.source)], fs.function);
+	}
+
+	std::vector<BlockSamples> sorted_blocks;
+	sorted_blocks.reserve(blocks.size());
+	for (auto& [key, block] : blocks)
+		sorted_blocks.push_back(std::move(block));
+	std::sort(sorted_blocks.begin(), sorted_blocks.end(),
+		[](const BlockSamples& lhs, const BlockSamples& rhs) { return lhs.count > rhs.count; });
+
+	fmt::print(fp.get(), "\nHot blocks:\n{:>8} {:>8}  {:<6} {:<8}  {}\n", "Samples", "Percent", "Source", "Block", "Function");
+	for (size_t i = 0; i < std::min<size_t>(sorted_blocks.size(), HOT_LIST_SIZE); i++)
+	{
+		const BlockSamples& bs = sorted_blocks[i];
+		fmt::print(fp.get(), "{:>8} {:>7.2f}%  {:<6} {:08X}  {}\n", bs.count, percent(bs.count),
+			s_source_names[static_cast<u32>(bs.source)], bs.pc, bs.function);
+	}
+
+	Console.WriteLnFmt("JitProfiler: Sampling stopped, wrote {} samples to {}", total, base_path);
+}
@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "Config.h"
+
+// --------------------------------------------------------------------------------------
+//  JitProfiler
+// --------------------------------------------------------------------------------------
+// Sampling profiler for recompiled code. A background thread periodically interrupts the
+// registered emulation threads and reads their host program counter, which is mapped back
+// to the guest block it belongs to. When the profiler is stopped, the samples are grouped
+// by guest function (using the loaded symbols) and written to the logs directory, both as
+// collapsed stacks for flamegraph tools and as a list of the hottest functions and blocks.
+//
+// The profiler is controlled by the [EmuCore/Profiler] options. Blocks are only tracked
+// while it is running, so the recompilers must be reset when it starts.
+//
+namespace JitProfiler
+{
+	enum class Source : u8
+	{
+		EE,
+		IOP,
+		VU0,
+		VU1,
+		Count
+	};
+
+	/// Starts or stops the profiler to match the options. Stopping writes the report.
+	void ApplyConfig(const Pcsx2Config::ProfilerOptions& options);
+
+	/// Stops the profiler and writes the report, if it is running.
+	void Stop();
+
+	/// Records the host code range of a recompiled block, if blocks from the source are being
+	/// tracked. Can be called from any thread.
+	void RegisterBlock(Source source, const void* code, size_t size, u32 pc);
+
+	/// Forgets all blocks in a host code range, called when a recompiler resets its cache.
+	void InvalidateBlocks(const void* start, const void* end);
+
+	/// Adds the calling thread to the set of sampled threads, until it calls UnregisterThread().
+	void RegisterThread(const char* name);
+	void UnregisterThread();
+} // namespace JitProfiler
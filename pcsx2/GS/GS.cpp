@@ -17,6 +17,7 @@
 #include "Input/InputManager.h"
 #include "MTGS.h"
 #include "pcsx2/GS.h"
+#include "GS/Renderers/Null/GSDeviceNull.h"
 #include "GS/Renderers/Null/GSRendererNull.h"
 #include "GS/Renderers/HW/GSRendererHW.h"
 #include "GS/Renderers/HW/GSTextureReplacements.h"
@@ -98,6 +99,9 @@ static RenderAPI GetAPIForRenderer(GSRendererType renderer)
 			return RenderAPI::Metal;
 #endif
 
+		case GSRendererType::NullHW:
+			return RenderAPI::None;
+
 			// We could end up here if we ever removed a renderer.
 		default:
 			return GetAPIForRenderer(GSUtil::GetPreferredRenderer());
@@ -110,6 +114,10 @@ static bool OpenGSDevice(GSRendererType renderer, bool clear_state_on_fail, bool
 	const RenderAPI new_api = GetAPIForRenderer(renderer);
 	switch (new_api)
 	{
+		case RenderAPI::None:
+			g_gs_device = std::make_unique<GSDeviceNull>();
+			break;
+
 #ifdef _WIN32
 		case RenderAPI::D3D11:
 			g_gs_device = std::make_unique<GSDevice11>();
@@ -476,10 +484,10 @@ int GSfreeze(FreezeAction mode, freezeData* data)
 	}
 }
 
-void GSQueueSnapshot(const std::string& path, u32 gsdump_frames)
+void GSQueueSnapshot(const std::string& path, u32 gsdump_frames, bool screenshot)
 {
 	if (g_gs_renderer)
-		g_gs_renderer->QueueSnapshot(path, gsdump_frames);
+		g_gs_renderer->QueueSnapshot(path, gsdump_frames, screenshot);
 }
 
 void GSStopGSDump()
@@ -523,6 +531,9 @@ void GSGameChanged()
 	if (GSIsHardwareRenderer())
 		GSTextureReplacements::GameChanged();
 
+	if (g_gs_renderer)
+		g_gs_renderer->GameChanged();
+
 	if (!VMManager::HasValidVM() && GSCapture::IsCapturing())
 		GSCapture::EndCapture();
 }
@@ -693,7 +704,8 @@ void GSgetStats(SmallStringBase& info)
 	}
 	else
 	{
-		info.format("{} HW | {} PRIM | {} DRW | {} DRWC | {} BAR | {} RP | {} RB | {} TC | {} TU",
+		const double target_lookups = pm.Get(GSPerfMon::TargetLookups);
+		info.format("{} HW | {} PRIM | {} DRW | {} DRWC | {} BAR | {} RP | {} RB | {} TC | {} TU | {:.1f} TV",
 			api_name,
 			(int)pm.Get(GSPerfMon::Prim),
 			(int)pm.Get(GSPerfMon::Draw),
@@ -702,7 +714,8 @@ void GSgetStats(SmallStringBase& info)
 			(int)std::ceil(pm.Get(GSPerfMon::RenderPasses)),
 			(int)std::ceil(pm.Get(GSPerfMon::Readbacks)),
 			(int)std::ceil(pm.Get(GSPerfMon::TextureCopies)),
-			(int)std::ceil(pm.Get(GSPerfMon::TextureUploads)));
+			(int)std::ceil(pm.Get(GSPerfMon::TextureUploads)),
+			(target_lookups > 0.0) ? (pm.Get(GSPerfMon::TargetsVisited) / target_lookups) : 0.0);
 	}
 }
 
@@ -731,7 +744,7 @@ void GSgetMemoryStats(SmallStringBase& info)
 
 	if (GSConfig.TexturePreloading == TexturePreloadingLevel::Full)
 	{
-		const double hashcache_MB = get_MB(static_cast<double>(g_texture_cache->GetHashCacheMemoryUsage()));
+		const double hashcache_MB = get_MB(static_cast<double>(g_texture_cache->GetTotalHashCacheMemoryUsage()));
 		const double total_MB = targets_MB + sources_MB + hashcache_MB + pool_MB;
 		info.format("VRAM: {} MB | TGT: {} MB | SRC: {} MB | HC: {} MB | PL: {} MB",
 			format_precision(total_MB),
@@ -789,7 +802,12 @@ void GSUpdateConfig(const Pcsx2Config::GSOptions& new_config)
 
 	// Options which aren't using the global struct yet, so we need to recreate all GS objects.
 	if (GSConfig.SWExtraThreads != old_config.SWExtraThreads ||
-		GSConfig.SWExtraThreadsHeight != old_config.SWExtraThreadsHeight)
+		GSConfig.SWExtraThreadsHeight != old_config.SWExtraThreadsHeight ||
+		GSConfig.SWExtraThreadsTiled != old_config.SWExtraThreadsTiled ||
+		GSConfig.SWWorkerWait != old_config.SWWorkerWait ||
+		GSConfig.SWSelectorProfiling != old_config.SWSelectorProfiling ||
+		GSConfig.SWParallelTextureUpdate != old_config.SWParallelTextureUpdate ||
+		GSConfig.SWHierarchicalZ != old_config.SWHierarchicalZ)
 	{
 		if (!GSreopen(false, true, GSConfig.Renderer, &old_config))
 			pxFailRel("Failed to do quick GS reopen");
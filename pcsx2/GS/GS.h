@@ -74,7 +74,7 @@ void GSvsync(u32 field, bool registers_written);
 int GSfreeze(FreezeAction mode, freezeData* data);
 std::string GSGetBaseSnapshotFilename();
 std::string GSGetBaseVideoFilename();
-void GSQueueSnapshot(const std::string& path, u32 gsdump_frames = 0);
+void GSQueueSnapshot(const std::string& path, u32 gsdump_frames = 0, bool screenshot = true);
 void GSStopGSDump();
 bool GSBeginCapture(std::string filename);
 void GSEndCapture();
@@ -8,6 +8,8 @@
 #include "GSVector.h"
 #include "MultiISA.h"
 
+#include <atomic>
+
 MULTI_ISA_UNSHARED_START
 
 class GSBlock
@@ -1231,6 +1233,82 @@ public:
 #endif
 	}
 
+	// Page sized versions of the block writes, for uploads covering whole pages.
+	// The page is swizzled into an L1 resident buffer and then written out with non-temporal stores,
+	// so a large transfer doesn't evict everything else from the cache on its way to local memory.
+	// Call StreamFence() after the last page, before another thread can read them.
+
+	__forceinline static void StreamPage(u8* RESTRICT dst, const u8* RESTRICT buff)
+	{
+#if _M_SSE >= 0x501
+		GSVector8i::storent(dst, buff, GS_PAGE_SIZE);
+#else
+		GSVector4i::storent(dst, buff, GS_PAGE_SIZE);
+#endif
+	}
+
+	__forceinline static void StreamFence()
+	{
+#ifdef _M_X86
+		_mm_sfence();
+#else
+		std::atomic_thread_fence(std::memory_order_release);
+#endif
+	}
+
+	/// Swizzles a page of `pbw` x `pbh` blocks of `bsx` x `bsy` pixels into `buff`, using `fn` to write each block.
+	template <int pbw, int pbh, int bsx, int bsy, int bpp, typename Fn>
+	__forceinline static void SwizzlePage(u8* RESTRICT buff, const GSBlockSwizzleTable& table, const u8* RESTRICT src, int srcpitch, Fn&& fn)
+	{
+		for (int by = 0; by < pbh; by++, src += srcpitch * bsy)
+		{
+			for (int bx = 0; bx < pbw; bx++)
+			{
+				fn(&buff[table.lookup(bx, by) * GS_BLOCK_SIZE], &src[(bx * bsx * bpp) >> 3]);
+			}
+		}
+	}
+
+	template <int alignment>
+	static void WritePage32(u8* RESTRICT dst, const u8* RESTRICT src, int srcpitch, const GSBlockSwizzleTable& table)
+	{
+		alignas(64) u8 buff[GS_PAGE_SIZE];
+		SwizzlePage<8, 4, 8, 8, 32>(buff, table, src, srcpitch, [srcpitch](u8* d, const u8* s) {
+			WriteBlock32<alignment, 0xffffffff>(d, s, srcpitch);
+		});
+		StreamPage(dst, buff);
+	}
+
+	template <int alignment>
+	static void WritePage16(u8* RESTRICT dst, const u8* RESTRICT src, int srcpitch, const GSBlockSwizzleTable& table)
+	{
+		alignas(64) u8 buff[GS_PAGE_SIZE];
+		SwizzlePage<4, 8, 16, 8, 16>(buff, table, src, srcpitch, [srcpitch](u8* d, const u8* s) {
+			WriteBlock16<alignment>(d, s, srcpitch);
+		});
+		StreamPage(dst, buff);
+	}
+
+	template <int alignment>
+	static void WritePage8(u8* RESTRICT dst, const u8* RESTRICT src, int srcpitch, const GSBlockSwizzleTable& table)
+	{
+		alignas(64) u8 buff[GS_PAGE_SIZE];
+		SwizzlePage<8, 4, 16, 16, 8>(buff, table, src, srcpitch, [srcpitch](u8* d, const u8* s) {
+			WriteBlock8<alignment>(d, s, srcpitch);
+		});
+		StreamPage(dst, buff);
+	}
+
+	template <int alignment>
+	static void WritePage4(u8* RESTRICT dst, const u8* RESTRICT src, int srcpitch, const GSBlockSwizzleTable& table)
+	{
+		alignas(64) u8 buff[GS_PAGE_SIZE];
+		SwizzlePage<4, 8, 32, 16, 4>(buff, table, src, srcpitch, [srcpitch](u8* d, const u8* s) {
+			WriteBlock4<alignment>(d, s, srcpitch);
+		});
+		StreamPage(dst, buff);
+	}
+
 	template <u32 mask>
 	__forceinline static void UnpackAndWriteBlockH(const u8* RESTRICT src, int srcpitch, u8* RESTRICT dst)
 	{
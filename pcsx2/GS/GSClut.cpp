@@ -6,6 +6,7 @@
 #include "GS/GSLocalMemory.h"
 #include "GS/GSGL.h"
 #include "GS/GSUtil.h"
+#include "GS/GSXXH.h"
 #include "GS/Renderers/Common/GSDevice.h"
 #include "GS/Renderers/Common/GSRenderer.h"
 #include "common/AlignedMalloc.h"
@@ -135,6 +136,90 @@ void GSClut::Reset()
 	m_write.dirty = 1;
 	m_read = {};
 	m_read.dirty = true;
+	ClearPaletteCache();
+}
+
+void GSClut::ClearPaletteCache()
+{
+	for (PaletteCacheEntry& entry : m_palette_cache)
+	{
+		entry.valid = false;
+		entry.alpha_valid = false;
+	}
+
+	m_palette_current = nullptr;
+	m_palette_cache_clock = 0;
+	m_buff32 = reinterpret_cast<u32*>(reinterpret_cast<u8*>(m_clut) + 2048);
+}
+
+GSClut::PaletteCacheEntry* GSClut::LookupPalette(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, bool& hit)
+{
+	hit = false;
+
+	const u32 pal = GSLocalMemory::m_psm[TEX0.PSM].pal;
+	if (pal == 0)
+		return nullptr;
+
+	// Only hash the entries the conversion actually reads, 4-bit palettes are tiny.
+	u32 key = (pal == 256) | (TEX0.CPSM << 1);
+	const u16* clut;
+	u32 clut_size;
+	u16 split_clut[32];
+	if (TEX0.CPSM == PSMCT32 || TEX0.CPSM == PSMCT24)
+	{
+		if (pal == 256)
+		{
+			// The offset clamps rather than wraps, so it has to be part of the key.
+			key |= (TEX0.CSA & 15) << 7;
+			clut = m_clut;
+			clut_size = 512 * sizeof(u16);
+		}
+		else
+		{
+			// The low and high halves of each colour are 256 entries apart.
+			const u16* src = m_clut + ((TEX0.CSA & 15) << 4);
+			std::memcpy(split_clut, src, 16 * sizeof(u16));
+			std::memcpy(split_clut + 16, src + 256, 16 * sizeof(u16));
+			clut = split_clut;
+			clut_size = sizeof(split_clut);
+		}
+	}
+	else if (TEX0.CPSM == PSMCT16 || TEX0.CPSM == PSMCT16S)
+	{
+		key |= (TEXA.TA0 << 11) | (TEXA.TA1 << 19) | (TEXA.AEM << 27);
+		clut = m_clut + (TEX0.CSA << 4);
+		clut_size = pal * sizeof(u16);
+	}
+	else
+	{
+		return nullptr;
+	}
+
+	const u64 hash = GSXXH3_64bits(clut, clut_size);
+
+	PaletteCacheEntry* victim = &m_palette_cache[0];
+	for (PaletteCacheEntry& entry : m_palette_cache)
+	{
+		if (entry.valid && entry.key == key && entry.hash == hash && entry.clut_size == clut_size &&
+			std::memcmp(entry.clut, clut, clut_size) == 0)
+		{
+			entry.last_use = ++m_palette_cache_clock;
+			hit = true;
+			return &entry;
+		}
+
+		if (!entry.valid || (victim->valid && entry.last_use < victim->last_use))
+			victim = &entry;
+	}
+
+	std::memcpy(victim->clut, clut, clut_size);
+	victim->clut_size = clut_size;
+	victim->hash = hash;
+	victim->key = key;
+	victim->last_use = ++m_palette_cache_clock;
+	victim->valid = true;
+	victim->alpha_valid = false;
+	return victim;
 }
 
 bool GSClut::InvalidateRange(u32 start_block, u32 end_block, bool is_draw)
@@ -370,9 +455,25 @@ void GSClut::Read32(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
 		m_read.dirty = false;
 		m_read.adirty = true;
 
+		bool hit;
+		m_palette_current = LookupPalette(TEX0, TEXA, hit);
+		if (m_palette_current)
+			m_buff32 = m_palette_current->buff32;
+
 		u16* clut = m_clut;
 
-		if (TEX0.CPSM == PSMCT32 || TEX0.CPSM == PSMCT24)
+		if (hit)
+		{
+			m_read.amin = m_palette_current->amin;
+			m_read.amax = m_palette_current->amax;
+			// The 24-bit TA0 shortcut in GetAlphaMinMax32() depends on TEXA, which isn't part of a 32-bit key.
+			m_read.adirty = !m_palette_current->alpha_valid ||
+			                (GSLocalMemory::m_psm[TEX0.CPSM].trbpp == 24 && TEXA.AEM == 0);
+
+			if (GSLocalMemory::m_psm[TEX0.PSM].pal == 16)
+				ExpandCLUT64_T32_I8(m_buff32, (u64*)m_buff64); // sw renderer does not need m_buff64 anymore
+		}
+		else if (TEX0.CPSM == PSMCT32 || TEX0.CPSM == PSMCT24)
 		{
 			switch (TEX0.PSM)
 			{
@@ -534,6 +635,13 @@ void GSClut::GetAlphaMinMax32(int& amin_out, int& amax_out)
 
 			m_read.amin = v0.min_i16(v1).extract16<0>();
 			m_read.amax = v0.max_i16(v1).extract16<1>();
+
+			if (m_palette_current)
+			{
+				m_palette_current->amin = m_read.amin;
+				m_palette_current->amax = m_read.amax;
+				m_palette_current->alpha_valid = true;
+			}
 		}
 	}
 
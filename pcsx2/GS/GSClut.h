@@ -46,6 +46,31 @@ class alignas(32) GSClut final : public GSAlignedClass<32>
 		bool IsDirty(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA);
 	} m_read = {};
 
+	// Converted palettes, keyed on the raw CLUT entries they were expanded from plus the conversion
+	// parameters. Games which flip between a handful of palettes per draw hit this instead of
+	// re-expanding and rescanning the alpha range every time.
+	static constexpr u32 PALETTE_CACHE_SIZE = 16;
+
+	struct alignas(32) PaletteCacheEntry
+	{
+		u32 buff32[256];
+		u16 clut[512]; // Source entries, compared on a hash match.
+		u64 hash;
+		u32 clut_size;
+		u32 key;
+		u32 last_use;
+		int amin, amax;
+		bool valid;
+		bool alpha_valid;
+	};
+
+	PaletteCacheEntry m_palette_cache[PALETTE_CACHE_SIZE] = {};
+	PaletteCacheEntry* m_palette_current = nullptr;
+	u32 m_palette_cache_clock = 0;
+
+	PaletteCacheEntry* LookupPalette(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, bool& hit);
+	void ClearPaletteCache();
+
 	GSTexture* m_gpu_clut4 = nullptr;
 	GSTexture* m_gpu_clut8 = nullptr;
 	GSTexture* m_current_gpu_clut = nullptr;
@@ -10,12 +10,19 @@
 #include "common/FileSystem.h"
 #include "common/HeapArray.h"
 #include "common/ScopedGuard.h"
+#include "common/Threading.h"
+#include "common/Timer.h"
 
 #include <7zCrc.h>
 #include <XzCrc64.h>
 #include <XzEnc.h>
 #include <zstd.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 GSDumpBase::GSDumpBase(std::string fn)
 	: m_filename(std::move(fn))
 	, m_frames(0)
@@ -38,13 +45,13 @@ void GSDumpBase::AddHeader(const std::string& serial, u32 crc,
 {
 	// New header: CRC of FFFFFFFF, secondary header, full header follows.
 	const u32 fake_crc = 0xFFFFFFFFu;
-	AppendRawData(&fake_crc, 4);
+	Append(&fake_crc, 4);
 
 	// Compute full header size (with serial).
 	// This acts as the state size for loading older dumps.
 	const u32 screenshot_size = screenshot_width * screenshot_height * sizeof(screenshot_pixels[0]);
 	const u32 header_size = sizeof(GSDumpHeader) + static_cast<u32>(serial.size()) + screenshot_size;
-	AppendRawData(&header_size, 4);
+	Append(&header_size, 4);
 
 	// Write hader.
 	GSDumpHeader header = {};
@@ -57,15 +64,15 @@ void GSDumpBase::AddHeader(const std::string& serial, u32 crc,
 	header.screenshot_height = screenshot_height;
 	header.screenshot_offset = header.serial_offset + header.serial_size;
 	header.screenshot_size = screenshot_size;
-	AppendRawData(&header, sizeof(header));
+	Append(&header, sizeof(header));
 	if (!serial.empty())
-		AppendRawData(serial.data(), serial.size());
+		Append(serial.data(), serial.size());
 	if (screenshot_pixels)
-		AppendRawData(screenshot_pixels, screenshot_size);
+		Append(screenshot_pixels, screenshot_size);
 
 	// Then the real state data.
-	AppendRawData(fd.data, fd.size);
-	AppendRawData(regs, sizeof(*regs));
+	Append(fd.data, fd.size);
+	Append(regs, sizeof(*regs));
 }
 
 void GSDumpBase::Transfer(int index, const u8* mem, size_t size)
@@ -73,10 +80,10 @@ void GSDumpBase::Transfer(int index, const u8* mem, size_t size)
 	if (size == 0)
 		return;
 
-	AppendRawData(0);
-	AppendRawData(static_cast<u8>(index));
-	AppendRawData(&size, 4);
-	AppendRawData(mem, size);
+	Append(0);
+	Append(static_cast<u8>(index));
+	Append(&size, 4);
+	Append(mem, size);
 }
 
 void GSDumpBase::ReadFIFO(u32 size)
@@ -84,8 +91,71 @@ void GSDumpBase::ReadFIFO(u32 size)
 	if (size == 0)
 		return;
 
-	AppendRawData(2);
-	AppendRawData(&size, 4);
+	Append(2);
+	Append(&size, 4);
+}
+
+void GSDumpBase::Keyframe(u64 draw, const freezeData& fd, const GSPrivRegSet* regs)
+{
+	// Keyframes have to start a new compressed frame, otherwise seeking would still decompress from the start.
+	const std::optional<u64> file_offset = EndFrame();
+
+	GSDumpKeyframeIndexEntry entry = {};
+	entry.frame = static_cast<u32>(m_frames);
+	entry.draw = draw;
+	entry.stream_offset = m_stream_size;
+	entry.file_offset = file_offset.value_or(0);
+	m_keyframes.push_back(entry);
+
+	GSDumpKeyframe keyframe = {};
+	keyframe.frame = static_cast<u32>(m_frames);
+	keyframe.state_size = static_cast<u32>(fd.size);
+	keyframe.draw = draw;
+
+	const u32 size = sizeof(keyframe) + keyframe.state_size + sizeof(*regs);
+	Append(4);
+	Append(&size, 4);
+	Append(&keyframe, sizeof(keyframe));
+	Append(fd.data, fd.size);
+	Append(regs, sizeof(*regs));
+
+	m_last_keyframe = m_frames;
+}
+
+std::vector<u8> GSDumpBase::GetKeyframeIndex() const
+{
+	std::vector<u8> ret;
+	if (m_keyframes.empty())
+		return ret;
+
+	const size_t entries_size = m_keyframes.size() * sizeof(GSDumpKeyframeIndexEntry);
+	GSDumpKeyframeIndexFooter footer = {};
+	footer.count = static_cast<u32>(m_keyframes.size());
+	footer.version = GSDUMP_KEYFRAME_INDEX_VERSION;
+	footer.magic = GSDUMP_KEYFRAME_INDEX_MAGIC;
+
+	ret.resize(entries_size + sizeof(footer));
+	std::memcpy(ret.data(), m_keyframes.data(), entries_size);
+	std::memcpy(ret.data() + entries_size, &footer, sizeof(footer));
+	return ret;
+}
+
+void GSDumpBase::SetKeyframeFileOffset(size_t index, u64 file_offset)
+{
+	if (index < m_keyframes.size())
+		m_keyframes[index].file_offset = file_offset;
+}
+
+void GSDumpBase::AppendKeyframeIndex()
+{
+	const std::vector<u8> index = GetKeyframeIndex();
+	if (index.empty())
+		return;
+
+	const u32 size = static_cast<u32>(index.size());
+	Append(5);
+	Append(&size, 4);
+	Append(index.data(), index.size());
 }
 
 bool GSDumpBase::VSync(int field, bool last, const GSPrivRegSet* regs)
@@ -94,11 +164,11 @@ bool GSDumpBase::VSync(int field, bool last, const GSPrivRegSet* regs)
 	if (!m_gs)
 		return true;
 
-	AppendRawData(3);
-	AppendRawData(regs, sizeof(*regs));
+	Append(3);
+	Append(regs, sizeof(*regs));
 
-	AppendRawData(1);
-	AppendRawData(static_cast<u8>(field));
+	Append(1);
+	Append(static_cast<u8>(field));
 
 	if (last)
 		m_extra_frames--;
@@ -106,6 +176,18 @@ bool GSDumpBase::VSync(int field, bool last, const GSPrivRegSet* regs)
 	return (++m_frames & 1) == 0 && last && (m_extra_frames < 0);
 }
 
+void GSDumpBase::Append(const void* data, size_t size)
+{
+	m_stream_size += size;
+	AppendRawData(data, size);
+}
+
+void GSDumpBase::Append(u8 c)
+{
+	m_stream_size++;
+	AppendRawData(c);
+}
+
 void GSDumpBase::Write(const void* data, size_t size)
 {
 	if (!m_gs || size == 0)
@@ -114,6 +196,8 @@ void GSDumpBase::Write(const void* data, size_t size)
 	size_t written = fwrite(data, 1, size, m_gs);
 	if (written != size)
 		Console.Error("GSDump: Error failed to write data");
+
+	m_file_size += written;
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -131,7 +215,7 @@ namespace
 		GSDumpUncompressed(const std::string& fn, const std::string& serial, u32 crc,
 			u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
 			const freezeData& fd, const GSPrivRegSet* regs);
-		virtual ~GSDumpUncompressed() = default;
+		~GSDumpUncompressed() override;
 	};
 
 	GSDumpUncompressed::GSDumpUncompressed(const std::string& fn, const std::string& serial, u32 crc,
@@ -142,6 +226,11 @@ namespace
 		AddHeader(serial, crc, screenshot_width, screenshot_height, screenshot_pixels, fd, regs);
 	}
 
+	GSDumpUncompressed::~GSDumpUncompressed()
+	{
+		AppendKeyframeIndex();
+	}
+
 	void GSDumpUncompressed::AppendRawData(const void* data, size_t size)
 	{
 		Write(data, size);
@@ -221,25 +310,29 @@ namespace
 {
 	class GSDumpXz final : public GsDumpBuffered
 	{
+		int m_level;
+
 		void Compress();
 
 	public:
 		GSDumpXz(const std::string& fn, const std::string& serial, u32 crc,
 			u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
-			const freezeData& fd, const GSPrivRegSet* regs);
+			const freezeData& fd, const GSPrivRegSet* regs, int level);
 		~GSDumpXz() override;
 	};
 
 	GSDumpXz::GSDumpXz(const std::string& fn, const std::string& serial, u32 crc,
 		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
-		const freezeData& fd, const GSPrivRegSet* regs)
+		const freezeData& fd, const GSPrivRegSet* regs, int level)
 		: GsDumpBuffered(fn + ".gs.xz")
+		, m_level(level)
 	{
 		AddHeader(serial, crc, screenshot_width, screenshot_height, screenshot_pixels, fd, regs);
 	}
 
 	GSDumpXz::~GSDumpXz()
 	{
+		AppendKeyframeIndex();
 		Compress();
 	}
 
@@ -284,8 +377,12 @@ namespace
 
 		GSInit7ZCRCTables();
 
+		// Fixed size blocks, so readers can seek without decompressing everything before a keyframe.
 		CXzProps props;
 		XzProps_Init(&props);
+		props.blockSize = GSDUMP_XZ_BLOCK_SIZE;
+		if (m_level > 0)
+			props.lzma2Props.lzmaProps.level = std::min(m_level, 9);
 		const SRes res = Xz_Encode(&dos.vt, &mis.vt, &props, nullptr);
 		if (res != SZ_OK)
 		{
@@ -298,11 +395,11 @@ namespace
 std::unique_ptr<GSDumpBase> GSDumpBase::CreateXzDump(
 	const std::string& fn, const std::string& serial, u32 crc,
 	u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
-	const freezeData& fd, const GSPrivRegSet* regs)
+	const freezeData& fd, const GSPrivRegSet* regs, int level)
 {
 	return std::make_unique<GSDumpXz>(fn, serial, crc,
 		screenshot_width, screenshot_height, screenshot_pixels,
-		fd, regs);
+		fd, regs, level);
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -313,45 +410,116 @@ namespace
 {
 	class GSDumpZst final : public GSDumpBase
 	{
+		/// Raw stream data is handed off in blocks of this size.
+		static constexpr size_t BLOCK_SIZE = _1mb;
+
+		/// The GS thread only waits for the compressor when this much raw data is queued.
+		static constexpr size_t MAX_QUEUED_SIZE = 256 * _1mb;
+
+		struct Block
+		{
+			std::vector<u8> data;
+			bool end_frame;
+		};
+
 		ZSTD_CStream* m_strm;
+		std::vector<u8> m_out_buff;
 
+		// Owned by the GS thread.
 		std::vector<u8> m_in_buff;
-		std::vector<u8> m_out_buff;
+
+		// Owned by the compression thread.
+		std::vector<u64> m_frame_offsets;
+
+		std::thread m_thread;
+		std::mutex m_mutex;
+		std::condition_variable m_work_cv;
+		std::condition_variable m_done_cv;
+		std::deque<Block> m_queue;
+		std::vector<std::vector<u8>> m_free_buffers;
+		size_t m_queued_size = 0;
+		bool m_shutdown = false;
+
+		// Backpressure statistics, protected by m_mutex.
+		u64 m_raw_size = 0;
+		size_t m_peak_queued_size = 0;
+		u32 m_stalls = 0;
+		Common::Timer::Value m_stall_time = 0;
 
 		void MayFlush();
-		void Compress(ZSTD_EndDirective action);
-		void AppendRawData(const void* data, size_t size);
-		void AppendRawData(u8 c);
+		void Submit(bool end_frame);
+		void CompressThreadEntryPoint();
+		void Compress(const std::vector<u8>& data, ZSTD_EndDirective action);
+		void AppendRawData(const void* data, size_t size) override;
+		void AppendRawData(u8 c) override;
+		std::optional<u64> EndFrame() override;
 
 	public:
 		GSDumpZst(const std::string& fn, const std::string& serial, u32 crc,
 			u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
-			const freezeData& fd, const GSPrivRegSet* regs);
+			const freezeData& fd, const GSPrivRegSet* regs, int level);
 		virtual ~GSDumpZst();
 	};
 
 	GSDumpZst::GSDumpZst(const std::string& fn, const std::string& serial, u32 crc,
 		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
-		const freezeData& fd, const GSPrivRegSet* regs)
+		const freezeData& fd, const GSPrivRegSet* regs, int level)
 		: GSDumpBase(fn + ".gs.zst")
 	{
 		m_strm = ZSTD_createCStream();
 
 		// Compression level 6 provides a good balance between speed and ratio.
-		ZSTD_CCtx_setParameter(m_strm, ZSTD_c_compressionLevel, 6);
+		ZSTD_CCtx_setParameter(m_strm, ZSTD_c_compressionLevel, (level > 0) ? level : 6);
+
+		// Leave most of the cores to the emulator. This fails harmlessly if zstd was built without threading.
+		const int workers = std::clamp(static_cast<int>(std::thread::hardware_concurrency() / 4), 1, 4);
+		if (ZSTD_isError(ZSTD_CCtx_setParameter(m_strm, ZSTD_c_nbWorkers, workers)))
+			Console.Warning("GSDumpZstd: Multithreaded compression is unavailable.");
 
-		m_in_buff.reserve(_1mb);
+		m_in_buff.reserve(BLOCK_SIZE);
 		m_out_buff.resize(_1mb);
 
+		m_thread = std::thread(&GSDumpZst::CompressThreadEntryPoint, this);
+
 		AddHeader(serial, crc, screenshot_width, screenshot_height, screenshot_pixels, fd, regs);
 	}
 
 	GSDumpZst::~GSDumpZst()
 	{
 		// Finish the stream
-		Compress(ZSTD_e_end);
+		Submit(true);
+		{
+			std::unique_lock lock(m_mutex);
+			m_shutdown = true;
+			m_work_cv.notify_one();
+		}
+		m_thread.join();
+
+		// Each keyframe ended a frame, in order, and the last frame was ended by the final block.
+		for (size_t i = 0; i + 1 < m_frame_offsets.size(); i++)
+			SetKeyframeFileOffset(i, m_frame_offsets[i]);
+
+		// The index goes in a skippable frame, which decoders pass over.
+		const std::vector<u8> index = GetKeyframeIndex();
+		if (!index.empty())
+		{
+			const u32 skippable_header[2] = {ZSTD_MAGIC_SKIPPABLE_START, static_cast<u32>(index.size())};
+			Write(skippable_header, sizeof(skippable_header));
+			Write(index.data(), index.size());
+		}
 
 		ZSTD_freeCStream(m_strm);
+
+		Console.WriteLnFmt("GSDumpZstd: {:.2f} MB written, {:.2f} MB peak queued, {} stalls ({:.2f} ms)",
+			static_cast<double>(m_raw_size) / _1mb, static_cast<double>(m_peak_queued_size) / _1mb, m_stalls,
+			Common::Timer::ConvertValueToMilliseconds(m_stall_time));
+	}
+
+	std::optional<u64> GSDumpZst::EndFrame()
+	{
+		// The frame is written later, its offset is filled in on close.
+		Submit(true);
+		return std::nullopt;
 	}
 
 	void GSDumpZst::AppendRawData(const void* data, size_t size)
@@ -370,16 +538,75 @@ namespace
 
 	void GSDumpZst::MayFlush()
 	{
-		if (m_in_buff.size() >= _1mb)
-			Compress(ZSTD_e_continue);
+		if (m_in_buff.size() >= BLOCK_SIZE)
+			Submit(false);
 	}
 
-	void GSDumpZst::Compress(ZSTD_EndDirective action)
+	void GSDumpZst::Submit(bool end_frame)
 	{
-		if (m_in_buff.empty())
+		// Ending a frame may still have to flush data which was buffered by earlier blocks.
+		if (m_in_buff.empty() && !end_frame)
 			return;
 
-		ZSTD_inBuffer inbuf = {m_in_buff.data(), m_in_buff.size(), 0};
+		const size_t size = m_in_buff.size();
+		std::vector<u8> next_buff;
+
+		std::unique_lock lock(m_mutex);
+		if (m_queued_size > 0 && (m_queued_size + size) > MAX_QUEUED_SIZE)
+		{
+			const Common::Timer::Value start = Common::Timer::GetCurrentValue();
+			m_done_cv.wait(lock, [this, size]() { return m_queued_size == 0 || (m_queued_size + size) <= MAX_QUEUED_SIZE; });
+			m_stall_time += Common::Timer::GetCurrentValue() - start;
+			m_stalls++;
+		}
+
+		m_queue.push_back(Block{std::move(m_in_buff), end_frame});
+		m_queued_size += size;
+		m_raw_size += size;
+		m_peak_queued_size = std::max(m_peak_queued_size, m_queued_size);
+		if (!m_free_buffers.empty())
+		{
+			next_buff = std::move(m_free_buffers.back());
+			m_free_buffers.pop_back();
+		}
+		m_work_cv.notify_one();
+		lock.unlock();
+
+		m_in_buff = std::move(next_buff);
+		m_in_buff.clear();
+		m_in_buff.reserve(BLOCK_SIZE);
+	}
+
+	void GSDumpZst::CompressThreadEntryPoint()
+	{
+		Threading::SetNameOfCurrentThread("GS Dump Compressor");
+
+		std::unique_lock lock(m_mutex);
+		for (;;)
+		{
+			m_work_cv.wait(lock, [this]() { return m_shutdown || !m_queue.empty(); });
+			if (m_queue.empty())
+				break;
+
+			Block block = std::move(m_queue.front());
+			m_queue.pop_front();
+			lock.unlock();
+
+			Compress(block.data, block.end_frame ? ZSTD_e_end : ZSTD_e_continue);
+			if (block.end_frame)
+				m_frame_offsets.push_back(GetFileSize());
+
+			lock.lock();
+			m_queued_size -= block.data.size();
+			block.data.clear();
+			m_free_buffers.push_back(std::move(block.data));
+			m_done_cv.notify_one();
+		}
+	}
+
+	void GSDumpZst::Compress(const std::vector<u8>& data, ZSTD_EndDirective action)
+	{
+		ZSTD_inBuffer inbuf = {data.data(), data.size(), 0};
 
 		for (;;)
 		{
@@ -411,17 +638,15 @@ namespace
 					break;
 			}
 		}
-
-		m_in_buff.clear();
 	}
 } // namespace
 
 std::unique_ptr<GSDumpBase> GSDumpBase::CreateZstDump(
 	const std::string& fn, const std::string& serial, u32 crc,
 	u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
-	const freezeData& fd, const GSPrivRegSet* regs)
+	const freezeData& fd, const GSPrivRegSet* regs, int level)
 {
 	return std::make_unique<GSDumpZst>(fn, serial, crc,
 		screenshot_width, screenshot_height, screenshot_pixels,
-		fd, regs);
+		fd, regs, level);
 }
@@ -24,6 +24,17 @@ ReadFIFO2 data (id == 2)
 Regs data (id == 3)
 - [PMODE/0x2000]
 
+Keyframe data (id == 4), written every GSDumpBase::KEYFRAME_INTERVAL frames when GSDumpKeyframes is enabled.
+Builds which predate keyframes can't replay dumps containing them.
+- [4/1] [size/4] [GSDumpKeyframe] [state data/state_size] [PMODE/0x2000]
+
+Keyframe index (id == 5), the last packet of the dump
+- [5/1] [size/4] [GSDumpKeyframeIndexEntry * count] [GSDumpKeyframeIndexFooter]
+
+Zstandard dumps end a frame before each keyframe, and store the index payload in a skippable frame instead
+of a packet. Xz dumps are split into GSDUMP_XZ_BLOCK_SIZE blocks. Either way, the footer is the last thing
+in the file (or xz stream), and readers can start decompressing at any keyframe.
+
 */
 
 #pragma pack(push, 4)
@@ -39,24 +50,69 @@ struct GSDumpHeader
 	u32 screenshot_offset;
 	u32 screenshot_size;
 };
+
+struct GSDumpKeyframe
+{
+	u32 frame; ///< VSyncs since the start of the dump.
+	u32 state_size;
+	u64 draw; ///< Draws since the start of the dump.
+};
+
+struct GSDumpKeyframeIndexEntry
+{
+	u32 frame;
+	u32 reserved;
+	u64 draw;
+	u64 stream_offset; ///< Offset of the keyframe packet in the uncompressed stream.
+	u64 file_offset; ///< Offset of the compressed frame starting with the keyframe, for zstd dumps.
+};
+
+struct GSDumpKeyframeIndexFooter
+{
+	u32 count;
+	u32 version;
+	u32 magic;
+};
 #pragma pack(pop)
 
+static constexpr u32 GSDUMP_KEYFRAME_INDEX_MAGIC = 0x464B5347; // GSKF
+static constexpr u32 GSDUMP_KEYFRAME_INDEX_VERSION = 1;
+static constexpr u32 GSDUMP_XZ_BLOCK_SIZE = 16 * 1024 * 1024;
+
 class GSDumpBase
 {
 	FILE* m_gs;
 	std::string m_filename;
 	int m_frames;
 	int m_extra_frames;
+	int m_last_keyframe = 0;
+
+	u64 m_stream_size = 0;
+	u64 m_file_size = 0;
+	std::vector<GSDumpKeyframeIndexEntry> m_keyframes;
+
+	void Append(const void* data, size_t size);
+	void Append(u8 c);
 
 protected:
 	void AddHeader(const std::string& serial, u32 crc,
 		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
 		const freezeData& fd, const GSPrivRegSet* regs);
 	void Write(const void* data, size_t size);
+	__fi u64 GetFileSize() const { return m_file_size; }
+
+	/// Returns the index entries followed by the footer, or nothing if no keyframes were written.
+	std::vector<u8> GetKeyframeIndex() const;
+	void SetKeyframeFileOffset(size_t index, u64 file_offset);
+	void AppendKeyframeIndex();
 
 	virtual void AppendRawData(const void* data, size_t size) = 0;
 	virtual void AppendRawData(u8 c) = 0;
 
+	/// Terminates the current compressed frame, so decompression can start at the data which follows.
+	/// Returns the file offset of the next frame, or nothing if it isn't known until the dump is closed.
+	virtual std::optional<u64> EndFrame() { return m_file_size; }
+
 public:
 	GSDumpBase(std::string fn);
 	virtual ~GSDumpBase();
@@ -67,16 +123,22 @@ public:
 	void Transfer(int index, const u8* mem, size_t size);
 	bool VSync(int field, bool last, const GSPrivRegSet* regs);
 
+	static constexpr int KEYFRAME_INTERVAL = 600;
+
+	__fi bool NeedsKeyframe() const { return m_gs && (m_frames - m_last_keyframe) >= KEYFRAME_INTERVAL; }
+	void Keyframe(u64 draw, const freezeData& fd, const GSPrivRegSet* regs);
+
 	static std::unique_ptr<GSDumpBase> CreateUncompressedDump(
 		const std::string& fn, const std::string& serial, u32 crc,
 		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
 		const freezeData& fd, const GSPrivRegSet* regs);
+	/// A level of 0 uses the compressor's default.
 	static std::unique_ptr<GSDumpBase> CreateXzDump(
 		const std::string& fn, const std::string& serial, u32 crc,
 		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
-		const freezeData& fd, const GSPrivRegSet* regs);
+		const freezeData& fd, const GSPrivRegSet* regs, int level = 0);
 	static std::unique_ptr<GSDumpBase> CreateZstDump(
 		const std::string& fn, const std::string& serial, u32 crc,
 		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
-		const freezeData& fd, const GSPrivRegSet* regs);
+		const freezeData& fd, const GSPrivRegSet* regs, int level = 0);
 };
@@ -6,12 +6,57 @@
 #include "GS.h"
 #include "common/boost_spsc_queue.hpp"
 #include "common/Assertions.h"
+#include "common/HostSys.h"
 #include "common/Threading.h"
+#include <algorithm>
 #include <condition_variable>
 #include <functional>
 #include <mutex>
 #include <thread>
 
+/// Decides how long a waiter spins before falling back to sleeping on the semaphore.
+/// In adaptive mode the budget follows the waits actually seen: a sleep that ended sooner than the longest
+/// allowed spin means spinning would have caught the work, so the budget grows to cover it, while waits
+/// longer than that shrink it back down, so idle workers stop burning a core.
+class GSSpinBudget
+{
+	static constexpr u32 MIN_SPIN_NS = 2 * 1000;
+	static constexpr u32 MAX_SPIN_NS = 200 * 1000;
+
+	GSSWWorkerWait m_mode;
+	u32 m_spin_ns;
+
+public:
+	GSSpinBudget(GSSWWorkerWait mode)
+		: m_mode(mode)
+		, m_spin_ns((mode == GSSWWorkerWait::Sleep) ? 0 : SPIN_TIME_NS)
+	{
+	}
+
+	u32 Get() const { return m_spin_ns; }
+
+	void Update(u32 spun_ns, u64 slept_ns)
+	{
+		if (m_mode != GSSWWorkerWait::Adaptive)
+			return;
+
+		if (slept_ns == 0)
+		{
+			// Caught the work while spinning, trim the budget slowly if it was much longer than needed.
+			if (spun_ns < m_spin_ns / 4)
+				m_spin_ns = std::max(MIN_SPIN_NS, m_spin_ns - m_spin_ns / 8);
+		}
+		else
+		{
+			const u64 waited_ns = spun_ns + slept_ns;
+			if (waited_ns < MAX_SPIN_NS)
+				m_spin_ns = std::min(std::max(static_cast<u32>(waited_ns * 2), m_spin_ns), MAX_SPIN_NS);
+			else
+				m_spin_ns = std::max(MIN_SPIN_NS, m_spin_ns / 2);
+		}
+	}
+};
+
 template <class T, int CAPACITY>
 class GSJobQueue final
 {
@@ -25,6 +70,19 @@ private:
 
 	Threading::WorkSema m_sema;
 
+	GSSpinBudget m_work_spin;
+	GSSpinBudget m_empty_spin;
+	Threading::WorkSemaWaitTimes m_work_wait;
+	Threading::WorkSemaWaitTimes m_empty_wait;
+
+	static void AddWaitTimes(Threading::WorkSemaWaitTimes& times, u32 spun_ns, u64 slept_ns)
+	{
+		// Only one thread ever writes each set of totals, so there's no need for an atomic add.
+		times.spin_ns.store(times.spin_ns.load(std::memory_order_relaxed) + spun_ns, std::memory_order_relaxed);
+		if (slept_ns != 0)
+			times.sleep_ns.store(times.sleep_ns.load(std::memory_order_relaxed) + slept_ns, std::memory_order_relaxed);
+	}
+
 	void ThreadProc()
 	{
 		if (m_startup)
@@ -32,7 +90,11 @@ private:
 
 		while (true)
 		{
-			m_sema.WaitForWorkWithSpin();
+			u32 spun_ns;
+			u64 slept_ns;
+			m_sema.WaitForWorkWithSpin(m_work_spin.Get(), &spun_ns, &slept_ns);
+			m_work_spin.Update(spun_ns, slept_ns);
+			AddWaitTimes(m_work_wait, spun_ns, slept_ns);
 			if (m_exit)
 				break;
 			while (m_queue.consume_one(*this))
@@ -44,11 +106,14 @@ private:
 	}
 
 public:
-	GSJobQueue(std::function<void()> startup, std::function<void(T&)> func, std::function<void()> shutdown)
+	GSJobQueue(std::function<void()> startup, std::function<void(T&)> func, std::function<void()> shutdown,
+		GSSWWorkerWait wait = GSSWWorkerWait::Spin)
 		: m_startup(std::move(startup))
 		, m_func(std::move(func))
 		, m_shutdown(std::move(shutdown))
 		, m_exit(false)
+		, m_work_spin(wait)
+		, m_empty_spin(wait)
 	{
 		m_thread = std::thread(&GSJobQueue::ThreadProc, this);
 	}
@@ -74,10 +139,20 @@ public:
 
 	void Wait()
 	{
-		m_sema.WaitForEmptyWithSpin();
+		u32 spun_ns;
+		u64 slept_ns;
+		m_sema.WaitForEmptyWithSpin(m_empty_spin.Get(), &spun_ns, &slept_ns);
+		m_empty_spin.Update(spun_ns, slept_ns);
+		AddWaitTimes(m_empty_wait, spun_ns, slept_ns);
 		pxAssert(IsEmpty());
 	}
 
+	/// Time the worker spent waiting for work to be pushed.
+	const Threading::WorkSemaWaitTimes& GetWorkWaitTimes() const { return m_work_wait; }
+
+	/// Time Wait() spent waiting for the worker to drain the queue.
+	const Threading::WorkSemaWaitTimes& GetEmptyWaitTimes() const { return m_empty_wait; }
+
 	void operator()(T& item)
 	{
 		m_func(item);
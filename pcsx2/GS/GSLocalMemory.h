@@ -508,6 +508,11 @@ protected:
 	std::unordered_map<u32, GSPixelOffset4*> m_po4map;
 	std::unordered_map<u64, std::vector<GSVector2i>*> m_p2tmap;
 
+	/// Write generation of each page. Every write to local memory stamps the pages it touched with a new
+	/// generation, so caches built from local memory can tell whether any of their pages changed since.
+	std::array<u64, GS_MAX_PAGES> m_page_generation = {};
+	u64 m_write_generation = 0;
+
 public:
 	GSLocalMemory();
 	~GSLocalMemory();
@@ -531,6 +536,35 @@ public:
 	static u32 GetUnwrappedEndBlockAddress(u32 bp, u32 bw, u32 psm, GSVector4i rect);
 	static GSVector4i GetRectForPageOffset(u32 base_bp, u32 offset_bp, u32 bw, u32 psm);
 
+	// write generations
+
+	/// Generation of the most recent write, anything stamped after this point compares greater.
+	__forceinline u64 GetWriteGeneration() const { return m_write_generation; }
+
+	void MarkPagesWritten(const GSOffset::PageLooper& pages)
+	{
+		const u64 generation = ++m_write_generation;
+		pages.loopPages([this, generation](u32 page) { m_page_generation[page] = generation; });
+	}
+
+	void MarkPagesWritten(u32 bp, u32 bw, u32 psm, const GSVector4i& rect)
+	{
+		MarkPagesWritten(GetOffset(bp, bw, psm).pageLooperForRect(rect));
+	}
+
+	void MarkAllPagesWritten()
+	{
+		m_page_generation.fill(++m_write_generation);
+	}
+
+	/// Returns the generation of the most recent write to any of the pages.
+	u64 GetPagesGeneration(const GSOffset::PageLooper& pages) const
+	{
+		u64 generation = 0;
+		pages.loopPages([this, &generation](u32 page) { generation = std::max(generation, m_page_generation[page]); });
+		return generation;
+	}
+
 	// address
 
 	static u32 BlockNumber32(int x, int y, u32 bp, u32 bw)
@@ -20,6 +20,12 @@ class CURRENT_ISA::GSLocalMemoryFunctions
 	template <int psm, int bsx, int bsy, int trbpp>
 	static void WriteImageTopBottom(GSLocalMemory& mem, int l, int r, int y, int h, const u8* src, int srcpitch, const GIFRegBITBLTBUF& BITBLTBUF);
 
+	template <int psm, int trbpp, int alignment>
+	static void WriteImagePages(GSLocalMemory& mem, int l, int r, int y, int h, const u8* src, int srcpitch, const GIFRegBITBLTBUF& BITBLTBUF);
+
+	template <int psm, int trbpp>
+	static int WriteImagePages(GSLocalMemory& mem, int l, int r, int y, int h, const u8* src, int srcpitch, const GIFRegBITBLTBUF& BITBLTBUF);
+
 	template <int psm, int bsx, int bsy, int trbpp>
 	static void WriteImage(GSLocalMemory& mem, int& tx, int& ty, const u8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG);
 
@@ -447,6 +453,78 @@ void GSLocalMemoryFunctions::WriteImageTopBottom(GSLocalMemory& mem, int l, int
 	}
 }
 
+// Transfers smaller than this are likely to still be in the cache when they get used, so they aren't streamed.
+static constexpr int STREAM_MIN_BYTES = 128 * 1024;
+
+template <int psm, int trbpp, int alignment>
+void GSLocalMemoryFunctions::WriteImagePages(GSLocalMemory& mem, int l, int r, int y, int h, const u8* src, int srcpitch, const GIFRegBITBLTBUF& BITBLTBUF)
+{
+	u32 bp = BITBLTBUF.DBP;
+	u32 bw = BITBLTBUF.DBW;
+
+	const GSVector2i pgs = GSLocalMemory::m_psm[psm].pgs;
+
+	for (int offset = srcpitch * pgs.y; h > 0; h -= pgs.y, y += pgs.y, src += offset)
+	{
+		for (int x = l; x < r; x += pgs.x)
+		{
+			switch (psm)
+			{
+				case PSMCT32: GSBlock::WritePage32<alignment>(mem.BlockPtr32(x, y, bp, bw), &src[x * 4], srcpitch, blockTable32); break;
+				case PSMCT16: GSBlock::WritePage16<alignment>(mem.BlockPtr16(x, y, bp, bw), &src[x * 2], srcpitch, blockTable16); break;
+				case PSMCT16S: GSBlock::WritePage16<alignment>(mem.BlockPtr16S(x, y, bp, bw), &src[x * 2], srcpitch, blockTable16S); break;
+				case PSMT8: GSBlock::WritePage8<alignment>(mem.BlockPtr8(x, y, bp, bw), &src[x], srcpitch, blockTable8); break;
+				case PSMT4: GSBlock::WritePage4<alignment>(mem.BlockPtr4(x, y, bp, bw), &src[x >> 1], srcpitch, blockTable4); break;
+				default: ASSUME(0);
+			}
+		}
+	}
+}
+
+/// Writes the rows of a block aligned transfer which cover whole pages, and returns how many that was.
+template <int psm, int trbpp>
+int GSLocalMemoryFunctions::WriteImagePages(GSLocalMemory& mem, int l, int r, int y, int h, const u8* src, int srcpitch, const GIFRegBITBLTBUF& BITBLTBUF)
+{
+	if constexpr (psm != PSMCT32 && psm != PSMCT16 && psm != PSMCT16S && psm != PSMT8 && psm != PSMT4)
+	{
+		return 0;
+	}
+	else
+	{
+		const GSVector2i pgs = GSLocalMemory::m_psm[psm].pgs;
+
+		const int h2 = h & ~(pgs.y - 1);
+		if (h2 == 0 || srcpitch * h2 < STREAM_MIN_BYTES)
+			return 0;
+
+		if ((BITBLTBUF.DBP & (GS_BLOCKS_PER_PAGE - 1)) != 0 || ((l | r) & (pgs.x - 1)) != 0 || (y & (pgs.y - 1)) != 0)
+			return 0;
+
+#if FAST_UNALIGNED
+		WriteImagePages<psm, trbpp, 0>(mem, l, r, y, h2, src, srcpitch, BITBLTBUF);
+#else
+		size_t addr = (size_t)&src[l * trbpp >> 3];
+
+		if ((addr & 31) == 0 && (srcpitch & 31) == 0)
+		{
+			WriteImagePages<psm, trbpp, 32>(mem, l, r, y, h2, src, srcpitch, BITBLTBUF);
+		}
+		else if ((addr & 15) == 0 && (srcpitch & 15) == 0)
+		{
+			WriteImagePages<psm, trbpp, 16>(mem, l, r, y, h2, src, srcpitch, BITBLTBUF);
+		}
+		else
+		{
+			WriteImagePages<psm, trbpp, 0>(mem, l, r, y, h2, src, srcpitch, BITBLTBUF);
+		}
+#endif
+
+		GSBlock::StreamFence();
+
+		return h2;
+	}
+}
+
 template <int psm, int bsx, int bsy, int trbpp>
 void GSLocalMemoryFunctions::WriteImage(GSLocalMemory& mem, int& tx, int& ty, const u8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG)
 {
@@ -532,6 +610,16 @@ void GSLocalMemoryFunctions::WriteImage(GSLocalMemory& mem, int& tx, int& ty, co
 				}
 			}
 
+			// whole pages, streamed straight out to local memory
+
+			{
+				int h2 = WriteImagePages<psm, trbpp>(mem, la, ra, ty, h, s, srcpitch, BITBLTBUF);
+
+				s += srcpitch * h2;
+				ty += h2;
+				h -= h2;
+			}
+
 			// horizontally and vertically aligned part
 
 			{
@@ -8,6 +8,7 @@
 #include "common/BitUtils.h"
 #include "common/Error.h"
 #include "common/HeapArray.h"
+#include "common/Threading.h"
 
 #include "GS/GSDump.h"
 #include "GS/GSLzma.h"
@@ -71,6 +72,11 @@ bool GSDumpFile::GetPreviewImageFromDump(const char* filename, u32* width, u32*
 }
 
 bool GSDumpFile::ReadFile(Error* error)
+{
+	return ReadHeader(error) && ReadPackets(error);
+}
+
+bool GSDumpFile::ReadHeader(Error* error)
 {
 	u32 ss;
 	if (Read(&m_crc, sizeof(m_crc)) != sizeof(m_crc) || Read(&ss, sizeof(ss)) != sizeof(ss))
@@ -128,6 +134,11 @@ bool GSDumpFile::ReadFile(Error* error)
 		return false;
 	}
 
+	return true;
+}
+
+bool GSDumpFile::ReadPackets(Error* error)
+{
 	// read all the packet data in
 	// TODO: make this suck less by getting the full/extracted size and preallocating
 	for (;;)
@@ -200,6 +211,10 @@ bool GSDumpFile::ReadFile(Error* error)
 			case GSType::Registers:
 				packet.length = 8192;
 				break;
+			case GSType::Keyframe:
+			case GSType::KeyframeIndex:
+				GET_WORD(&packet.length);
+				break;
 			default:
 				Error::SetStringFmt(error,
 					TRANSLATE_FS("GSDumpFile", "Unknown packet type {}"), static_cast<u32>(packet.id));
@@ -232,6 +247,239 @@ bool GSDumpFile::ReadFile(Error* error)
 	return true;
 }
 
+bool GSDumpFile::ReadFromEnd(void* ptr, size_t size, u64 offset_from_end)
+{
+	const s64 pos = FileSystem::FTell64(m_fp.get());
+	const s64 file_size = FileSystem::FSize64(m_fp.get());
+	const u64 end_offset = size + offset_from_end;
+	if (pos < 0 || file_size < 0 || end_offset > static_cast<u64>(file_size))
+		return false;
+
+	const bool ret = (FileSystem::FSeek64(m_fp.get(), file_size - static_cast<s64>(end_offset), SEEK_SET) == 0 &&
+					  std::fread(ptr, size, 1, m_fp.get()) == 1);
+	return (FileSystem::FSeek64(m_fp.get(), pos, SEEK_SET) == 0) && ret;
+}
+
+bool GSDumpFile::ReadKeyframeIndex()
+{
+	m_keyframes.clear();
+
+	GSDumpKeyframeIndexFooter footer;
+	if (!ReadFromEnd(&footer, sizeof(footer), 0) || footer.magic != GSDUMP_KEYFRAME_INDEX_MAGIC ||
+		footer.version != GSDUMP_KEYFRAME_INDEX_VERSION || footer.count == 0)
+	{
+		return false;
+	}
+
+	m_keyframes.resize(footer.count);
+	if (!ReadFromEnd(m_keyframes.data(), footer.count * sizeof(GSDumpKeyframeIndexEntry), sizeof(footer)))
+	{
+		Console.Error("(GSDump) Failed to read keyframe index of %u entries", footer.count);
+		m_keyframes.clear();
+		return false;
+	}
+
+	return true;
+}
+
+const GSDumpKeyframeIndexEntry* GSDumpFile::FindKeyframe(u32 frame, u64 draw) const
+{
+	for (auto it = m_keyframes.rbegin(); it != m_keyframes.rend(); ++it)
+	{
+		if (it->frame <= frame && it->draw <= draw)
+			return &*it;
+	}
+
+	return nullptr;
+}
+
+bool GSDumpFile::SeekToKeyframe(const GSDumpKeyframeIndexEntry& keyframe, Error* error)
+{
+	pxAssert(!IsStreaming());
+	if (!Seek(keyframe.stream_offset, keyframe.file_offset))
+	{
+		Error::SetStringFmt(error, TRANSLATE_FS("GSDumpFile", "Failed to seek to keyframe at frame {}."), keyframe.frame);
+		return false;
+	}
+
+	return true;
+}
+
+void GSDumpFile::StartStreaming(size_t max_buffered)
+{
+	pxAssert(!m_stream_thread.joinable());
+
+	m_stream_max_buffered = std::max(max_buffered, STREAM_CHUNK_SIZE);
+	m_stream_buffered = 0;
+	m_stream_done = false;
+	m_stream_stop = false;
+	m_stream_current_packet = 0;
+	m_stream_thread = std::thread(&GSDumpFile::StreamThreadEntryPoint, this);
+}
+
+void GSDumpFile::StopStreaming()
+{
+	if (!m_stream_thread.joinable())
+		return;
+
+	{
+		std::unique_lock lock(m_stream_mutex);
+		m_stream_stop = true;
+	}
+	m_stream_cv.notify_all();
+	m_stream_thread.join();
+
+	m_stream_ready.clear();
+	m_stream_free.clear();
+	m_stream_current.reset();
+	m_stream_buffered = 0;
+}
+
+const GSDumpFile::GSData* GSDumpFile::GetNextPacket()
+{
+	if (m_stream_current && m_stream_current_packet < m_stream_current->packets.size())
+		return &m_stream_current->packets[m_stream_current_packet++];
+
+	std::unique_lock lock(m_stream_mutex);
+
+	// Everything in the current chunk has been handed out, give it back to the reader for reuse.
+	if (m_stream_current)
+	{
+		m_stream_free.push_back(std::move(m_stream_current));
+		m_stream_cv.notify_all();
+	}
+
+	m_stream_cv.wait(lock, [this]() { return !m_stream_ready.empty() || m_stream_done; });
+	if (m_stream_ready.empty())
+		return nullptr;
+
+	m_stream_current = std::move(m_stream_ready.front());
+	m_stream_ready.pop_front();
+	m_stream_buffered -= m_stream_current->data.size();
+	m_stream_cv.notify_all();
+	lock.unlock();
+
+	m_stream_current_packet = 1;
+	return &m_stream_current->packets[0];
+}
+
+std::unique_ptr<GSDumpFile::PacketChunk> GSDumpFile::GetFreeChunk(size_t min_capacity)
+{
+	std::unique_ptr<PacketChunk> chunk;
+	{
+		std::unique_lock lock(m_stream_mutex);
+		if (!m_stream_free.empty())
+		{
+			chunk = std::move(m_stream_free.back());
+			m_stream_free.pop_back();
+		}
+	}
+
+	if (!chunk)
+		chunk = std::make_unique<PacketChunk>();
+
+	// Oversized packets get a chunk of their own.
+	const size_t capacity = std::max(min_capacity, STREAM_CHUNK_SIZE);
+	if (chunk->data.size() < capacity)
+		chunk->data.resize(capacity);
+
+	chunk->used = 0;
+	chunk->packets.clear();
+	return chunk;
+}
+
+bool GSDumpFile::PublishChunk(std::unique_ptr<PacketChunk> chunk)
+{
+	std::unique_lock lock(m_stream_mutex);
+	m_stream_cv.wait(lock, [this]() { return m_stream_buffered < m_stream_max_buffered || m_stream_stop; });
+	if (m_stream_stop)
+		return false;
+
+	m_stream_buffered += chunk->data.size();
+	m_stream_ready.push_back(std::move(chunk));
+	m_stream_cv.notify_all();
+	return true;
+}
+
+void GSDumpFile::StreamThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("GS Dump Reader");
+
+	std::unique_ptr<PacketChunk> chunk = GetFreeChunk(0);
+	for (;;)
+	{
+		GSData packet = {};
+		packet.path = GSTransferPath::Dummy;
+		if (Read(&packet.id, sizeof(packet.id)) != sizeof(packet.id))
+			break;
+
+		bool valid = true;
+		switch (packet.id)
+		{
+			case GSType::Transfer:
+			case GSType::Keyframe:
+			case GSType::KeyframeIndex:
+			{
+				u32 length;
+				valid = ((packet.id != GSType::Transfer || Read(&packet.path, sizeof(packet.path)) == sizeof(packet.path)) &&
+						 Read(&length, sizeof(length)) == sizeof(length));
+				packet.length = length;
+			}
+			break;
+			case GSType::VSync:
+				packet.length = 1;
+				break;
+			case GSType::ReadFIFO2:
+				packet.length = 4;
+				break;
+			case GSType::Registers:
+				packet.length = 8192;
+				break;
+			default:
+				Console.Error("(GSDump) Unknown packet type %u", static_cast<u32>(packet.id));
+				valid = false;
+				break;
+		}
+		if (!valid)
+			break;
+
+		if (packet.length > 0)
+		{
+			if ((chunk->data.size() - chunk->used) < packet.length)
+			{
+				if (!chunk->packets.empty() && !PublishChunk(std::move(chunk)))
+					return;
+
+				chunk = GetFreeChunk(packet.length);
+			}
+
+			u8* data = chunk->data.data() + chunk->used;
+			const size_t read = Read(data, packet.length);
+			if (read != packet.length)
+			{
+				// Same as ReadPackets(), drop a truncated last packet.
+				Console.Error("(GSDump) Dropping last packet of %u bytes (we only have %u bytes)",
+					static_cast<u32>(packet.length), static_cast<u32>(read));
+				break;
+			}
+
+			packet.data = data;
+			chunk->used += packet.length;
+		}
+
+		chunk->packets.push_back(packet);
+	}
+
+	if (!chunk->packets.empty() && !PublishChunk(std::move(chunk)))
+		return;
+
+	{
+		std::unique_lock lock(m_stream_mutex);
+		m_stream_done = true;
+	}
+	m_stream_cv.notify_all();
+}
+
 /******************************************************************/
 
 static std::once_flag s_lzma_crc_table_init;
@@ -256,6 +504,8 @@ namespace
 		bool Open(FileSystem::ManagedCFilePtr fp, Error* error) override;
 		bool IsEof() override;
 		size_t Read(void* ptr, size_t size) override;
+		bool ReadFromEnd(void* ptr, size_t size, u64 offset_from_end) override;
+		bool Seek(u64 stream_offset, u64 file_offset) override;
 
 	private:
 		static constexpr size_t kInputBufSize = static_cast<size_t>(1) << 18;
@@ -270,6 +520,7 @@ namespace
 		};
 
 		bool DecompressNextBlock();
+		bool SeekStream(u64 offset);
 
 
 		std::vector<Block> m_blocks;
@@ -288,6 +539,7 @@ namespace
 
 	GSDumpLzma::~GSDumpLzma()
 	{
+		StopStreaming();
 		XzUnpacker_Free(&m_unpacker);
 	}
 
@@ -466,6 +718,41 @@ namespace
 		return size - remain;
 	}
 
+	bool GSDumpLzma::SeekStream(u64 offset)
+	{
+		// Blocks are in stream order, find the one containing the offset.
+		auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), offset,
+			[](u64 off, const Block& block) { return off < block.stream_offset; });
+		if (it == m_blocks.begin())
+			return false;
+
+		--it;
+		m_block_index = static_cast<size_t>(it - m_blocks.begin());
+		m_block_size = 0;
+		m_block_pos = 0;
+		if (!DecompressNextBlock())
+			return false;
+
+		m_block_pos = std::min<size_t>(static_cast<size_t>(offset - it->stream_offset), m_block_size);
+		return true;
+	}
+
+	bool GSDumpLzma::ReadFromEnd(void* ptr, size_t size, u64 offset_from_end)
+	{
+		// The index is at the end of the xz stream rather than the file.
+		if ((size + offset_from_end) > m_stream_size)
+			return false;
+
+		const u64 pos = (m_block_index > 0) ? (m_blocks[m_block_index - 1].stream_offset + m_block_pos) : 0;
+		const bool ret = (SeekStream(m_stream_size - size - offset_from_end) && Read(ptr, size) == size);
+		return SeekStream(pos) && ret;
+	}
+
+	bool GSDumpLzma::Seek(u64 stream_offset, u64 file_offset)
+	{
+		return SeekStream(stream_offset);
+	}
+
 	/******************************************************************/
 
 	class GSDumpDecompressZst final : public GSDumpFile
@@ -490,12 +777,15 @@ namespace
 		bool Open(FileSystem::ManagedCFilePtr fp, Error* error) override;
 		bool IsEof() override;
 		size_t Read(void* ptr, size_t size) override;
+		bool Seek(u64 stream_offset, u64 file_offset) override;
 	};
 
 	GSDumpDecompressZst::GSDumpDecompressZst() = default;
 
 	GSDumpDecompressZst::~GSDumpDecompressZst()
 	{
+		StopStreaming();
+
 		if (m_strm)
 			ZSTD_freeDStream(m_strm);
 
@@ -537,6 +827,10 @@ namespace
 				}
 			}
 
+			// Trailing frames which decode to nothing (e.g. the keyframe index) leave us with no output.
+			if (m_inbuf.pos == m_inbuf.size && std::feof(m_fp.get()))
+				break;
+
 			const size_t ret = ZSTD_decompressStream(m_strm, &outbuf, &m_inbuf);
 			if (ZSTD_isError(ret))
 			{
@@ -578,6 +872,20 @@ namespace
 		return off;
 	}
 
+	bool GSDumpDecompressZst::Seek(u64 stream_offset, u64 file_offset)
+	{
+		// Keyframes start a new zstd frame, so the decoder can be restarted there.
+		if (FileSystem::FSeek64(m_fp.get(), static_cast<s64>(file_offset), SEEK_SET) != 0)
+			return false;
+
+		ZSTD_initDStream(m_strm);
+		m_inbuf.pos = 0;
+		m_inbuf.size = 0;
+		m_avail = 0;
+		m_start = 0;
+		return true;
+	}
+
 	/******************************************************************/
 
 	class GSDumpRaw final : public GSDumpFile
@@ -589,11 +897,15 @@ namespace
 		bool Open(FileSystem::ManagedCFilePtr fp, Error* error) override;
 		bool IsEof() override;
 		size_t Read(void* ptr, size_t size) override;
+		bool Seek(u64 stream_offset, u64 file_offset) override;
 	};
 
 	GSDumpRaw::GSDumpRaw() = default;
 
-	GSDumpRaw::~GSDumpRaw() = default;
+	GSDumpRaw::~GSDumpRaw()
+	{
+		StopStreaming();
+	}
 
 	bool GSDumpRaw::Open(FileSystem::ManagedCFilePtr fp, Error* error)
 	{
@@ -616,6 +928,11 @@ namespace
 
 		return ret;
 	}
+
+	bool GSDumpRaw::Seek(u64 stream_offset, u64 file_offset)
+	{
+		return (FileSystem::FSeek64(m_fp.get(), static_cast<s64>(stream_offset), SEEK_SET) == 0);
+	}
 } // namespace
 
 /******************************************************************/
@@ -5,11 +5,18 @@
 
 #include "common/FileSystem.h"
 
+#include "common/HeapArray.h"
+
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 class Error;
+struct GSDumpKeyframeIndexEntry;
 
 #define GEN_REG_ENUM_CLASS_CONTENT(ClassName, EntryName, Value) \
 	EntryName = Value,
@@ -38,7 +45,9 @@ namespace GSDumpTypes
 	X(GSType, Transfer,  0) \
 	X(GSType, VSync,     1) \
 	X(GSType, ReadFIFO2, 2) \
-	X(GSType, Registers, 3)
+	X(GSType, Registers, 3) \
+	X(GSType, Keyframe,  4) \
+	X(GSType, KeyframeIndex, 5)
 		GEN_REG_ENUM_CLASS_AND_GETNAME(DEF_GSType, GSType, u8, "UnknownType")
 #undef DEF_GSType
 
@@ -295,8 +304,36 @@ public:
 	__fi const ByteArray& GetStateData() const { return m_state_data; }
 	__fi const GSDataArray& GetPackets() const { return m_dump_packets; }
 
+	/// Reads the whole dump into memory, equivalent to ReadHeader() followed by ReadPackets().
 	bool ReadFile(Error* error);
 
+	/// Reads the header, initial state and registers, leaving the file positioned at the first packet.
+	bool ReadHeader(Error* error);
+
+	/// Reads and splits every remaining packet into GetPackets().
+	bool ReadPackets(Error* error);
+
+	/// Instead of ReadPackets(), decompresses and splits packets on a worker thread, keeping at most
+	/// max_buffered bytes of packet data queued ahead of the consumer. Packets are pulled with GetNextPacket().
+	void StartStreaming(size_t max_buffered = DEFAULT_STREAM_BUFFER_SIZE);
+	void StopStreaming();
+	__fi bool IsStreaming() const { return m_stream_thread.joinable(); }
+
+	/// Loads the keyframe index from the end of the dump, without moving the read position.
+	/// Returns false if the dump has no keyframes.
+	bool ReadKeyframeIndex();
+	__fi const std::vector<GSDumpKeyframeIndexEntry>& GetKeyframes() const { return m_keyframes; }
+
+	/// Returns the last keyframe at or before both the frame and the draw, or nullptr.
+	const GSDumpKeyframeIndexEntry* FindKeyframe(u32 frame, u64 draw) const;
+
+	/// Moves the read position to a keyframe packet. Only valid before packets are read or streamed.
+	bool SeekToKeyframe(const GSDumpKeyframeIndexEntry& keyframe, Error* error);
+
+	/// Returns the next streamed packet, waiting for the reader if needed, or nullptr once the dump is exhausted.
+	/// The packet data is only valid until the following call.
+	const GSData* GetNextPacket();
+
 protected:
 	GSDumpFile();
 
@@ -304,6 +341,14 @@ protected:
 	virtual bool IsEof() = 0;
 	virtual size_t Read(void* ptr, size_t size) = 0;
 
+	/// Reads size bytes, ending offset_from_end bytes before the end of the dump, without moving the read position.
+	/// Reads from the end of the file by default.
+	virtual bool ReadFromEnd(void* ptr, size_t size, u64 offset_from_end);
+
+	/// Repositions reads at stream_offset in the uncompressed stream. file_offset is where decompression can
+	/// restart for that offset, for formats which can't seek within the compressed data themselves.
+	virtual bool Seek(u64 stream_offset, u64 file_offset) = 0;
+
 protected:
 	FileSystem::ManagedCFilePtr m_fp;
 
@@ -316,6 +361,36 @@ private:
 	std::vector<u8> m_packet_data;
 
 	GSDataArray m_dump_packets;
+
+	std::vector<GSDumpKeyframeIndexEntry> m_keyframes;
+
+	static constexpr size_t STREAM_CHUNK_SIZE = 4 * _1mb;
+	static constexpr size_t DEFAULT_STREAM_BUFFER_SIZE = 64 * _1mb;
+
+	struct PacketChunk
+	{
+		DynamicHeapArray<u8, 64> data;
+		size_t used = 0;
+		GSDataArray packets;
+	};
+
+	std::unique_ptr<PacketChunk> GetFreeChunk(size_t min_capacity);
+	bool PublishChunk(std::unique_ptr<PacketChunk> chunk);
+	void StreamThreadEntryPoint();
+
+	std::thread m_stream_thread;
+	std::mutex m_stream_mutex;
+	std::condition_variable m_stream_cv;
+	std::deque<std::unique_ptr<PacketChunk>> m_stream_ready;
+	std::vector<std::unique_ptr<PacketChunk>> m_stream_free;
+	size_t m_stream_buffered = 0;
+	size_t m_stream_max_buffered = 0;
+	bool m_stream_done = false;
+	bool m_stream_stop = false;
+
+	// Only touched by the consumer.
+	std::unique_ptr<PacketChunk> m_stream_current;
+	size_t m_stream_current_packet = 0;
 };
 
 // Initializes CRC tables used by LZMA SDK.
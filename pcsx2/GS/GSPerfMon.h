@@ -23,6 +23,8 @@ public:
 		SyncPoint,
 		Barriers,
 		RenderPasses,
+		TargetLookups,
+		TargetsVisited,
 		CounterLast,
 
 		// Reused counters for HW.
@@ -157,6 +157,9 @@ void GSState::Reset(bool hardware_reset)
 	m_env.Reset();
 	m_mem.m_clut.Reset();
 
+	// Local memory survives a reset, but anything hashed before it shouldn't be trusted afterwards.
+	m_mem.MarkAllPagesWritten();
+
 	PRIM = &m_env.PRIM;
 
 	UpdateContext();
@@ -1924,6 +1927,7 @@ void GSState::FlushWrite()
 	}
 
 	InvalidateVideoMem(m_env.BITBLTBUF, r);
+	m_mem.MarkPagesWritten(m_env.BITBLTBUF.DBP, m_env.BITBLTBUF.DBW, m_env.BITBLTBUF.DPSM, r);
 
 	const GSLocalMemory::writeImage wi = GSLocalMemory::m_psm[m_env.BITBLTBUF.DPSM].wi;
 
@@ -2147,8 +2151,18 @@ void GSState::FlushPrim()
 		}
 
 		if (!skip_draw)
+		{
 			Draw();
 
+			// The draw rect is inclusive of the last pixel, widen it by one so partially covered pages get stamped too.
+			const GSVector4i written_rect = temp_draw_rect.add32(GSVector4i(0, 0, 1, 1)).rintersect(m_context->scissor.in);
+			const u32 fmsk = GSLocalMemory::m_psm[m_context->FRAME.PSM].fmsk;
+			if ((m_context->FRAME.FBMSK & fmsk) != fmsk)
+				m_mem.MarkPagesWritten(m_context->FRAME.Block(), m_context->FRAME.FBW, m_context->FRAME.PSM, written_rect);
+			if (!m_context->ZBUF.ZMSK)
+				m_mem.MarkPagesWritten(m_context->ZBUF.Block(), m_context->FRAME.FBW, m_context->ZBUF.PSM, written_rect);
+		}
+
 		g_perfmon.Put(GSPerfMon::Draw, 1);
 		g_perfmon.Put(GSPerfMon::Prim, m_index.tail / GSUtil::GetVertexCount(PRIM->PRIM));
 
@@ -2414,6 +2428,7 @@ void GSState::Write(const u8* mem, int len)
 		{
 			// received all data in one piece, no need to buffer it
 			InvalidateVideoMem(blit, r);
+			m_mem.MarkPagesWritten(blit.DBP, blit.DBW, blit.DPSM, r);
 
 			psm.wi(m_mem, m_tr.x, m_tr.y, mem, m_tr.total, blit, m_tr.m_pos, m_tr.m_reg);
 
@@ -2542,6 +2557,7 @@ void GSState::Move()
 
 	InvalidateLocalMem(m_env.BITBLTBUF, GSVector4i(sx, sy, sx + w, sy + h));
 	InvalidateVideoMem(m_env.BITBLTBUF, GSVector4i(dx, dy, dx + w, dy + h));
+	m_mem.MarkPagesWritten(m_env.BITBLTBUF.DBP, m_env.BITBLTBUF.DBW, m_env.BITBLTBUF.DPSM, GSVector4i(dx, dy, dx + w, dy + h));
 	const bool overlaps = m_env.BITBLTBUF.SBP == m_env.BITBLTBUF.DBP;
 	const bool intersect = overlaps && !(GSVector4i(sx, sy, sx + w, sy + h).rintersect(GSVector4i(dx, dy, dx + w, dy + h)).rempty());
 
@@ -3218,6 +3234,7 @@ int GSState::Defrost(const freezeData* fd)
 	}
 
 	ReadState(m_mem.m_vm8, data, m_mem.m_vmsize);
+	m_mem.MarkAllPagesWritten();
 
 	for (GIFPath& path : m_path)
 	{
@@ -190,7 +190,9 @@ const char* GSUtil::GetPerfMonCounterName(GSPerfMon::counter_t counter, bool hw)
 			"TextureCopies",
 			"TextureUploads",
 			"Barriers",
-			"RenderPasses"
+			"RenderPasses",
+			"TargetLookups",
+			"TargetsVisited"
 		};
 		return counter < std::size(names_hw) ? names_hw[counter] : "";
 	}
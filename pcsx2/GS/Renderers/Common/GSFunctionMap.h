@@ -18,12 +18,14 @@ protected:
 	{
 		u64 frame, frames, prims;
 		u64 ticks, actual, total;
+		u32 epoch;
 		VALUE f;
 	};
 
 	std::unordered_map<KEY, ActivePtr*> m_map_active;
 
 	ActivePtr* m_active;
+	u32 m_epoch = 0;
 
 	virtual VALUE GetDefaultFunction(KEY key) = 0;
 
@@ -48,6 +50,7 @@ public:
 		if (it != m_map_active.end())
 		{
 			m_active = it->second;
+			m_active->epoch = m_epoch;
 		}
 		else
 		{
@@ -56,6 +59,7 @@ public:
 			memset(p, 0, sizeof(*p));
 
 			p->frame = (u64)-1;
+			p->epoch = m_epoch;
 
 			p->f = GetDefaultFunction(key);
 
@@ -67,6 +71,21 @@ public:
 		return m_active->f;
 	}
 
+	/// Starts a new usage window, GetUsedKeys() only returns keys looked up after this.
+	void NextEpoch()
+	{
+		m_epoch++;
+	}
+
+	void GetUsedKeys(std::vector<KEY>* keys) const
+	{
+		for (const auto& [key, p] : m_map_active)
+		{
+			if (p->epoch == m_epoch)
+				keys->push_back(key);
+		}
+	}
+
 	void UpdateStats(u64 frame, u64 ticks, int actual, int total, int prims)
 	{
 		if (m_active)
@@ -142,6 +161,7 @@ namespace GSCodeReserve
 	void ResetMemory();
 
 	size_t GetMemoryUsed();
+	size_t GetMemoryAvailable();
 
 	u8* ReserveMemory(size_t size);
 	void CommitMemory(size_t size);
@@ -150,10 +170,50 @@ namespace GSCodeReserve
 template <class CG, class KEY, class VALUE>
 class GSCodeGeneratorFunctionMap : public GSFunctionMap<KEY, VALUE>
 {
+public:
+	struct CompileStats
+	{
+		u32 compiled; ///< Generated on first use, i.e. in the middle of a draw.
+		u32 precompiled; ///< Generated ahead of time by Precompile().
+		u32 precompile_hits; ///< First uses which found precompiled code.
+		u64 compile_ticks;
+		u64 precompile_ticks;
+	};
+
+	enum { MAX_SIZE = 8192 };
+
+private:
 	std::string m_name;
 	std::unordered_map<u64, VALUE> m_cgmap;
+	CompileStats m_stats = {};
 
-	enum { MAX_SIZE = 8192 };
+	VALUE Generate(KEY key)
+	{
+		HostSys::BeginCodeWrite();
+
+		u8* code_ptr = GSCodeReserve::ReserveMemory(MAX_SIZE);
+		CG cg(key, code_ptr, MAX_SIZE);
+		cg.Generate();
+		pxAssert(cg.GetSize() < MAX_SIZE);
+
+#if 0
+		fprintf(stderr, "%s Location:%p Size:%zu Key:%llx\n", m_name.c_str(), code_ptr, cg.getSize(), (u64)key);
+		GSScanlineSelector sel(key);
+		sel.Print();
+#endif
+
+		const u32 size = static_cast<u32>(cg.GetSize());
+		GSCodeReserve::CommitMemory(size);
+
+		HostSys::EndCodeWrite();
+		HostSys::FlushInstructionCache(code_ptr, static_cast<u32>(size));
+
+		VALUE ret = (VALUE)cg.GetCode();
+
+		m_cgmap[key] = ret;
+
+		return ret;
+	}
 
 public:
 	GSCodeGeneratorFunctionMap(std::string name)
@@ -168,42 +228,38 @@ public:
 		m_cgmap.clear();
 	}
 
-	VALUE GetDefaultFunction(KEY key)
+	const CompileStats& GetCompileStats() const
 	{
-		VALUE ret = nullptr;
+		return m_stats;
+	}
 
+	VALUE GetDefaultFunction(KEY key)
+	{
+		// Only Precompile() can put a key in here before its first lookup.
 		auto i = m_cgmap.find(key);
-
 		if (i != m_cgmap.end())
 		{
-			ret = i->second;
-		}
-		else
-		{
-			HostSys::BeginCodeWrite();
-
-			u8* code_ptr = GSCodeReserve::ReserveMemory(MAX_SIZE);
-			CG cg(key, code_ptr, MAX_SIZE);
-			cg.Generate();
-			pxAssert(cg.GetSize() < MAX_SIZE);
-
-#if 0
-			fprintf(stderr, "%s Location:%p Size:%zu Key:%llx\n", m_name.c_str(), code_ptr, cg.getSize(), (u64)key);
-			GSScanlineSelector sel(key);
-			sel.Print();
-#endif
-
-			const u32 size = static_cast<u32>(cg.GetSize());
-			GSCodeReserve::CommitMemory(size);
-
-			HostSys::EndCodeWrite();
-			HostSys::FlushInstructionCache(code_ptr, static_cast<u32>(size));
-
-			ret = (VALUE)cg.GetCode();
-
-			m_cgmap[key] = ret;
+			m_stats.precompile_hits++;
+			return i->second;
 		}
 
+		const u64 start = GetCPUTicks();
+		VALUE ret = Generate(key);
+		m_stats.compile_ticks += GetCPUTicks() - start;
+		m_stats.compiled++;
 		return ret;
 	}
+
+	/// Generates code for a key ahead of its first use. Returns false if it already had code.
+	bool Precompile(KEY key)
+	{
+		if (m_cgmap.find(key) != m_cgmap.end())
+			return false;
+
+		const u64 start = GetCPUTicks();
+		Generate(key);
+		m_stats.precompile_ticks += GetCPUTicks() - start;
+		m_stats.precompiled++;
+		return true;
+	}
 };
@@ -79,6 +79,10 @@ void GSRenderer::UpdateRenderFixes()
 {
 }
 
+void GSRenderer::GameChanged()
+{
+}
+
 bool GSRenderer::Merge(int field)
 {
 	GSVector2i fs(0, 0);
@@ -742,18 +746,21 @@ void GSRenderer::VSync(u32 field, bool registers_written, bool idle_frame)
 			{
 				m_dump = GSDumpBase::CreateXzDump(m_snapshot, VMManager::GetDiscSerial(),
 					VMManager::GetDiscCRC(), screenshot_width, screenshot_height,
-					screenshot_pixels.empty() ? nullptr : screenshot_pixels.data(), fd, m_regs);
+					screenshot_pixels.empty() ? nullptr : screenshot_pixels.data(), fd, m_regs,
+					GSConfig.GSDumpCompressionLevel);
 				compression_str = TRANSLATE_SV("GS", "with LZMA compression");
 			}
 			else
 			{
 				m_dump = GSDumpBase::CreateZstDump(m_snapshot, VMManager::GetDiscSerial(),
 					VMManager::GetDiscCRC(), screenshot_width, screenshot_height,
-					screenshot_pixels.empty() ? nullptr : screenshot_pixels.data(), fd, m_regs);
+					screenshot_pixels.empty() ? nullptr : screenshot_pixels.data(), fd, m_regs,
+					GSConfig.GSDumpCompressionLevel);
 				compression_str = TRANSLATE_SV("GS", "with Zstandard compression");
 			}
 
 			delete[] fd.data;
+			m_dump_start_draw = s_n;
 
 			Host::AddKeyedOSDMessage("GSDump",
 				fmt::format(TRANSLATE_FS("GS", "Saving {0} GS dump {1} to '{2}'"),
@@ -762,25 +769,30 @@ void GSRenderer::VSync(u32 field, bool registers_written, bool idle_frame)
 				Host::OSD_INFO_DURATION);
 		}
 
-		const bool internal_resolution = (GSConfig.ScreenshotSize >= GSScreenshotSize::InternalResolution);
-		const bool aspect_correct = (GSConfig.ScreenshotSize != GSScreenshotSize::InternalResolutionUncorrected);
-
-		if (g_gs_device->GetCurrent() && SaveSnapshotToMemory(
-			internal_resolution ? 0 : g_gs_device->GetWindowWidth(),
-			internal_resolution ? 0 : g_gs_device->GetWindowHeight(),
-			aspect_correct, true,
-			&screenshot_width, &screenshot_height, &screenshot_pixels))
-		{
-			CompressAndWriteScreenshot(fmt::format("{}.{}", m_snapshot, GetScreenshotSuffix()),
-				screenshot_width, screenshot_height, std::move(screenshot_pixels));
-		}
-		else
+		// Dump-only requests (e.g. trimming) don't want a screenshot next to the dump.
+		if (m_snapshot_screenshot)
 		{
-			Host::AddIconOSDMessage("GSScreenshot", ICON_FA_CAMERA,
-				TRANSLATE_SV("GS", "Failed to render/download screenshot."), Host::OSD_ERROR_DURATION);
+			const bool internal_resolution = (GSConfig.ScreenshotSize >= GSScreenshotSize::InternalResolution);
+			const bool aspect_correct = (GSConfig.ScreenshotSize != GSScreenshotSize::InternalResolutionUncorrected);
+
+			if (g_gs_device->GetCurrent() && SaveSnapshotToMemory(
+				internal_resolution ? 0 : g_gs_device->GetWindowWidth(),
+				internal_resolution ? 0 : g_gs_device->GetWindowHeight(),
+				aspect_correct, true,
+				&screenshot_width, &screenshot_height, &screenshot_pixels))
+			{
+				CompressAndWriteScreenshot(fmt::format("{}.{}", m_snapshot, GetScreenshotSuffix()),
+					screenshot_width, screenshot_height, std::move(screenshot_pixels));
+			}
+			else
+			{
+				Host::AddIconOSDMessage("GSScreenshot", ICON_FA_CAMERA,
+					TRANSLATE_SV("GS", "Failed to render/download screenshot."), Host::OSD_ERROR_DURATION);
+			}
 		}
 
 		m_snapshot = {};
+		m_snapshot_screenshot = true;
 	}
 	else if (m_dump)
 	{
@@ -792,9 +804,23 @@ void GSRenderer::VSync(u32 field, bool registers_written, bool idle_frame)
 				Host::OSD_INFO_DURATION);
 			m_dump.reset();
 		}
-		else if (!last)
+		else
 		{
-			m_dump_frames--;
+			if (!last)
+				m_dump_frames--;
+
+			if (GSConfig.GSDumpKeyframes && m_dump->NeedsKeyframe())
+			{
+				if (GSConfig.UserHacks_ReadTCOnClose)
+					ReadbackTextureCache();
+
+				freezeData fd = {0, nullptr};
+				Freeze(&fd, true);
+				std::unique_ptr<u8[]> data = std::make_unique_for_overwrite<u8[]>(fd.size);
+				fd.data = data.get();
+				Freeze(&fd, false);
+				m_dump->Keyframe(s_n - m_dump_start_draw, fd, m_regs);
+			}
 		}
 	}
 
@@ -834,7 +860,7 @@ void GSRenderer::VSync(u32 field, bool registers_written, bool idle_frame)
 	}
 }
 
-void GSRenderer::QueueSnapshot(const std::string& path, const u32 gsdump_frames)
+void GSRenderer::QueueSnapshot(const std::string& path, const u32 gsdump_frames, const bool screenshot)
 {
 	if (!m_snapshot.empty())
 		return;
@@ -847,6 +873,7 @@ void GSRenderer::QueueSnapshot(const std::string& path, const u32 gsdump_frames)
 
 	// this is really gross, but wx we get the snapshot request after shift...
 	m_dump_frames = gsdump_frames;
+	m_snapshot_screenshot = screenshot || gsdump_frames == 0;
 }
 
 static std::string GSGetBaseFilename()
@@ -924,6 +951,7 @@ std::string GSGetBaseVideoFilename()
 void GSRenderer::StopGSDump()
 {
 	m_snapshot = {};
+	m_snapshot_screenshot = true;
 	m_dump_frames = 0;
 }
 
@@ -18,6 +18,8 @@ private:
 
 	std::string m_snapshot;
 	u32 m_dump_frames = 0;
+	bool m_snapshot_screenshot = true;
+	u64 m_dump_start_draw = 0;
 	u32 m_skipped_duplicate_frames = 0;
 
 	// Tracking draw counters for idle frame detection.
@@ -45,6 +47,9 @@ public:
 
 	virtual void UpdateRenderFixes();
 
+	/// Called when the running game's serial/CRC changes.
+	virtual void GameChanged();
+
 	virtual void VSync(u32 field, bool registers_written, bool idle_frame);
 	virtual bool CanUpscale() { return false; }
 	virtual float GetUpscaleMultiplier() { return 1.0f; }
@@ -59,7 +64,7 @@ public:
 	bool SaveSnapshotToMemory(u32 window_width, u32 window_height, bool apply_aspect, bool crop_borders,
 		u32* width, u32* height, std::vector<u32>* pixels);
 
-	void QueueSnapshot(const std::string& path, const u32 gsdump_frames);
+	void QueueSnapshot(const std::string& path, const u32 gsdump_frames, const bool screenshot = true);
 	void StopGSDump();
 	void PresentCurrentFrame();
 	bool BeginCapture(std::string filename, const GSVector2i& size = GSVector2i(0, 0));
@@ -3393,6 +3393,7 @@ void GSRendererHW::Draw()
 			if (vertical_offset < 0)
 			{
 				ds->m_TEX0.TBP0 = m_cached_ctx.ZBUF.Block();
+				ds->UpdatePages();
 				GSVector2i new_size = ds->m_unscaled_size;
 				// Make sure to use the original format for the offset.
 				const int new_offset = std::abs((vertical_offset / zbuf_psm.pgs.y) * GSLocalMemory::m_psm[ds->m_TEX0.PSM].pgs.y);
@@ -3440,6 +3441,7 @@ void GSRendererHW::Draw()
 				// Thankfully this doesn't really happen, but catwoman moves the framebuffer backwards 1 page with a channel shuffle, which is really messy and not easy to deal with.
 				// Hopefully the quick channel shuffle will just guess this and run with it.
 				ds->m_TEX0.TBP0 += horizontal_offset;
+				ds->UpdatePages();
 				horizontal_offset = 0;
 			}
 
@@ -3690,6 +3692,7 @@ void GSRendererHW::Draw()
 			if (vertical_offset < 0)
 			{
 				rt->m_TEX0.TBP0 = m_cached_ctx.FRAME.Block();
+				rt->UpdatePages();
 				GSVector2i new_size = rt->m_unscaled_size;
 				// Make sure to use the original format for the offset.
 				const int new_offset = std::abs((vertical_offset / frame_psm.pgs.y) * GSLocalMemory::m_psm[rt->m_TEX0.PSM].pgs.y);
@@ -3737,6 +3740,7 @@ void GSRendererHW::Draw()
 				// Thankfully this doesn't really happen, but catwoman moves the framebuffer backwards 1 page with a channel shuffle, which is really messy and not easy to deal with.
 				// Hopefully the quick channel shuffle will just guess this and run with it.
 				rt->m_TEX0.TBP0 += horizontal_offset;
+				rt->UpdatePages();
 				horizontal_offset = 0;
 			}
 
@@ -9026,6 +9030,8 @@ void GSRendererHW::ClearGSLocalMemory(const GSOffset& off, const GSVector4i& r,
 	GL_INS("HW: ClearGSLocalMemory(): %08X %d,%d => %d,%d @ BP %x BW %u %s", vert_color, r.x, r.y, r.z, r.w, off.bp(),
 		off.bw(), GSUtil::GetPSMName(off.psm()));
 
+	m_mem.MarkPagesWritten(off.pageLooperForRect(r));
+
 	const u32 psm = (off.psm() == PSMCT32 && m_cached_ctx.FRAME.FBMSK == 0xFF000000u) ? PSMCT24 : off.psm();
 	const int format = GSLocalMemory::m_psm[psm].fmt;
 
@@ -30,8 +30,18 @@ std::unique_ptr<GSTextureCache> g_texture_cache;
 
 static u8* s_unswizzle_buffer;
 
-/// List of candidates for purging when the hash cache gets too large.
-static std::vector<std::pair<GSTextureCache::HashCacheMap::iterator, s32>> s_hash_cache_purge_list;
+/// Last hash taken of a texture level, and the local memory write generation it was taken at.
+struct TextureHashMemoEntry
+{
+	u64 TEX0;
+	u64 TEXA;
+	u64 region;
+	u64 generation;
+	GSTextureCache::HashType hash;
+	bool valid;
+};
+static constexpr u32 TEXTURE_HASH_MEMO_SIZE = 1024;
+static std::array<TextureHashMemoEntry, TEXTURE_HASH_MEMO_SIZE> s_texture_hash_memo;
 
 #ifdef PCSX2_DEVBUILD
 // We can only set one texture name per command buffer, which would break our fancy texture cache RT/DS/texture naming.
@@ -55,6 +65,9 @@ GSTextureCache::GSTextureCache()
 	s_unswizzle_buffer = (u8*)_aligned_malloc(9 * 1024 * 1024, VECTOR_ALIGNMENT);
 	pxAssertRel(s_unswizzle_buffer, "Failed to allocate unswizzle buffer");
 
+	// Generations restart with local memory, so anything remembered from a previous renderer is meaningless.
+	s_texture_hash_memo = {};
+
 	m_surface_offset_cache.reserve(S_SURFACE_OFFSET_CACHE_MAX_SIZE);
 }
 
@@ -62,7 +75,6 @@ GSTextureCache::~GSTextureCache()
 {
 	RemoveAll(true, true, true);
 
-	s_hash_cache_purge_list = {};
 	_aligned_free(s_unswizzle_buffer);
 }
 
@@ -103,10 +115,9 @@ void GSTextureCache::RemoveAll(bool sources, bool targets, bool hash_cache)
 
 	if (hash_cache)
 	{
-		for (auto it : m_hash_cache)
-			g_gs_device->Recycle(it.second.texture);
+		m_hash_cache.ForEach([](HashCacheEntry* entry) { g_gs_device->Recycle(entry->texture); });
 
-		m_hash_cache.clear();
+		m_hash_cache.Clear();
 		m_hash_cache_memory_usage = 0;
 		m_hash_cache_replacement_memory_usage = 0;
 	}
@@ -1403,9 +1414,12 @@ GSTextureCache::Source* GSTextureCache::LookupSource(const bool is_color, const
 		bool found_t = false;
 		bool tex_merge_rt = false;
 		auto& list = m_dst[RenderTarget];
-		for (auto i = list.begin(); i != list.end(); ++i)
+		g_perfmon.Put(GSPerfMon::TargetLookups, 1);
+		const bool rt_overlaps = TargetsMayOverlap(RenderTarget, bp, bw, psm, block_boundary_rect);
+		for (auto i = list.begin(); rt_overlaps && i != list.end(); ++i)
 		{
 			Target* t = *i;
+			g_perfmon.Put(GSPerfMon::TargetsVisited, 1);
 			// Make sure it is page aligned, otherwise things get messy with the pixel order (Tomb Raider Legend).
 			if (t->m_used)
 			{
@@ -1710,6 +1724,7 @@ GSTextureCache::Source* GSTextureCache::LookupSource(const bool is_color, const
 							}
 							t->m_valid_rgb = true;
 							t->m_TEX0 = dst_match->m_TEX0;
+							t->UpdatePages();
 							break;
 						}
 					}
@@ -2077,8 +2092,13 @@ GSTextureCache::Source* GSTextureCache::LookupSource(const bool is_color, const
 			// 1/ Check only current frame, I guess it is only used as a postprocessing effect
 			if (is_color)
 			{
-				for (auto t : m_dst[DepthStencil])
+				auto& ds_list = m_dst[DepthStencil];
+				g_perfmon.Put(GSPerfMon::TargetLookups, 1);
+				const bool ds_overlaps = TargetsMayOverlap(DepthStencil, bp, bw, psm, block_boundary_rect);
+				for (auto i = ds_list.begin(); ds_overlaps && i != ds_list.end(); ++i)
 				{
+					Target* t = *i;
+					g_perfmon.Put(GSPerfMon::TargetsVisited, 1);
 					if (t->m_age <= 1 && t->m_used && t->m_dirty.empty() && GSUtil::HasSharedBits(psm, t->m_TEX0.PSM) && t->Inside(bp, bw, psm, block_boundary_rect))
 					{
 						GL_INS("TC: Warning depth format read as color format. Pixels will be scrambled");
@@ -2411,16 +2431,25 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 	// TODO: Move all frame stuff to its own routine too.
 	if (!is_frame)
 	{
+		// Targets are only matched when they start at bp, or overlap the draw (which shuffles may extend by 32 lines).
+		const GSVector4i overlap_rect = (is_shuffle && !min_rect.rempty()) ? (min_rect + GSVector4i(0, 0, 0, 32)) : min_rect;
+
 		for (int iteration = 0; iteration < 2; iteration++)
 		{
 			if (dst != nullptr)
 				break;
 
 			auto& new_dst = iteration == 0 ? dst : dst_match;
-			list = &m_dst[iteration == 0 ? type : (1 - type)];
+			const int list_type = iteration == 0 ? type : (1 - type);
+			list = &m_dst[list_type];
+			g_perfmon.Put(GSPerfMon::TargetLookups, 1);
+			if (!TargetsMayOverlap(list_type, bp, TEX0.TBW, TEX0.PSM, overlap_rect))
+				continue;
+
 			for (auto i = list->begin(); i != list->end();)
 			{
 				Target* t = *i;
+				g_perfmon.Put(GSPerfMon::TargetsVisited, 1);
 				if (bp == t->m_TEX0.TBP0)
 				{
 					bool can_use = true;
@@ -2685,10 +2714,16 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 	else
 	{
 		pxAssert(type == RenderTarget);
+
+		// Both searches only match targets which cover bp.
+		g_perfmon.Put(GSPerfMon::TargetLookups, 1);
+		const bool bp_has_targets = m_dst_pages[RenderTarget].HasTargets(bp, bp);
+
 		// Let's try to find a perfect frame that contains valid data
-		for (auto i = list->begin(); i != list->end(); ++i)
+		for (auto i = list->begin(); bp_has_targets && i != list->end(); ++i)
 		{
 			Target* t = *i;
+			g_perfmon.Put(GSPerfMon::TargetsVisited, 1);
 
 			// Only checks that the texure starts at the requested bp, size isn't considered.
 			if (bp == t->m_TEX0.TBP0 && t->m_end_block >= bp)
@@ -2706,6 +2741,7 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 							t->m_TEX0.TBW = TEX0.TBW;
 							t->m_valid = dirty_rect;
 							t->m_end_block = GSLocalMemory::GetEndBlockAddress(t->m_TEX0.TBP0, t->m_TEX0.TBW, t->m_TEX0.PSM, t->m_valid);
+							t->UpdatePages();
 							t->m_drawn_since_read = GSVector4i::zero();
 						}
 						else
@@ -2728,11 +2764,12 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 		}
 
 		// 2nd try ! Try to find a frame at the requested bp -> bp + size is inside of (or equal to)
-		if (!dst)
+		if (!dst && bp_has_targets)
 		{
 			for (auto i = list->begin(); i != list->end(); ++i)
 			{
 				Target* t = *i;
+				g_perfmon.Put(GSPerfMon::TargetsVisited, 1);
 				const u32 end_block = GSLocalMemory::GetEndBlockAddress(bp, TEX0.TBW, TEX0.PSM, GSVector4i(0, size.y, size.x, size.y + 1));
 				const u32 bp_adj = (end_block < t->m_TEX0.TBP0 && t->UnwrappedEndBlock() > GS_MAX_BLOCKS) ? (bp + GS_MAX_BLOCKS) : bp;
 				const bool half_buffer_match = GSConfig.UserHacks_TextureInsideRt >= GSTextureInRtMode::InsideTargets && TEX0.TBW == t->m_TEX0.TBW && TEX0.PSM == t->m_TEX0.PSM &&
@@ -3240,6 +3277,7 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 			dst->m_32_bits_fmt = dst_match->m_32_bits_fmt;
 			dst->OffsetHack_modxy = dst_match->OffsetHack_modxy;
 			dst->m_end_block = dst_match->m_end_block; // If we're copying the size, we need to keep the end block.
+			dst->UpdatePages();
 			dst->m_valid = dst_match->m_valid;
 			dst->m_valid_alpha_low = dst_match->m_valid_alpha_low; //&& psm_s.trbpp != 24;
 			dst->m_valid_alpha_high = dst_match->m_valid_alpha_high; //&& psm_s.trbpp != 24;
@@ -3819,6 +3857,7 @@ bool GSTextureCache::PreloadTarget(GIFRegTEX0 TEX0, const GSVector2i& size, cons
 							dst->m_valid = t->m_valid;
 							dst->m_drawn_since_read = t->m_drawn_since_read;
 							dst->m_end_block = t->m_end_block;
+							dst->UpdatePages();
 							dst->m_valid_rgb = true;
 							t->m_valid_rgb = false;
 							t->m_was_dst_matched = true;
@@ -4466,10 +4505,16 @@ void GSTextureCache::InvalidateContainedTargets(u32 start_bp, u32 end_bp, u32 wr
 // must invalidate the Target/Depth respectively
 void GSTextureCache::InvalidateVideoMemType(int type, u32 bp, u32 write_psm, u32 write_fbmsk, bool dirty_only)
 {
+	// A target starting at bp always covers bp's page.
+	g_perfmon.Put(GSPerfMon::TargetLookups, 1);
+	if (!m_dst_pages[type].HasTargets(bp, bp))
+		return;
+
 	auto& list = m_dst[type];
 	for (auto i = list.begin(); i != list.end(); ++i)
 	{
 		Target* const t = *i;
+		g_perfmon.Put(GSPerfMon::TargetsVisited, 1);
 		if (bp != t->m_TEX0.TBP0 || (dirty_only && t->m_dirty.empty()))
 			continue;
 
@@ -4651,13 +4696,20 @@ void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& r
 	RGBAMask rgba;
 	rgba._u32 = GSUtil::GetChannelMask(psm);
 
+	g_perfmon.Put(GSPerfMon::TargetLookups, 1);
+
 	for (int type = 0; type < 2; type++)
 	{
+		// Any target passing the range check below has either bp or its TBP0 inside [bp, end_bp].
+		if (!m_dst_pages[type].HasTargets(bp, std::max(bp, end_bp)))
+			continue;
+
 		auto& list = m_dst[type];
 		for (auto i = list.begin(); i != list.end();)
 		{
 			auto j = i;
 			Target* t = *j;
+			g_perfmon.Put(GSPerfMon::TargetsVisited, 1);
 
 			// Don't bother checking any further if the target doesn't overlap with the write/invalidation.
 			if ((bp < t->m_TEX0.TBP0 && end_bp < t->m_TEX0.TBP0) || bp > t->UnwrappedEndBlock())
@@ -5160,6 +5212,7 @@ bool GSTextureCache::Move(u32 SBP, u32 SBW, u32 SPSM, int sx, int sy, u32 DBP, u
 			if (dst->m_was_dst_matched)
 			{
 				dst->m_TEX0 = new_TEX0;
+				dst->UpdatePages();
 			}
 		}
 
@@ -5622,10 +5675,23 @@ GSTextureCache::Target* GSTextureCache::GetTargetWithSharedBits(u32 BP, u32 PSM)
 
 GSTextureCache::Target* GSTextureCache::FindOverlappingTarget(GSTextureCache::Target* target) const
 {
+	g_perfmon.Put(GSPerfMon::TargetLookups, 1);
+
 	for (int i = 0; i < 2; i++)
 	{
+		if (!m_dst_pages[i].HasTargets(target->m_TEX0.TBP0, target->UnwrappedEndBlock(), (i == target->m_type) ? target : nullptr))
+		{
+#ifdef PCSX2_DEVBUILD
+			for (Target* tgt : m_dst[i])
+				pxAssertMsg(tgt == target || !CheckOverlap(tgt->m_TEX0.TBP0, tgt->m_end_block, target->m_TEX0.TBP0, target->m_end_block), "Target missing from page map");
+#endif
+			continue;
+		}
+
 		for (Target* tgt : m_dst[i])
 		{
+			g_perfmon.Put(GSPerfMon::TargetsVisited, 1);
+
 			if (tgt == target)
 				continue;
 
@@ -5639,10 +5705,23 @@ GSTextureCache::Target* GSTextureCache::FindOverlappingTarget(GSTextureCache::Ta
 
 GSTextureCache::Target* GSTextureCache::FindOverlappingTarget(u32 BP, u32 end_bp) const
 {
+	g_perfmon.Put(GSPerfMon::TargetLookups, 1);
+
 	for (int i = 0; i < 2; i++)
 	{
+		if (!m_dst_pages[i].HasTargets(BP, end_bp))
+		{
+#ifdef PCSX2_DEVBUILD
+			for (Target* tgt : m_dst[i])
+				pxAssertMsg(!CheckOverlap(tgt->m_TEX0.TBP0, tgt->m_end_block, BP, end_bp), "Target missing from page map");
+#endif
+			continue;
+		}
+
 		for (Target* tgt : m_dst[i])
 		{
+			g_perfmon.Put(GSPerfMon::TargetsVisited, 1);
+
 			if (CheckOverlap(tgt->m_TEX0.TBP0, tgt->m_end_block, BP, end_bp))
 				return tgt;
 		}
@@ -5657,6 +5736,18 @@ GSTextureCache::Target* GSTextureCache::FindOverlappingTarget(u32 BP, u32 BW, u3
 	return FindOverlappingTarget(BP, end_bp);
 }
 
+bool GSTextureCache::TargetsMayOverlap(int type, u32 bp, u32 bw, u32 psm, const GSVector4i& rect) const
+{
+	if (rect.rempty())
+		return m_dst_pages[type].HasTargets(bp, bp);
+
+	// Surface::Overlaps() and Inside() never look past the page of the bottom-right pixel, since pages
+	// are laid out linearly. Blocks within a page may be out of order, but that doesn't matter here.
+	const GSOffset off(GSLocalMemory::m_psm[psm].info, bp, bw, psm);
+	const u32 end_bp = std::max(bp, off.bnNoWrap(rect.z - 1, rect.w - 1));
+	return m_dst_pages[type].HasTargets(bp, end_bp);
+}
+
 GSVector2i GSTextureCache::GetTargetSize(u32 bp, u32 fbw, u32 psm, s32 min_width, s32 min_height, bool can_expand)
 {
 	TargetHeightElem search = {};
@@ -5801,9 +5892,7 @@ void GSTextureCache::ReplaceSourceTexture(Source* s, GSTexture* new_texture, flo
 
 	if (s->m_from_hash_cache)
 	{
-		pxAssert(s->m_from_hash_cache->refcount > 0);
-		if ((--s->m_from_hash_cache->refcount) == 0)
-			s->m_from_hash_cache->age = 0;
+		s->m_from_hash_cache->Release();
 	}
 	else if (!s->m_shared_texture)
 	{
@@ -6836,21 +6925,21 @@ GSTextureCache::HashCacheEntry* GSTextureCache::LookupHashCache(const GIFRegTEX0
 	}
 
 	// check with the full key
-	auto it = m_hash_cache.find(key);
+	HashCacheEntry* entry = m_hash_cache.Find(key);
 
 	// if this fails, and paltex is on, try indexed texture
 	const bool needs_second_lookup = paltex && (dump || replace);
-	if (needs_second_lookup && it == m_hash_cache.end())
-		it = m_hash_cache.find(key.WithRemovedCLUTHash());
+	if (needs_second_lookup && !entry)
+		entry = m_hash_cache.Find(key.WithRemovedCLUTHash());
 
 	// did we find either a replacement, cached/indexed texture?
-	if (it != m_hash_cache.end())
+	if (entry)
 	{
 		// super easy, cache hit. remove paltex if it's a replacement texture.
 		GL_CACHE("TC: HC Hit: %" PRIx64 " %" PRIx64 " R-%ux%u", key.TEX0Hash, key.CLUTHash, key.region_width, key.region_height);
-		HashCacheEntry* entry = &it->second;
 		paltex &= (entry->texture->GetFormat() == GSTexture::Format::UNorm8);
 		entry->refcount++;
+		m_hash_cache.Touch(entry);
 		return entry;
 	}
 
@@ -6868,9 +6957,8 @@ GSTextureCache::HashCacheEntry* GSTextureCache::LookupHashCache(const GIFRegTEX0
 		{
 			// found a replacement texture! insert it into the hash cache, and clear paltex (since it's not indexed)
 			paltex = false;
-			const HashCacheEntry entry{replacement_tex, 1u, 0u, alpha_minmax, true, true};
-			m_hash_cache_replacement_memory_usage += entry.texture->GetMemUsage();
-			return &m_hash_cache.emplace(key, entry).first->second;
+			m_hash_cache_replacement_memory_usage += replacement_tex->GetMemUsage();
+			return m_hash_cache.Insert(key, HashCacheEntry{replacement_tex, 1u, 0u, alpha_minmax, true, true});
 		}
 		else if (
 			replacement_texture_pending ||
@@ -6951,72 +7039,60 @@ GSTextureCache::HashCacheEntry* GSTextureCache::LookupHashCache(const GIFRegTEX0
 		key.RemoveCLUTHash();
 
 	// insert into the cache cache, and we're done
-	const HashCacheEntry entry{tex, 1u, 0u, alpha_minmax, compute_alpha_minmax, false};
 	m_hash_cache_memory_usage += tex->GetMemUsage();
-	return &m_hash_cache.emplace(key, entry).first->second;
+	entry = m_hash_cache.Insert(key, HashCacheEntry{tex, 1u, 0u, alpha_minmax, compute_alpha_minmax, false});
+
+	// enforce the budget straight away, rather than letting a texture-heavy frame overshoot it until the next vsync
+	TrimHashCache(std::numeric_limits<u32>::max());
+	return entry;
 }
 
-GSTextureCache::HashCacheMap::iterator GSTextureCache::RemoveFromHashCache(HashCacheMap::iterator it)
+void GSTextureCache::RemoveFromHashCache(HashCacheEntry* entry)
 {
-	HashCacheEntry& e = it->second;
-	const u32 mem_usage = e.texture->GetMemUsage();
-	if (e.is_replacement)
+	const u32 mem_usage = entry->texture->GetMemUsage();
+	if (entry->is_replacement)
 		m_hash_cache_replacement_memory_usage -= mem_usage;
 	else
 		m_hash_cache_memory_usage -= mem_usage;
-	g_gs_device->Recycle(e.texture);
-	return m_hash_cache.erase(it);
+	g_gs_device->Recycle(entry->texture);
+	m_hash_cache.Erase(entry);
 }
 
 void GSTextureCache::AgeHashCache()
+{
+	constexpr u32 MAX_HASH_CACHE_AGE = 30;
+
+	m_hash_cache.AdvanceFrame();
+	TrimHashCache(MAX_HASH_CACHE_AGE);
+}
+
+void GSTextureCache::TrimHashCache(u32 max_age)
 {
 	// Where did this number come from?
 	// A game called Corvette draws its background FMVs with a ton of 17x17 tiles, which ends up
 	// being about 600 texture uploads per frame. We'll use 800 as an upper bound for a bit of
 	// a buffer, hopefully nothing's going to end up with more textures than that.
 	constexpr u32 MAX_HASH_CACHE_SIZE = 800;
-	constexpr u32 MAX_HASH_CACHE_AGE = 30;
 
-	bool might_need_cache_purge = (m_hash_cache.size() > MAX_HASH_CACHE_SIZE);
-	if (might_need_cache_purge)
-		s_hash_cache_purge_list.clear();
+	const u64 budget = static_cast<u64>(GSConfig.TextureHashCacheBudget) * _1mb;
 
-	for (auto it = m_hash_cache.begin(); it != m_hash_cache.end();)
+	// Only the LRU end needs looking at. Entries which are still referenced by a source, or were released since
+	// they were last touched, are recycled to the front; the count bounds the walk if everything is in use.
+	for (u32 remaining = m_hash_cache.size(); remaining > 0; remaining--)
 	{
-		HashCacheEntry& e = it->second;
-		if (e.refcount > 0)
-		{
-			++it;
-			continue;
-		}
+		HashCacheEntry* entry = m_hash_cache.GetOldest();
+		const bool over_limit = (m_hash_cache.size() > MAX_HASH_CACHE_SIZE || (budget > 0 && GetTotalHashCacheMemoryUsage() > budget));
+		if (!over_limit && m_hash_cache.GetAge(entry) <= max_age)
+			break;
 
-		if (++e.age > MAX_HASH_CACHE_AGE)
+		if (entry->refcount > 0 || entry->released)
 		{
-			it = RemoveFromHashCache(it);
+			entry->released = false;
+			m_hash_cache.Touch(entry);
 			continue;
 		}
 
-		// We might free up enough just with "normal" removals above.
-		if (might_need_cache_purge)
-		{
-			might_need_cache_purge = (m_hash_cache.size() > MAX_HASH_CACHE_SIZE);
-			if (might_need_cache_purge)
-				s_hash_cache_purge_list.emplace_back(it, static_cast<s32>(e.age));
-		}
-
-		++it;
-	}
-
-	// Pushing to a list, sorting, and removing ends up faster than re-iterating the map.
-	if (might_need_cache_purge)
-	{
-		std::sort(s_hash_cache_purge_list.begin(), s_hash_cache_purge_list.end(),
-			[](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
-
-		const u32 entries_to_purge = std::min(static_cast<u32>(m_hash_cache.size() - MAX_HASH_CACHE_SIZE),
-			static_cast<u32>(s_hash_cache_purge_list.size()));
-		for (u32 i = 0; i < entries_to_purge; i++)
-			RemoveFromHashCache(s_hash_cache_purge_list[i].first);
+		RemoveFromHashCache(entry);
 	}
 }
 
@@ -7037,6 +7113,7 @@ GSTextureCache::Target* GSTextureCache::Target::Create(GIFRegTEX0 TEX0, int w, i
 	g_texture_cache->m_target_memory_usage += t->m_texture->GetMemUsage();
 
 	g_texture_cache->m_dst[type].push_front(t);
+	g_texture_cache->m_dst_pages[type].Add(t);
 
 	t->UpdateTextureDebugName();
 
@@ -7237,6 +7314,7 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 	const GSOffset off = g_gs_renderer->m_mem.GetOffset(TEX0.TBP0, TEX0.TBW, TEX0.PSM);
 	u8* bits = const_cast<u8*>(dltex->get()->GetMapPointer());
 	const u32 pitch = dltex->get()->GetMapPitch();
+	g_gs_renderer->m_mem.MarkPagesWritten(off.pageLooperForRect(r));
 
 	switch (TEX0.PSM)
 	{
@@ -7277,6 +7355,7 @@ void GSTextureCache::Read(Source* t, const GSVector4i& r)
 	if (m_color_download_texture->Map(drc))
 	{
 		const GSOffset off = g_gs_renderer->m_mem.GetOffset(t->m_TEX0.TBP0, t->m_TEX0.TBW, t->m_TEX0.PSM);
+		g_gs_renderer->m_mem.MarkPagesWritten(off.pageLooperForRect(r));
 		g_gs_renderer->m_mem.WritePixel32(
 			const_cast<u8*>(m_color_download_texture->GetMapPointer()), m_color_download_texture->GetMapPitch(), off, r);
 		m_color_download_texture->Unmap();
@@ -7669,6 +7748,9 @@ GSTextureCache::Target::~Target()
 	// Targets should never be shared.
 	pxAssert(!m_shared_texture);
 
+	if (m_page_count > 0)
+		g_texture_cache->m_dst_pages[m_type].Remove(this);
+
 	if (m_texture)
 	{
 		g_texture_cache->m_target_memory_usage -= m_texture->GetMemUsage();
@@ -7988,6 +8070,8 @@ void GSTextureCache::Target::ResizeValidity(const GSVector4i& rect)
 
 	// Else No valid size, so need to resize down.
 
+	UpdatePages();
+
 	// GL_CACHE("TC: ResizeValidity (0x%x->0x%x) from R:%d,%d Valid: %d,%d", m_TEX0.TBP0, m_end_block, rect.z, rect.w, m_valid.z, m_valid.w);
 }
 
@@ -8005,9 +8089,18 @@ void GSTextureCache::Target::UpdateValidity(const GSVector4i& rect, bool can_res
 
 		m_end_block = GSLocalMemory::GetEndBlockAddress(m_TEX0.TBP0, m_TEX0.TBW, m_TEX0.PSM, m_valid);
 	}
+
+	UpdatePages();
+
 	// GL_CACHE("TC: UpdateValidity (0x%x->0x%x) from R:%d,%d Valid: %d,%d", m_TEX0.TBP0, m_end_block, rect.z, rect.w, m_valid.z, m_valid.w);
 }
 
+void GSTextureCache::Target::UpdatePages()
+{
+	if (m_page_count > 0)
+		g_texture_cache->m_dst_pages[m_type].Update(this);
+}
+
 bool GSTextureCache::Target::ResizeTexture(int new_unscaled_width, int new_unscaled_height, bool recycle_old, bool require_new_rect, GSVector4i new_rect, bool keep_old)
 {
 	const GSVector2i size = m_texture->GetSize();
@@ -8124,9 +8217,7 @@ void GSTextureCache::SourceMap::RemoveAll()
 	{
 		if (s->m_from_hash_cache)
 		{
-			pxAssert(s->m_from_hash_cache->refcount > 0);
-			if ((--s->m_from_hash_cache->refcount) == 0)
-				s->m_from_hash_cache->age = 0;
+			s->m_from_hash_cache->Release();
 		}
 
 		delete s;
@@ -8153,14 +8244,68 @@ void GSTextureCache::SourceMap::RemoveAt(Source* s)
 
 	if (s->m_from_hash_cache)
 	{
-		pxAssert(s->m_from_hash_cache->refcount > 0);
-		if ((--s->m_from_hash_cache->refcount) == 0)
-			s->m_from_hash_cache->age = 0;
+		s->m_from_hash_cache->Release();
 	}
 
 	delete s;
 }
 
+// GSTextureCache::TargetPageMap
+
+void GSTextureCache::TargetPageMap::Add(Target* t)
+{
+	const u32 start = t->m_TEX0.TBP0 >> 5;
+	const u32 count = std::min((t->UnwrappedEndBlock() >> 5) - start + 1, static_cast<u32>(GS_MAX_PAGES));
+	for (u32 i = 0; i < count; i++)
+		m_pages[(start + i) % GS_MAX_PAGES]++;
+
+	t->m_page_start = static_cast<u16>(start);
+	t->m_page_count = static_cast<u16>(count);
+}
+
+void GSTextureCache::TargetPageMap::Remove(Target* t)
+{
+	for (u32 i = 0; i < t->m_page_count; i++)
+	{
+		pxAssert(m_pages[(t->m_page_start + i) % GS_MAX_PAGES] > 0);
+		m_pages[(t->m_page_start + i) % GS_MAX_PAGES]--;
+	}
+
+	t->m_page_count = 0;
+}
+
+void GSTextureCache::TargetPageMap::Update(Target* t)
+{
+	const u32 start = t->m_TEX0.TBP0 >> 5;
+	const u32 count = std::min((t->UnwrappedEndBlock() >> 5) - start + 1, static_cast<u32>(GS_MAX_PAGES));
+	if (start == t->m_page_start && count == t->m_page_count)
+		return;
+
+	Remove(t);
+	Add(t);
+}
+
+bool GSTextureCache::TargetPageMap::HasTargets(u32 start_bp, u32 end_bp, const Target* exclude) const
+{
+	if (end_bp < start_bp)
+		end_bp += GS_MAX_BLOCKS;
+
+	const u32 start = start_bp >> 5;
+	const u32 count = std::min((end_bp >> 5) - start + 1, static_cast<u32>(GS_MAX_PAGES));
+	for (u32 i = 0; i < count; i++)
+	{
+		const u32 page = (start + i) % GS_MAX_PAGES;
+		u32 targets = m_pages[page];
+		if (exclude && ((page + GS_MAX_PAGES - exclude->m_page_start) % GS_MAX_PAGES) < exclude->m_page_count)
+			targets--;
+
+		if (targets > 0)
+			return true;
+	}
+
+	return false;
+}
+
 void GSTextureCache::AttachPaletteToSource(Source* s, u16 pal, bool need_gs_texture, bool update_alpha_minmax)
 {
 	s->m_palette_obj = m_palette_map.LookupPalette(pal, need_gs_texture);
@@ -8431,31 +8576,30 @@ void GSTextureCache::InjectHashCacheTexture(const HashCacheKey& key, GSTexture*
 	// When we insert we update memory usage. Old texture gets removed below.
 	m_hash_cache_replacement_memory_usage += tex->GetMemUsage();
 
-	auto it = m_hash_cache.find(key);
-	if (it == m_hash_cache.end())
+	HashCacheEntry* entry = m_hash_cache.Find(key);
+	if (!entry)
 	{
 		// We must've got evicted before we finished loading. No matter, add it in there anyway;
 		// if it's not used again, it'll get tossed out later.
-		const HashCacheEntry entry{tex, 1u, 0u, alpha_minmax, true, true};
-		m_hash_cache.emplace(key, entry);
+		m_hash_cache.Insert(key, HashCacheEntry{tex, 1u, 0u, alpha_minmax, true, true});
 		return;
 	}
 
 	// Reset age so we don't get thrown out too early.
-	it->second.age = 0;
-	it->second.alpha_minmax = alpha_minmax;
-	it->second.valid_alpha_minmax = true;
+	m_hash_cache.Touch(entry);
+	entry->alpha_minmax = alpha_minmax;
+	entry->valid_alpha_minmax = true;
 
 	// Update memory usage, swap the textures, and recycle the old one for reuse.
-	if (!it->second.is_replacement)
-		m_hash_cache_memory_usage -= it->second.texture->GetMemUsage();
+	if (!entry->is_replacement)
+		m_hash_cache_memory_usage -= entry->texture->GetMemUsage();
 	else
-		m_hash_cache_replacement_memory_usage -= it->second.texture->GetMemUsage();
+		m_hash_cache_replacement_memory_usage -= entry->texture->GetMemUsage();
 
-	it->second.is_replacement = true;
-	m_src.SwapTexture(it->second.texture, tex);
-	g_gs_device->Recycle(it->second.texture);
-	it->second.texture = tex;
+	entry->is_replacement = true;
+	m_src.SwapTexture(entry->texture, tex);
+	g_gs_device->Recycle(entry->texture);
+	entry->texture = tex;
 }
 
 // GSTextureCache::Palette
@@ -8871,10 +9015,31 @@ static void HashTextureLevel(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, GST
 
 GSTextureCache::HashType GSTextureCache::HashTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region)
 {
+	// If none of the pages the texture covers have been written since we last hashed it, the hash can't have changed.
+	const GSLocalMemory& mem = g_gs_renderer->m_mem;
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
+	const int tw = region.HasX() ? region.GetWidth() : (1 << TEX0.TW);
+	const int th = region.HasY() ? region.GetHeight() : (1 << TEX0.TH);
+	const GSVector4i block_rect(region.GetRect(tw, th).ralign<Align_Outside>(psm.bs));
+	const u64 pages_generation = mem.GetPagesGeneration(mem.GetOffset(TEX0.TBP0, TEX0.TBW, TEX0.PSM).pageLooperForRect(block_rect));
+
+	const u64 memo_TEX0 = TEX0.U64 & 0x00000003FFFFFFFFULL; // TBP0, TBW, PSM, TW, TH
+	const u64 memo_TEXA = TEXA.U64 & 0x000000FF000080FFULL;
+	const u64 memo_key[3] = {memo_TEX0, memo_TEXA, region.bits};
+	TextureHashMemoEntry& memo = s_texture_hash_memo[GSXXH3_64bits(memo_key, sizeof(memo_key)) % TEXTURE_HASH_MEMO_SIZE];
+	if (memo.valid && memo.TEX0 == memo_TEX0 && memo.TEXA == memo_TEXA && memo.region == region.bits &&
+		pages_generation <= memo.generation)
+	{
+		return memo.hash;
+	}
+
 	BlockHashState hash_st;
 	BlockHashReset(hash_st);
 	HashTextureLevel(TEX0, TEXA, region, hash_st, s_unswizzle_buffer);
-	return FinishBlockHash(hash_st);
+	const HashType hash = FinishBlockHash(hash_st);
+
+	memo = {memo_TEX0, memo_TEXA, region.bits, mem.GetWriteGeneration(), hash, true};
+	return hash;
 }
 
 void GSTextureCache::PreloadTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region, GSLocalMemory& mem,
@@ -8949,6 +9114,13 @@ GSTextureCache::HashCacheKey GSTextureCache::HashCacheKey::Create(const GIFRegTE
 	ret.region_width = static_cast<u16>(region.GetWidth());
 	ret.region_height = static_cast<u16>(region.GetHeight());
 
+	// Without mipmaps this is the same as hashing the base level alone, which can reuse a remembered hash.
+	if (!lod || lod->y <= lod->x)
+	{
+		ret.TEX0Hash = HashTexture(TEX0, TEXA, region);
+		return ret;
+	}
+
 	BlockHashState hash_st;
 	BlockHashReset(hash_st);
 
@@ -8991,3 +9163,159 @@ u64 GSTextureCache::HashCacheKeyHash::operator()(const HashCacheKey& key) const
 		static_cast<u64>(key.region_width) | (static_cast<u64>(key.region_height) << 16));
 	return h;
 }
+
+// GSTextureCache::HashCacheMap
+
+GSTextureCache::HashCacheEntry* GSTextureCache::HashCacheMap::Find(const HashCacheKey& key)
+{
+	if (m_size == 0)
+		return nullptr;
+
+	const u32 slot = FindSlot(key, HashCacheKeyHash()(key));
+	return (m_slots[slot].node != INVALID) ? &GetNode(m_slots[slot].node).entry : nullptr;
+}
+
+GSTextureCache::HashCacheEntry* GSTextureCache::HashCacheMap::Insert(const HashCacheKey& key, const HashCacheEntry& entry)
+{
+	// Keep the load factor at or below 50%, probe sequences stay short.
+	if ((m_size + 1) * 2 > static_cast<u32>(m_slots.size()))
+		Grow();
+
+	const u64 hash = HashCacheKeyHash()(key);
+	const u32 slot = FindSlot(key, hash);
+	if (m_slots[slot].node != INVALID)
+		return &GetNode(m_slots[slot].node).entry;
+
+	u32 idx;
+	if (m_free_head != INVALID)
+	{
+		idx = m_free_head;
+		m_free_head = GetNode(idx).next;
+	}
+	else
+	{
+		if ((m_next_node % NODES_PER_CHUNK) == 0)
+			m_chunks.push_back(std::make_unique<Node[]>(NODES_PER_CHUNK));
+		idx = m_next_node++;
+	}
+
+	Node& node = GetNode(idx);
+	node.entry = entry;
+	node.entry.last_used = m_frame;
+	node.entry.released = false;
+	node.key = key;
+	node.hash = hash;
+	node.index = idx;
+	m_slots[slot] = {hash, idx};
+	m_size++;
+	LinkFront(node);
+	return &node.entry;
+}
+
+void GSTextureCache::HashCacheMap::Erase(HashCacheEntry* entry)
+{
+	Node* node = GetNode(entry);
+	const u32 mask = static_cast<u32>(m_slots.size()) - 1;
+
+	u32 i = GetHomeSlot(node->hash);
+	while (m_slots[i].node != node->index)
+		i = (i + 1) & mask;
+
+	// Backward-shift deletion: pull later members of the probe run into the hole, unless that would move them
+	// before their home slot. Avoids tombstones, so lookups never have to skip over dead slots.
+	for (u32 j = (i + 1) & mask; m_slots[j].node != INVALID; j = (j + 1) & mask)
+	{
+		const u32 home = GetHomeSlot(m_slots[j].hash);
+		if (((j - home) & mask) >= ((j - i) & mask))
+		{
+			m_slots[i] = m_slots[j];
+			i = j;
+		}
+	}
+	m_slots[i].node = INVALID;
+
+	Unlink(*node);
+	node->entry.texture = nullptr;
+	node->next = m_free_head;
+	m_free_head = node->index;
+	m_size--;
+}
+
+void GSTextureCache::HashCacheMap::Touch(HashCacheEntry* entry)
+{
+	Node& node = *GetNode(entry);
+	entry->last_used = m_frame;
+	if (m_lru_head != node.index)
+	{
+		Unlink(node);
+		LinkFront(node);
+	}
+}
+
+GSTextureCache::HashCacheEntry* GSTextureCache::HashCacheMap::GetOldest()
+{
+	return (m_lru_tail != INVALID) ? &GetNode(m_lru_tail).entry : nullptr;
+}
+
+void GSTextureCache::HashCacheMap::Clear()
+{
+	m_chunks.clear();
+	m_slots.clear();
+	m_capacity_bits = 0;
+	m_size = 0;
+	m_free_head = INVALID;
+	m_next_node = 0;
+	m_lru_head = INVALID;
+	m_lru_tail = INVALID;
+}
+
+u32 GSTextureCache::HashCacheMap::FindSlot(const HashCacheKey& key, u64 hash)
+{
+	const u32 mask = static_cast<u32>(m_slots.size()) - 1;
+	for (u32 i = GetHomeSlot(hash);; i = (i + 1) & mask)
+	{
+		const Slot& slot = m_slots[i];
+		if (slot.node == INVALID || (slot.hash == hash && GetNode(slot.node).key == key))
+			return i;
+	}
+}
+
+void GSTextureCache::HashCacheMap::Grow()
+{
+	m_capacity_bits = std::max(m_capacity_bits + 1, MIN_CAPACITY_BITS);
+	m_slots.assign(1u << m_capacity_bits, Slot{0, INVALID});
+
+	const u32 mask = static_cast<u32>(m_slots.size()) - 1;
+	for (u32 idx = m_lru_head; idx != INVALID; idx = GetNode(idx).next)
+	{
+		const Node& node = GetNode(idx);
+		u32 i = GetHomeSlot(node.hash);
+		while (m_slots[i].node != INVALID)
+			i = (i + 1) & mask;
+		m_slots[i] = {node.hash, idx};
+	}
+}
+
+void GSTextureCache::HashCacheMap::LinkFront(Node& node)
+{
+	node.prev = INVALID;
+	node.next = m_lru_head;
+	if (m_lru_head != INVALID)
+		GetNode(m_lru_head).prev = node.index;
+	else
+		m_lru_tail = node.index;
+	m_lru_head = node.index;
+}
+
+void GSTextureCache::HashCacheMap::Unlink(Node& node)
+{
+	if (node.prev != INVALID)
+		GetNode(node.prev).next = node.next;
+	else
+		m_lru_head = node.next;
+
+	if (node.next != INVALID)
+		GetNode(node.next).prev = node.prev;
+	else
+		m_lru_tail = node.prev;
+}
@@ -8,6 +8,7 @@
 #include "GS/Renderers/Common/GSDirtyRect.h"
 
 #include <unordered_set>
+#include <vector>
 #include <utility>
 #include <limits>
 
@@ -127,13 +128,92 @@ public:
 	{
 		GSTexture* texture;
 		u32 refcount;
-		u16 age;
+		u32 last_used;
 		std::pair<u8, u8> alpha_minmax;
 		bool valid_alpha_minmax;
 		bool is_replacement;
+		bool released = false;
+
+		/// Drops a source reference. The entry is moved back to the front of the LRU lazily, when aging reaches it.
+		__fi void Release()
+		{
+			pxAssert(refcount > 0);
+			if ((--refcount) == 0)
+				released = true;
+		}
 	};
 
-	using HashCacheMap = std::unordered_map<HashCacheKey, HashCacheEntry, HashCacheKeyHash>;
+	/// Open-addressed (linear probing) table of hash cache entries, threaded onto an intrusive LRU list.
+	/// Entries live in fixed-size chunks, so HashCacheEntry pointers held by sources stay valid until erased.
+	class HashCacheMap
+	{
+	public:
+		__fi u32 size() const { return m_size; }
+		__fi u32 GetFrame() const { return m_frame; }
+		__fi u32 AdvanceFrame() { return ++m_frame; }
+		__fi u32 GetAge(const HashCacheEntry* entry) const { return m_frame - entry->last_used; }
+
+		HashCacheEntry* Find(const HashCacheKey& key);
+
+		/// Inserts a new entry at the front of the LRU. Returns the existing entry if the key is already present.
+		HashCacheEntry* Insert(const HashCacheKey& key, const HashCacheEntry& entry);
+		void Erase(HashCacheEntry* entry);
+
+		/// Marks the entry as used this frame, moving it to the front of the LRU.
+		void Touch(HashCacheEntry* entry);
+
+		/// Least recently used entry, or null when empty.
+		HashCacheEntry* GetOldest();
+
+		template <typename F>
+		void ForEach(const F& f)
+		{
+			for (u32 idx = m_lru_head; idx != INVALID; idx = GetNode(idx).next)
+				f(&GetNode(idx).entry);
+		}
+
+		void Clear();
+
+	private:
+		static constexpr u32 INVALID = 0xFFFFFFFFu;
+		static constexpr u32 NODES_PER_CHUNK = 256;
+		static constexpr u32 MIN_CAPACITY_BITS = 11;
+
+		struct Node
+		{
+			HashCacheEntry entry; // must be first, entry pointers are cast back to nodes
+			HashCacheKey key;
+			u64 hash;
+			u32 index;
+			u32 prev;
+			u32 next;
+		};
+
+		struct Slot
+		{
+			u64 hash;
+			u32 node;
+		};
+
+		__fi Node& GetNode(u32 idx) { return m_chunks[idx / NODES_PER_CHUNK][idx % NODES_PER_CHUNK]; }
+		__fi static Node* GetNode(HashCacheEntry* entry) { return reinterpret_cast<Node*>(entry); }
+		__fi u32 GetHomeSlot(u64 hash) const { return static_cast<u32>((hash * 0x9E3779B97F4A7C15ULL) >> (64 - m_capacity_bits)); }
+
+		u32 FindSlot(const HashCacheKey& key, u64 hash);
+		void Grow();
+		void LinkFront(Node& node);
+		void Unlink(Node& node);
+
+		std::vector<std::unique_ptr<Node[]>> m_chunks;
+		std::vector<Slot> m_slots;
+		u32 m_capacity_bits = 0;
+		u32 m_size = 0;
+		u32 m_free_head = INVALID;
+		u32 m_next_node = 0;
+		u32 m_lru_head = INVALID;
+		u32 m_lru_tail = INVALID;
+		u32 m_frame = 0;
+	};
 
 	class Surface : public GSAlignedClass<32>
 	{
@@ -252,6 +332,10 @@ public:
 		GSVector4i m_drawn_since_read{};
 		int readbacks_since_draw = 0;
 
+		// Page span currently registered in the texture cache's TargetPageMap, zero count when not registered.
+		u16 m_page_start = 0;
+		u16 m_page_count = 0;
+
 	public:
 		Target(GIFRegTEX0 TEX0, int type, const GSVector2i& unscaled_size, float scale, GSTexture* texture);
 		~Target();
@@ -266,6 +350,9 @@ public:
 		void ResizeValidity(const GSVector4i& rect);
 		void UpdateValidity(const GSVector4i& rect, bool can_resize = true);
 
+		/// Re-registers the target's pages after TBP0 or the end block has been changed directly.
+		void UpdatePages();
+
 		void ScaleRTAlpha();
 		void UnscaleRTAlpha();
 
@@ -378,6 +465,22 @@ public:
 		void RemoveAt(Source* s);
 	};
 
+	/// Number of targets covering each page, so overlap queries can skip walking the target lists
+	/// for ranges which no target touches. Targets register [TBP0, UnwrappedEndBlock()].
+	class TargetPageMap
+	{
+	public:
+		void Add(Target* t);
+		void Remove(Target* t);
+		void Update(Target* t);
+
+		/// Returns true if any target other than exclude covers a page in [start_bp, end_bp].
+		bool HasTargets(u32 start_bp, u32 end_bp, const Target* exclude = nullptr) const;
+
+	private:
+		std::array<u16, GS_MAX_PAGES> m_pages = {};
+	};
+
 	struct TargetHeightElem
 	{
 		union
@@ -436,6 +539,7 @@ protected:
 	u64 m_hash_cache_replacement_memory_usage = 0;
 
 	FastList<Target*> m_dst[2];
+	TargetPageMap m_dst_pages[2];
 	FastList<TargetHeightElem> m_target_heights;
 	u64 m_target_memory_usage = 0;
 
@@ -471,9 +575,13 @@ protected:
 	bool PrepareDownloadTexture(u32 width, u32 height, GSTexture::Format format, std::unique_ptr<GSDownloadTexture>* tex);
 
 	HashCacheEntry* LookupHashCache(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, bool& paltex, const u32* clut, const GSVector2i* lod, SourceRegion region);
-	HashCacheMap::iterator RemoveFromHashCache(HashCacheMap::iterator it);
+	void RemoveFromHashCache(HashCacheEntry* entry);
 	void AgeHashCache();
 
+	/// Evicts unreferenced entries from the LRU end until the cache is within its entry count and VRAM budget,
+	/// and nothing left is older than max_age frames.
+	void TrimHashCache(u32 max_age);
+
 	static void PreloadTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region, GSLocalMemory& mem, bool paltex, GSTexture* tex, u32 level, std::pair<u8, u8>* alpha_minmax);
 	static HashType HashTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region);
 
@@ -528,6 +636,10 @@ public:
 	Target* FindOverlappingTarget(u32 BP, u32 end_bp) const;
 	Target* FindOverlappingTarget(u32 BP, u32 BW, u32 PSM, GSVector4i rc) const;
 
+	/// Returns false if no target of the type can overlap or contain rect at bp, or start at bp.
+	/// Lets lookups skip walking the target list.
+	bool TargetsMayOverlap(int type, u32 bp, u32 bw, u32 psm, const GSVector4i& rect) const;
+
 	GSVector2i GetTargetSize(u32 bp, u32 fbw, u32 psm, s32 min_width, s32 min_height, bool can_expand = true);
 	bool HasTargetInHeightCache(u32 bp, u32 fbw, u32 psm, u32 max_age = std::numeric_limits<u32>::max(), bool move_front = true);
 	bool Has32BitTarget(u32 bp);
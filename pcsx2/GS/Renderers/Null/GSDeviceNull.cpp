@@ -0,0 +1,240 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "GS/Renderers/Null/GSDeviceNull.h"
+#include "GS/Renderers/Null/GSTextureNull.h"
+#include "GS/GSPerfMon.h"
+
+#include <cstring>
+
+GSDeviceNull::GSDeviceNull() = default;
+
+GSDeviceNull::~GSDeviceNull() = default;
+
+RenderAPI GSDeviceNull::GetRenderAPI() const
+{
+	return RenderAPI::None;
+}
+
+bool GSDeviceNull::HasSurface() const
+{
+	return false;
+}
+
+bool GSDeviceNull::Create(GSVSyncMode vsync_mode, bool allow_present_throttle)
+{
+	if (!GSDevice::Create(vsync_mode, allow_present_throttle))
+		return false;
+
+	// Mirror what a typical desktop GPU exposes, so the renderer takes the same paths it would on real hardware.
+	m_name = "Null";
+	m_max_texture_size = 16384;
+	m_features.broken_point_sampler = false;
+	m_features.vs_expand = !GSConfig.DisableVertexShaderExpand;
+	m_features.primitive_id = true;
+	m_features.texture_barrier = GSConfig.OverrideTextureBarriers != 0;
+	m_features.multidraw_fb_copy = false;
+	m_features.provoking_vertex_last = true;
+	m_features.point_expand = false;
+	m_features.line_expand = false;
+	m_features.prefer_new_textures = false;
+	m_features.dxt_textures = true;
+	m_features.bptc_textures = true;
+	m_features.framebuffer_fetch = false;
+	m_features.stencil_buffer = true;
+	m_features.cas_sharpening = true;
+	m_features.test_and_sample_depth = m_features.texture_barrier;
+	return true;
+}
+
+void GSDeviceNull::Destroy()
+{
+	GSDevice::Destroy();
+
+	m_upload_buffer.reset();
+	m_upload_buffer_size = 0;
+}
+
+bool GSDeviceNull::UpdateWindow()
+{
+	return true;
+}
+
+void GSDeviceNull::ResizeWindow(u32 new_window_width, u32 new_window_height, float new_window_scale)
+{
+	m_window_info.surface_width = new_window_width;
+	m_window_info.surface_height = new_window_height;
+	m_window_info.surface_scale = new_window_scale;
+}
+
+bool GSDeviceNull::SupportsExclusiveFullscreen() const
+{
+	return false;
+}
+
+void GSDeviceNull::DestroySurface()
+{
+}
+
+std::string GSDeviceNull::GetDriverInfo() const
+{
+	return "Null device, nothing is rendered.";
+}
+
+void GSDeviceNull::SetVSyncMode(GSVSyncMode mode, bool allow_present_throttle)
+{
+	m_vsync_mode = mode;
+	m_allow_present_throttle = allow_present_throttle;
+}
+
+GSDevice::PresentResult GSDeviceNull::BeginPresent(bool frame_skip)
+{
+	// There's nowhere to present to.
+	return PresentResult::FrameSkipped;
+}
+
+void GSDeviceNull::EndPresent()
+{
+}
+
+bool GSDeviceNull::SetGPUTimingEnabled(bool enabled)
+{
+	return false;
+}
+
+float GSDeviceNull::GetAndResetAccumulatedGPUTime()
+{
+	return 0.0f;
+}
+
+GSTexture* GSDeviceNull::CreateSurface(GSTexture::Type type, int width, int height, int levels, GSTexture::Format format)
+{
+	return new GSTextureNull(type, width, height, levels, format);
+}
+
+std::unique_ptr<GSDownloadTexture> GSDeviceNull::CreateDownloadTexture(u32 width, u32 height, GSTexture::Format format)
+{
+	return GSDownloadTextureNull::Create(width, height, format);
+}
+
+void GSDeviceNull::UploadToScratch(const void* data, u32 size)
+{
+	if (m_upload_buffer_size < size)
+	{
+		m_upload_buffer = std::make_unique<u8[]>(size);
+		m_upload_buffer_size = size;
+	}
+
+	std::memcpy(m_upload_buffer.get(), data, size);
+}
+
+void GSDeviceNull::CopyRect(GSTexture* sTex, GSTexture* dTex, const GSVector4i& r, u32 destX, u32 destY)
+{
+	g_perfmon.Put(GSPerfMon::TextureCopies, 1);
+	dTex->SetState(GSTexture::State::Dirty);
+}
+
+void GSDeviceNull::DoStretchRect(GSTexture* sTex, const GSVector4& sRect, GSTexture* dTex, const GSVector4& dRect,
+	GSHWDrawConfig::ColorMaskSelector cms, ShaderConvert shader, bool linear)
+{
+	g_perfmon.Put(GSPerfMon::DrawCalls, 1);
+	if (dTex)
+		dTex->SetState(GSTexture::State::Dirty);
+}
+
+void GSDeviceNull::PresentRect(GSTexture* sTex, const GSVector4& sRect, GSTexture* dTex, const GSVector4& dRect,
+	PresentShader shader, float shaderTime, bool linear)
+{
+	g_perfmon.Put(GSPerfMon::DrawCalls, 1);
+	if (dTex)
+		dTex->SetState(GSTexture::State::Dirty);
+}
+
+void GSDeviceNull::DoMerge(GSTexture* sTex[3], GSVector4* sRect, GSTexture* dTex, GSVector4* dRect,
+	const GSRegPMODE& PMODE, const GSRegEXTBUF& EXTBUF, u32 c, const bool linear)
+{
+	g_perfmon.Put(GSPerfMon::DrawCalls, 1);
+	dTex->SetState(GSTexture::State::Dirty);
+}
+
+void GSDeviceNull::DoInterlace(GSTexture* sTex, const GSVector4& sRect, GSTexture* dTex, const GSVector4& dRect,
+	ShaderInterlace shader, bool linear, const InterlaceConstantBuffer& cb)
+{
+	g_perfmon.Put(GSPerfMon::DrawCalls, 1);
+	dTex->SetState(GSTexture::State::Dirty);
+}
+
+void GSDeviceNull::DoFXAA(GSTexture* sTex, GSTexture* dTex)
+{
+	g_perfmon.Put(GSPerfMon::DrawCalls, 1);
+	dTex->SetState(GSTexture::State::Dirty);
+}
+
+void GSDeviceNull::DoShadeBoost(GSTexture* sTex, GSTexture* dTex, const float params[4])
+{
+	g_perfmon.Put(GSPerfMon::DrawCalls, 1);
+	dTex->SetState(GSTexture::State::Dirty);
+}
+
+bool GSDeviceNull::DoCAS(GSTexture* sTex, GSTexture* dTex, bool sharpen_only, const std::array<u32, NUM_CAS_CONSTANTS>& constants)
+{
+	dTex->SetState(GSTexture::State::Dirty);
+	return true;
+}
+
+void GSDeviceNull::UpdateCLUTTexture(GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, GSTexture* dTex, u32 dOffset, u32 dSize)
+{
+	g_perfmon.Put(GSPerfMon::DrawCalls, 1);
+	dTex->SetState(GSTexture::State::Dirty);
+}
+
+void GSDeviceNull::ConvertToIndexedTexture(GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, u32 SBW, u32 SPSM,
+	GSTexture* dTex, u32 DBW, u32 DPSM)
+{
+	g_perfmon.Put(GSPerfMon::DrawCalls, 1);
+	dTex->SetState(GSTexture::State::Dirty);
+}
+
+void GSDeviceNull::FilteredDownsampleTexture(GSTexture* sTex, GSTexture* dTex, u32 downsample_factor, const GSVector2i& clamp_min, const GSVector4& dRect)
+{
+	g_perfmon.Put(GSPerfMon::DrawCalls, 1);
+	dTex->SetState(GSTexture::State::Dirty);
+}
+
+void GSDeviceNull::RenderHW(GSHWDrawConfig& config)
+{
+	UploadToScratch(config.verts, config.nverts * sizeof(GSVertex));
+	UploadToScratch(config.indices, config.nindices * sizeof(u16));
+
+	// Count draws and barriers the way a device with texture barriers would issue them.
+	u32 draws = 1;
+	if (config.require_full_barrier && config.drawlist)
+		draws = static_cast<u32>(config.drawlist->size());
+	if (config.alpha_second_pass.enable)
+		draws *= 2;
+
+	g_perfmon.Put(GSPerfMon::DrawCalls, draws);
+	if (config.require_full_barrier || config.require_one_barrier)
+		g_perfmon.Put(GSPerfMon::Barriers, (config.require_full_barrier && config.drawlist) ? draws : 1);
+
+	if (config.rt)
+		config.rt->SetState(GSTexture::State::Dirty);
+	if (config.ds)
+		config.ds->SetState(GSTexture::State::Dirty);
+}
+
+void GSDeviceNull::ClearSamplerCache()
+{
+}
+
+void GSDeviceNull::PushDebugGroup(const char* fmt, ...)
+{
+}
+
+void GSDeviceNull::PopDebugGroup()
+{
+}
+
+void GSDeviceNull::InsertDebugMessage(DebugMessageCategory category, const char* fmt, ...)
+{
+}
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "GS/Renderers/Common/GSDevice.h"
+
+#include <memory>
+
+/// Headless device for the hardware renderer. Textures have no storage and draws/copies are only counted, so
+/// everything on the CPU side (GSRendererHW, the texture cache, hacks, vertex processing) runs without a GPU.
+class GSDeviceNull final : public GSDevice
+{
+private:
+	// Stands in for the vertex/index stream buffers, so the upload copy is still paid for.
+	std::unique_ptr<u8[]> m_upload_buffer;
+	u32 m_upload_buffer_size = 0;
+
+	GSTexture* CreateSurface(GSTexture::Type type, int width, int height, int levels, GSTexture::Format format) override;
+
+	void DoMerge(GSTexture* sTex[3], GSVector4* sRect, GSTexture* dTex, GSVector4* dRect, const GSRegPMODE& PMODE, const GSRegEXTBUF& EXTBUF, u32 c, const bool linear) override;
+	void DoInterlace(GSTexture* sTex, const GSVector4& sRect, GSTexture* dTex, const GSVector4& dRect, ShaderInterlace shader, bool linear, const InterlaceConstantBuffer& cb) override;
+	void DoFXAA(GSTexture* sTex, GSTexture* dTex) override;
+	void DoShadeBoost(GSTexture* sTex, GSTexture* dTex, const float params[4]) override;
+	bool DoCAS(GSTexture* sTex, GSTexture* dTex, bool sharpen_only, const std::array<u32, NUM_CAS_CONSTANTS>& constants) override;
+
+	void DoStretchRect(GSTexture* sTex, const GSVector4& sRect, GSTexture* dTex, const GSVector4& dRect,
+		GSHWDrawConfig::ColorMaskSelector cms, ShaderConvert shader, bool linear) override;
+
+	void UploadToScratch(const void* data, u32 size);
+
+public:
+	GSDeviceNull();
+	~GSDeviceNull() override;
+
+	RenderAPI GetRenderAPI() const override;
+	bool HasSurface() const override;
+
+	bool Create(GSVSyncMode vsync_mode, bool allow_present_throttle) override;
+	void Destroy() override;
+
+	bool UpdateWindow() override;
+	void ResizeWindow(u32 new_window_width, u32 new_window_height, float new_window_scale) override;
+	bool SupportsExclusiveFullscreen() const override;
+	void DestroySurface() override;
+	std::string GetDriverInfo() const override;
+
+	void SetVSyncMode(GSVSyncMode mode, bool allow_present_throttle) override;
+
+	PresentResult BeginPresent(bool frame_skip) override;
+	void EndPresent() override;
+
+	bool SetGPUTimingEnabled(bool enabled) override;
+	float GetAndResetAccumulatedGPUTime() override;
+
+	std::unique_ptr<GSDownloadTexture> CreateDownloadTexture(u32 width, u32 height, GSTexture::Format format) override;
+
+	void CopyRect(GSTexture* sTex, GSTexture* dTex, const GSVector4i& r, u32 destX, u32 destY) override;
+
+	void PushDebugGroup(const char* fmt, ...) override;
+	void PopDebugGroup() override;
+	void InsertDebugMessage(DebugMessageCategory category, const char* fmt, ...) override;
+
+	void PresentRect(GSTexture* sTex, const GSVector4& sRect, GSTexture* dTex, const GSVector4& dRect, PresentShader shader, float shaderTime, bool linear) override;
+	void UpdateCLUTTexture(GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, GSTexture* dTex, u32 dOffset, u32 dSize) override;
+	void ConvertToIndexedTexture(GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, u32 SBW, u32 SPSM, GSTexture* dTex, u32 DBW, u32 DPSM) override;
+	void FilteredDownsampleTexture(GSTexture* sTex, GSTexture* dTex, u32 downsample_factor, const GSVector2i& clamp_min, const GSVector4& dRect) override;
+
+	void RenderHW(GSHWDrawConfig& config) override;
+
+	void ClearSamplerCache() override;
+};
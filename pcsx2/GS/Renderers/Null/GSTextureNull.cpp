@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "GS/Renderers/Null/GSTextureNull.h"
+#include "GS/GSPerfMon.h"
+
+#include "common/Assertions.h"
+
+#include <cstring>
+
+// Shared by every mapped texture, only one texture can be mapped at a time.
+static std::unique_ptr<u8[]> s_map_buffer;
+static u32 s_map_buffer_size = 0;
+
+GSTextureNull::GSTextureNull(Type type, int width, int height, int levels, Format format)
+{
+	m_type = type;
+	m_format = format;
+	m_size.x = width;
+	m_size.y = height;
+	m_mipmap_levels = levels;
+}
+
+GSTextureNull::~GSTextureNull() = default;
+
+void* GSTextureNull::GetNativeHandle() const
+{
+	return const_cast<GSTextureNull*>(this);
+}
+
+bool GSTextureNull::Update(const GSVector4i& r, const void* data, int pitch, int layer)
+{
+	pxAssert(layer < m_mipmap_levels);
+	g_perfmon.Put(GSPerfMon::TextureUploads, 1);
+	m_needs_mipmaps_generated |= (layer == 0);
+	return true;
+}
+
+bool GSTextureNull::Map(GSMap& m, const GSVector4i* r, int layer)
+{
+	pxAssert(layer < m_mipmap_levels);
+
+	const GSVector4i rect = r ? *r : GetRect();
+	const u32 pitch = CalcUploadPitch(static_cast<u32>(rect.width()));
+	const u32 size = CalcUploadSize(static_cast<u32>(rect.height()), pitch);
+	if (s_map_buffer_size < size)
+	{
+		s_map_buffer = std::make_unique<u8[]>(size);
+		s_map_buffer_size = size;
+	}
+
+	m.bits = s_map_buffer.get();
+	m.pitch = static_cast<int>(pitch);
+	m_needs_mipmaps_generated |= (layer == 0);
+	return true;
+}
+
+void GSTextureNull::Unmap()
+{
+	g_perfmon.Put(GSPerfMon::TextureUploads, 1);
+}
+
+void GSTextureNull::GenerateMipmap()
+{
+}
+
+#ifdef PCSX2_DEVBUILD
+
+void GSTextureNull::SetDebugName(std::string_view name)
+{
+}
+
+#endif
+
+GSDownloadTextureNull::GSDownloadTextureNull(u32 width, u32 height, GSTexture::Format format)
+	: GSDownloadTexture(width, height, format)
+{
+}
+
+GSDownloadTextureNull::~GSDownloadTextureNull() = default;
+
+std::unique_ptr<GSDownloadTextureNull> GSDownloadTextureNull::Create(u32 width, u32 height, GSTexture::Format format)
+{
+	std::unique_ptr<GSDownloadTextureNull> dl(new GSDownloadTextureNull(width, height, format));
+	const u32 buffer_size = GetBufferSize(width, height, format);
+	dl->m_buffer = std::make_unique<u8[]>(buffer_size);
+	std::memset(dl->m_buffer.get(), 0, buffer_size);
+
+	// Always mapped, like a persistent mapping.
+	dl->m_map_pointer = dl->m_buffer.get();
+	return dl;
+}
+
+void GSDownloadTextureNull::CopyFromTexture(
+	const GSVector4i& drc, GSTexture* stex, const GSVector4i& src, u32 src_level, bool use_transfer_pitch)
+{
+	pxAssert(stex->GetFormat() == m_format);
+	pxAssert(drc.width() == src.width() && drc.height() == src.height());
+	pxAssert(static_cast<u32>(drc.z) <= m_width && static_cast<u32>(drc.w) <= m_height);
+	pxAssert((drc.left == 0 && drc.top == 0) || !use_transfer_pitch);
+
+	m_current_pitch = GetTransferPitch(use_transfer_pitch ? static_cast<u32>(drc.width()) : m_width, 1);
+	m_needs_flush = true;
+	g_perfmon.Put(GSPerfMon::Readbacks, 1);
+}
+
+bool GSDownloadTextureNull::Map(const GSVector4i& read_rc)
+{
+	return true;
+}
+
+void GSDownloadTextureNull::Unmap()
+{
+}
+
+void GSDownloadTextureNull::Flush()
+{
+	m_needs_flush = false;
+}
+
+#ifdef PCSX2_DEVBUILD
+
+void GSDownloadTextureNull::SetDebugName(std::string_view name)
+{
+}
+
+#endif
@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "GS/Renderers/Common/GSTexture.h"
+
+#include <memory>
+
+/// Texture with no backing storage. Uploads are accepted and dropped, maps hand out a shared scratch buffer.
+class GSTextureNull final : public GSTexture
+{
+public:
+	GSTextureNull(Type type, int width, int height, int levels, Format format);
+	~GSTextureNull() override;
+
+	void* GetNativeHandle() const override;
+
+	bool Update(const GSVector4i& r, const void* data, int pitch, int layer = 0) override;
+	bool Map(GSMap& m, const GSVector4i* r = nullptr, int layer = 0) override;
+	void Unmap() override;
+	void GenerateMipmap() override;
+
+#ifdef PCSX2_DEVBUILD
+	void SetDebugName(std::string_view name) override;
+#endif
+};
+
+/// Download texture which reads back zeros, since nothing is ever rendered.
+class GSDownloadTextureNull final : public GSDownloadTexture
+{
+public:
+	~GSDownloadTextureNull() override;
+
+	static std::unique_ptr<GSDownloadTextureNull> Create(u32 width, u32 height, GSTexture::Format format);
+
+	void CopyFromTexture(const GSVector4i& drc, GSTexture* stex, const GSVector4i& src, u32 src_level, bool use_transfer_pitch) override;
+
+	bool Map(const GSVector4i& read_rc) override;
+	void Unmap() override;
+
+	void Flush() override;
+
+#ifdef PCSX2_DEVBUILD
+	void SetDebugName(std::string_view name) override;
+#endif
+
+private:
+	GSDownloadTextureNull(u32 width, u32 height, GSTexture::Format format);
+
+	std::unique_ptr<u8[]> m_buffer;
+};
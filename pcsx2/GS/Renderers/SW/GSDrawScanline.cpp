@@ -5,8 +5,10 @@
 #include "GS/Renderers/SW/GSTextureCacheSW.h"
 #include "GS/Renderers/SW/GSScanlineEnvironment.h"
 #include "GS/Renderers/SW/GSRasterizer.h"
+#include "GS/GSUtil.h"
 
 #include "common/Console.h"
+#include "common/Threading.h"
 
 #include <fstream>
 
@@ -28,14 +30,20 @@ static __forceinline const GSScanlineGlobalData& GlobalFromLocal(const GSScanlin
 GSDrawScanline::GSDrawScanline()
 	: m_sp_map("GSSetupPrim")
 	, m_ds_map("GSDrawScanline")
+	, m_profiling(GSConfig.SWSelectorProfiling)
 {
 	GSCodeReserve::ResetMemory();
 }
 
 GSDrawScanline::~GSDrawScanline()
 {
+	StopPrecompile();
+
 	if (const size_t used = GSCodeReserve::GetMemoryUsed(); used > 0)
+	{
 		DevCon.WriteLn("SW JIT generated %zu bytes of code", used);
+		PrintCompileStats();
+	}
 }
 
 bool GSDrawScanline::ShouldUseCDrawScanline(u64 key)
@@ -114,17 +122,56 @@ void GSDrawScanline::BeginDraw(const GSRasterizerData& data, GSScanlineLocalData
 
 void GSDrawScanline::ResetCodeCache()
 {
+	std::unique_lock<std::mutex> lock(m_precompile_mutex, std::defer_lock);
+	if (m_precompile_active.load(std::memory_order_acquire))
+		lock.lock();
+
 	Console.Warning("GS Software JIT cache overflow, resetting.");
 	m_sp_map.Clear();
 	m_ds_map.Clear();
 	GSCodeReserve::ResetMemory();
 }
 
+GSScanlineSelector GSDrawScanline::GetSetupPrimSelector(const GSScanlineSelector& global_sel)
+{
+	// doesn't need all bits => less functions generated
+
+	GSScanlineSelector sel;
+
+	sel.key = 0;
+
+	sel.iip = global_sel.iip;
+	sel.tfx = global_sel.tfx;
+	sel.tcc = global_sel.tcc;
+	sel.fst = global_sel.fst;
+	sel.fge = global_sel.fge;
+	sel.prim = global_sel.prim;
+	sel.fb = global_sel.fb;
+	sel.zb = global_sel.zb;
+	sel.zoverflow = global_sel.zoverflow;
+	sel.zequal = global_sel.zequal;
+	sel.notest = global_sel.notest;
+
+	return sel;
+}
+
 bool GSDrawScanline::SetupDraw(GSRasterizerData& data)
 {
 	const GSScanlineGlobalData& global = data.global;
 
+	if (m_profiling) [[unlikely]]
+	{
+		SelectorProfile& p = m_profile_draws[global.sel.key];
+		p.draws++;
+		p.prims += (data.index ? data.index_count : data.vertex_count) / GSUtil::GetClassVertexCount(data.primclass);
+	}
+
 #ifdef ENABLE_JIT_RASTERIZER
+	// The precompile thread shares the maps and code buffer, but once it's done we don't need to pay for the lock.
+	std::unique_lock<std::mutex> lock(m_precompile_mutex, std::defer_lock);
+	if (m_precompile_active.load(std::memory_order_acquire)) [[unlikely]]
+		lock.lock();
+
 	data.draw_scanline = m_ds_map[global.sel];
 	if (!data.draw_scanline) [[unlikely]]
 		return false;
@@ -146,25 +193,7 @@ bool GSDrawScanline::SetupDraw(GSRasterizerData& data)
 		data.draw_edge = nullptr;
 	}
 
-	// doesn't need all bits => less functions generated
-
-	GSScanlineSelector sel;
-
-	sel.key = 0;
-
-	sel.iip = global.sel.iip;
-	sel.tfx = global.sel.tfx;
-	sel.tcc = global.sel.tcc;
-	sel.fst = global.sel.fst;
-	sel.fge = global.sel.fge;
-	sel.prim = global.sel.prim;
-	sel.fb = global.sel.fb;
-	sel.zb = global.sel.zb;
-	sel.zoverflow = global.sel.zoverflow;
-	sel.zequal = global.sel.zequal;
-	sel.notest = global.sel.notest;
-
-	return (data.setup_prim = m_sp_map[sel]) != nullptr;
+	return (data.setup_prim = m_sp_map[GetSetupPrimSelector(global.sel)]) != nullptr;
 #else
 	data.setup_prim = &GSDrawScanline::CSetupPrim;
 	data.draw_scanline = &GSDrawScanline::CDrawScanline;
@@ -181,6 +210,169 @@ void GSDrawScanline::UpdateDrawStats(u64 frame, u64 ticks, int actual, int total
 void GSDrawScanline::PrintStats()
 {
 	m_ds_map.PrintStats();
+	PrintCompileStats();
+}
+
+void GSDrawScanline::PrintCompileStats() const
+{
+	const DrawScanlineMap::CompileStats& ds = m_ds_map.GetCompileStats();
+	const SetupPrimMap::CompileStats& sp = m_sp_map.GetCompileStats();
+	const double tick_ms = 1000.0 / GetTickFrequency();
+
+	const u32 hits = ds.precompile_hits + sp.precompile_hits;
+	const u32 first_uses = hits + ds.compiled + sp.compiled;
+	if (first_uses == 0)
+		return;
+
+	DevCon.WriteLn("SW JIT: %u/%u selectors were precompiled (%.1f%% hit rate), %u precompiled in %.2f ms, "
+				   "%u compiled on demand in %.2f ms",
+		hits, first_uses, (hits * 100.0) / first_uses, ds.precompiled + sp.precompiled,
+		(ds.precompile_ticks + sp.precompile_ticks) * tick_ms, ds.compiled + sp.compiled,
+		(ds.compile_ticks + sp.compile_ticks) * tick_ms);
+}
+
+void GSDrawScanline::PrintSelectorProfile(SelectorProfileMap profile) const
+{
+	for (const auto& [key, p] : m_profile_draws)
+	{
+		profile[key].draws += p.draws;
+		profile[key].prims += p.prims;
+	}
+
+	u64 total_ticks = 0;
+	for (const auto& [key, p] : profile)
+		total_ticks += p.ticks;
+	if (total_ticks == 0)
+		return;
+
+	const double tick_ms = 1000.0 / GetTickFrequency();
+	const double tick_ns = 1000000000.0 / GetTickFrequency();
+	const auto pct = [total_ticks](u64 ticks) { return (ticks * 100.0) / total_ticks; };
+
+	using SortedProfile = std::vector<std::pair<u64, SelectorProfile>>;
+	const auto sort_by_ticks = [](SortedProfile& sorted) {
+		std::sort(sorted.begin(), sorted.end(), [](const auto& l, const auto& r) { return l.second.ticks > r.second.ticks; });
+	};
+
+	SortedProfile sorted(profile.begin(), profile.end());
+	sort_by_ticks(sorted);
+
+	Console.WriteLn("SW selector profile: %zu scanline selectors, %.2f ms rasterizing", sorted.size(), total_ticks * tick_ms);
+	Console.WriteLn("      key        |   time  |  ms    |  draws  |   prims   |   pixels   | ns/px | selector");
+	for (const auto& [key, p] : sorted)
+	{
+		Console.WriteLn("%016" PRIx64 " | %6.2f%% | %6.1f | %7" PRIu64 " | %9" PRIu64 " | %10" PRIu64 " | %5.2f | %s",
+			key, pct(p.ticks), p.ticks * tick_ms, p.draws, p.prims, p.pixels,
+			p.pixels ? (p.ticks * tick_ns) / p.pixels : 0.0, GSScanlineSelector(key).to_string().c_str());
+	}
+
+	// Setup functions run inside the draw, so these are totals for the draws which used each of them.
+	SelectorProfileMap sp_profile;
+	for (const auto& [key, p] : profile)
+	{
+		SelectorProfile& sp = sp_profile[GetSetupPrimSelector(GSScanlineSelector(key)).key];
+		sp.ticks += p.ticks;
+		sp.draws += p.draws;
+		sp.prims += p.prims;
+		sp.pixels += p.pixels;
+	}
+
+	SortedProfile sp_sorted(sp_profile.begin(), sp_profile.end());
+	sort_by_ticks(sp_sorted);
+
+	Console.WriteLn("SW setup selector profile (inclusive of scanline time):");
+	for (const auto& [key, p] : sp_sorted)
+	{
+		const GSScanlineSelector sel(key);
+		Console.WriteLn("%016" PRIx64 " | %6.2f%% | %6.1f | %7" PRIu64 " | %9" PRIu64 " | %10" PRIu64 " | "
+						"prim:%d iip:%d tfx:%d tcc:%d fst:%d fge:%d fb:%d zb:%d zoverflow:%d zequal:%d notest:%d",
+			key, pct(p.ticks), p.ticks * tick_ms, p.draws, p.prims, p.pixels, sel.prim, sel.iip, sel.tfx, sel.tcc,
+			sel.fst, sel.fge, sel.fb, sel.zb, sel.zoverflow, sel.zequal, sel.notest);
+	}
+
+	// Time spent in draws which had each feature enabled. They overlap, so this doesn't sum to 100%.
+	static constexpr const char* feature_names[] = {"texture", "bilinear", "mipmap", "fst", "fog", "alpha test",
+		"alpha blend", "dither", "date", "zbuffer", "ztest", "aa1", "clut"};
+	u64 feature_ticks[std::size(feature_names)] = {};
+	for (const auto& [key, p] : profile)
+	{
+		const GSScanlineSelector sel(key);
+		const bool features[] = {sel.tfx != TFX_NONE, sel.ltf != 0, sel.mmin != 0, sel.fst != 0, sel.fge != 0,
+			sel.atst != ATST_ALWAYS, sel.abe != 0, sel.dthe != 0, sel.date != 0, sel.zb != 0, sel.ztest != 0,
+			sel.aa1 != 0, sel.tlu != 0};
+		static_assert(std::size(features) == std::size(feature_names));
+		for (size_t i = 0; i < std::size(features); i++)
+			feature_ticks[i] += features[i] ? p.ticks : 0;
+	}
+
+	Console.WriteLn("SW pipeline feature profile:");
+	for (size_t i = 0; i < std::size(feature_names); i++)
+		Console.WriteLn("  %-12s %6.2f%% %8.1f ms", feature_names[i], pct(feature_ticks[i]), feature_ticks[i] * tick_ms);
+}
+
+void GSDrawScanline::BeginPrecompile(std::vector<u64> ds_keys, std::vector<u64> sp_keys)
+{
+	StopPrecompile();
+
+#ifdef ENABLE_JIT_RASTERIZER
+	if (ds_keys.empty() && sp_keys.empty())
+		return;
+
+	m_precompile_cancel.store(false, std::memory_order_relaxed);
+	m_precompile_active.store(true, std::memory_order_release);
+	m_precompile_thread = std::thread(&GSDrawScanline::PrecompileThread, this, std::move(ds_keys), std::move(sp_keys));
+#endif
+}
+
+void GSDrawScanline::StopPrecompile()
+{
+	if (!m_precompile_thread.joinable())
+		return;
+
+	m_precompile_cancel.store(true, std::memory_order_relaxed);
+	m_precompile_thread.join();
+}
+
+void GSDrawScanline::PrecompileThread(std::vector<u64> ds_keys, std::vector<u64> sp_keys)
+{
+	Threading::SetNameOfCurrentThread("GS-SW-Precompile");
+
+	// Leave plenty of room for selectors which aren't in the list, a cache reset in the middle of a frame is
+	// worse than not having precompiled everything.
+	static constexpr size_t RESERVED_CODE_SPACE = 16 * 1024 * 1024;
+
+	const auto compile = [this](auto& map, u64 key) {
+		std::unique_lock<std::mutex> lock(m_precompile_mutex);
+		if (m_precompile_cancel.load(std::memory_order_relaxed) ||
+			GSCodeReserve::GetMemoryAvailable() < RESERVED_CODE_SPACE)
+		{
+			return false;
+		}
+
+		map.Precompile(key);
+		return true;
+	};
+
+	// Every draw needs a setup function, and there's far fewer of them, so do those first.
+	bool running = true;
+	for (size_t i = 0; running && i < sp_keys.size(); i++)
+		running = compile(m_sp_map, sp_keys[i]);
+	for (size_t i = 0; running && i < ds_keys.size(); i++)
+		running = compile(m_ds_map, ds_keys[i]);
+
+	m_precompile_active.store(false, std::memory_order_release);
+}
+
+void GSDrawScanline::GetUsedSelectors(std::vector<u64>* ds_keys, std::vector<u64>* sp_keys) const
+{
+	m_ds_map.GetUsedKeys(ds_keys);
+	m_sp_map.GetUsedKeys(sp_keys);
+}
+
+void GSDrawScanline::ResetUsedSelectors()
+{
+	m_ds_map.NextEpoch();
+	m_sp_map.NextEpoch();
 }
 
 #if _M_SSE >= 0x501
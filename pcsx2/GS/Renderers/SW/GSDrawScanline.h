@@ -14,6 +14,10 @@
 #include "GS/Renderers/SW/GSDrawScanlineCodeGenerator.arm64.h"
 #endif
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 struct GSScanlineLocalData;
 
 MULTI_ISA_UNSHARED_START
@@ -32,6 +36,16 @@ public:
 	/// Debug override for disabling scanline JIT on a key basis.
 	static bool ShouldUseCDrawScanline(u64 key);
 
+	/// Per-selector totals, collected when GSConfig.SWSelectorProfiling is set.
+	struct SelectorProfile
+	{
+		u64 ticks;
+		u64 draws;
+		u64 prims;
+		u64 pixels;
+	};
+	using SelectorProfileMap = std::unordered_map<u64, SelectorProfile>;
+
 	/// Function pointer types which we call back into.
 	using SetupPrimPtr = void(*)(const GSVertexSW* vertex, const u16* index, const GSVertexSW& dscan, GSScanlineLocalData& local);
 	using DrawScanlinePtr = void(*)(int pixels, int left, int top, const GSVertexSW& scan, GSScanlineLocalData& local);
@@ -51,9 +65,57 @@ public:
 	void UpdateDrawStats(u64 frame, u64 ticks, int actual, int total, int prims);
 	void PrintStats();
 
+	/// Returns the setup-prim selector used for draws with the given scanline selector.
+	static GSScanlineSelector GetSetupPrimSelector(const GSScanlineSelector& sel);
+
+	__fi bool IsProfiling() const { return m_profiling; }
+
+	/// Logs where rasterization time went, by scanline selector, setup selector and pipeline feature.
+	/// The profile holds the ticks/pixels accumulated by the rasterizers, draw and prim counts are added here.
+	void PrintSelectorProfile(SelectorProfileMap profile) const;
+
+	/// Compiles the given selectors on a background thread, so the first draws using them don't stall on the JIT.
+	/// Draws issued in the meantime compile anything they need which hasn't been reached yet themselves.
+	void BeginPrecompile(std::vector<u64> ds_keys, std::vector<u64> sp_keys);
+
+	/// Cancels and waits for any background compilation started by BeginPrecompile().
+	void StopPrecompile();
+
+	/// Spans and pixels skipped by hierarchical Z, added by the rasterizers at the end of each draw.
+	void AddHiZRejected(u64 spans, u64 pixels)
+	{
+		m_hiz_rejected_spans.fetch_add(spans, std::memory_order_relaxed);
+		m_hiz_rejected_pixels.fetch_add(pixels, std::memory_order_relaxed);
+	}
+	u64 GetHiZRejectedSpans() const { return m_hiz_rejected_spans.load(std::memory_order_relaxed); }
+	u64 GetHiZRejectedPixels() const { return m_hiz_rejected_pixels.load(std::memory_order_relaxed); }
+
+	/// Returns the selectors drawn with since the last ResetUsedSelectors().
+	void GetUsedSelectors(std::vector<u64>* ds_keys, std::vector<u64>* sp_keys) const;
+	void ResetUsedSelectors();
+
 private:
-	GSCodeGeneratorFunctionMap<GSSetupPrimCodeGenerator, u64, SetupPrimPtr> m_sp_map;
-	GSCodeGeneratorFunctionMap<GSDrawScanlineCodeGenerator, u64, DrawScanlinePtr> m_ds_map;
+	using SetupPrimMap = GSCodeGeneratorFunctionMap<GSSetupPrimCodeGenerator, u64, SetupPrimPtr>;
+	using DrawScanlineMap = GSCodeGeneratorFunctionMap<GSDrawScanlineCodeGenerator, u64, DrawScanlinePtr>;
+
+	SetupPrimMap m_sp_map;
+	DrawScanlineMap m_ds_map;
+
+	// Draws and prims per selector, counted here since each draw can be split across several rasterizers or tiles.
+	SelectorProfileMap m_profile_draws;
+	bool m_profiling;
+
+	// Held by the precompile thread while it generates code, and by the GS thread only while the former is running.
+	std::mutex m_precompile_mutex;
+	std::thread m_precompile_thread;
+	std::atomic_bool m_precompile_active{false};
+	std::atomic_bool m_precompile_cancel{false};
+
+	std::atomic<u64> m_hiz_rejected_spans{0};
+	std::atomic<u64> m_hiz_rejected_pixels{0};
+
+	void PrecompileThread(std::vector<u64> ds_keys, std::vector<u64> sp_keys);
+	void PrintCompileStats() const;
 
 	static void CSetupPrim(const GSVertexSW* vertex, const u16* index, const GSVertexSW& dscan, GSScanlineLocalData& local);
 	static void CDrawScanline(int pixels, int left, int top, const GSVertexSW& scan, GSScanlineLocalData& local);
@@ -38,6 +38,7 @@ GSRasterizer::GSRasterizer(GSDrawScanline* ds, int id, int threads)
 	, m_id(id)
 	, m_threads(threads)
 	, m_scanmsk_value(0)
+	, m_profiling(ds->IsProfiling())
 {
 	memset(&m_pixels, 0, sizeof(m_pixels));
 	m_primcount = 0;
@@ -125,7 +126,16 @@ int GSRasterizer::GetPixels(bool reset)
 
 void GSRasterizer::Draw(GSRasterizerData& data)
 {
-	if ((data.vertex && data.vertex_count == 0) || (data.index && data.index_count == 0))
+	Draw(data, data.scissor, data.index, data.index_count);
+}
+
+void GSRasterizer::Draw(GSRasterizerData& data, const GSVector4i& scissor, const u16* index, int index_count)
+{
+	// Source conversions are covered by the draw's Sync(), so wait for them even if there's nothing to draw.
+	if (data.wait_for_source)
+		data.WaitForSource();
+
+	if ((data.vertex && data.vertex_count == 0) || (index && index_count == 0))
 		return;
 
 	m_pixels.actual = 0;
@@ -135,24 +145,29 @@ void GSRasterizer::Draw(GSRasterizerData& data)
 	if constexpr (ENABLE_DRAW_STATS)
 		data.start = GetCPUTicks();
 
+	const u64 profile_start = m_profiling ? GetCPUTicks() : 0;
+
 	m_setup_prim = data.setup_prim;
 	m_draw_scanline = data.draw_scanline;
 	m_draw_edge = data.draw_edge;
+	m_hiz = data.hiz;
+	m_hiz_tag = data.hiz_tag;
+	m_hiz_limit = data.hiz_limit;
+	m_hiz_block_shift = data.global.zbo.blockShiftX();
 	GSDrawScanline::BeginDraw(data, m_local);
 
 	const GSVertexSW* vertex = data.vertex;
 	const GSVertexSW* vertex_end = data.vertex + data.vertex_count;
 
-	const u16* index = data.index;
-	const u16* index_end = data.index + data.index_count;
+	const u16* index_end = index + index_count;
 
 	static constexpr u16 tmp_index[] = {0, 1, 2};
 
-	bool scissor_test = !data.bbox.eq(data.bbox.rintersect(data.scissor));
+	bool scissor_test = !data.bbox.eq(data.bbox.rintersect(scissor));
 
-	m_scissor = data.scissor;
-	m_fscissor_x = GSVector4(data.scissor).xzxz();
-	m_fscissor_y = GSVector4(data.scissor).ywyw();
+	m_scissor = scissor;
+	m_fscissor_x = GSVector4(scissor).xzxz();
+	m_fscissor_y = GSVector4(scissor).ywyw();
 	m_scanmsk_value = data.scanmsk_value;
 
 	switch (data.primclass)
@@ -161,11 +176,11 @@ void GSRasterizer::Draw(GSRasterizerData& data)
 
 			if (scissor_test)
 			{
-				DrawPoint<true>(vertex, data.vertex_count, index, data.index_count);
+				DrawPoint<true>(vertex, data.vertex_count, index, index_count);
 			}
 			else
 			{
-				DrawPoint<false>(vertex, data.vertex_count, index, data.index_count);
+				DrawPoint<false>(vertex, data.vertex_count, index, index_count);
 			}
 
 			break;
@@ -243,10 +258,34 @@ void GSRasterizer::Draw(GSRasterizerData& data)
 
 	data.pixels = m_pixels.actual;
 
+	if (m_hiz_rejected_spans > 0)
+	{
+		m_ds->AddHiZRejected(m_hiz_rejected_spans, m_hiz_rejected_pixels);
+		m_hiz_rejected_spans = 0;
+		m_hiz_rejected_pixels = 0;
+	}
+
 	m_pixels.sum += m_pixels.actual;
 
 	if constexpr (ENABLE_DRAW_STATS)
 		m_ds->UpdateDrawStats(data.frame, GetCPUTicks() - data.start, m_pixels.actual, m_pixels.total, m_primcount);
+
+	if (m_profiling) [[unlikely]]
+	{
+		GSDrawScanline::SelectorProfile& p = m_profile[data.global.sel.key];
+		p.ticks += GetCPUTicks() - profile_start;
+		p.pixels += m_pixels.actual;
+	}
+}
+
+void GSRasterizer::MergeSelectorProfile(GSDrawScanline::SelectorProfileMap* profile) const
+{
+	for (const auto& [key, p] : m_profile)
+	{
+		GSDrawScanline::SelectorProfile& dst = (*profile)[key];
+		dst.ticks += p.ticks;
+		dst.pixels += p.pixels;
+	}
 }
 
 template <bool scissor_test>
@@ -1425,9 +1464,35 @@ void GSRasterizer::Flush(const GSVertexSW* vertex, const u16* index, const GSVer
 #define PIXELS_PER_LOOP 4
 #endif
 
+bool GSRasterizer::IsHiZOccluded(int pixels, int left, int top) const
+{
+	const GSOffset& zbo = m_local.gd->zbo;
+	const int step = 1 << m_hiz_block_shift;
+	const int right = left + pixels;
+
+	// Bail on the first block which might be visible, that's the common case.
+	for (int x = left & ~(step - 1); x < right; x += step)
+	{
+		const u64 e = m_hiz[zbo.bn(x, top)].load(std::memory_order_relaxed);
+
+		if ((e & 0xFFFFFFFF00000000ULL) != m_hiz_tag || (e & 0xFFFFFFFFULL) < m_hiz_limit)
+			return false;
+	}
+
+	return true;
+}
+
 void GSRasterizer::DrawScanline(int pixels, int left, int top, const GSVertexSW& scan)
 {
 	if ((m_scanmsk_value & 2) && (m_scanmsk_value & 1) == (top & 1)) return;
+
+	if (m_hiz && IsHiZOccluded(pixels, left, top))
+	{
+		m_hiz_rejected_spans++;
+		m_hiz_rejected_pixels += pixels;
+		return;
+	}
+
 	m_pixels.actual += pixels;
 	m_pixels.total += ((left + pixels + (PIXELS_PER_LOOP - 1)) & ~(PIXELS_PER_LOOP - 1)) - (left & ~(PIXELS_PER_LOOP - 1));
 	//m_pixels.total += ((left + pixels + (PIXELS_PER_LOOP - 1)) & ~(PIXELS_PER_LOOP - 1)) - left;
@@ -1494,6 +1559,16 @@ void GSSingleRasterizer::PrintStats()
 #endif
 }
 
+void GSSingleRasterizer::PrintSelectorProfile()
+{
+	if (!m_ds.IsProfiling())
+		return;
+
+	GSDrawScanline::SelectorProfileMap profile;
+	m_r.MergeSelectorProfile(&profile);
+	m_ds.PrintSelectorProfile(std::move(profile));
+}
+
 //
 
 GSRasterizerList::GSRasterizerList(int threads)
@@ -1517,7 +1592,7 @@ GSRasterizerList::~GSRasterizerList()
 	_aligned_free(m_scanline);
 }
 
-void GSRasterizerList::OnWorkerStartup(int i, u64 affinity)
+static void OnWorkerStartup(int i, u64 affinity)
 {
 	Threading::SetNameOfCurrentThread(StringUtil::StdStringFromFormat("GS-SW-%d", i).c_str());
 
@@ -1531,7 +1606,7 @@ void GSRasterizerList::OnWorkerStartup(int i, u64 affinity)
 	PerformanceMetrics::SetGSSWThread(i, std::move(handle));
 }
 
-void GSRasterizerList::OnWorkerShutdown(int i)
+static void OnWorkerShutdown(int i)
 {
 }
 
@@ -1604,6 +1679,11 @@ std::unique_ptr<IRasterizer> GSRasterizerList::Create(int threads)
 		return std::make_unique<GSSingleRasterizer>();
 	}
 
+	if (GSConfig.SWExtraThreadsTiled)
+	{
+		return GSTiledRasterizerList::Create(threads);
+	}
+
 	std::unique_ptr<GSRasterizerList> rl(new GSRasterizerList(threads));
 
 	const std::vector<u32>& procs = VMManager::Internal::GetSoftwareRendererProcessorList();
@@ -1617,9 +1697,11 @@ std::unique_ptr<IRasterizer> GSRasterizerList::Create(int threads)
 		rl->m_r.push_back(std::unique_ptr<GSRasterizer>(new GSRasterizer(&rl->m_ds, i, threads)));
 		auto& r = *rl->m_r[i];
 		rl->m_workers.push_back(std::unique_ptr<GSWorker>(new GSWorker(
-			[i, affinity]() { GSRasterizerList::OnWorkerStartup(i, affinity); },
+			[i, affinity]() { OnWorkerStartup(i, affinity); },
 			[&r](GSRingHeap::SharedPtr<GSRasterizerData>& item) { r.Draw(*item.get()); },
-			[i]() { GSRasterizerList::OnWorkerShutdown(i); })));
+			[i]() { OnWorkerShutdown(i); },
+			GSConfig.SWWorkerWait)));
+		PerformanceMetrics::SetGSSWThreadWaitTimes(i, &rl->m_workers[i]->GetWorkWaitTimes(), &rl->m_workers[i]->GetEmptyWaitTimes());
 	}
 
 	return rl;
@@ -1629,6 +1711,351 @@ void GSRasterizerList::PrintStats()
 {
 }
 
+void GSRasterizerList::PrintSelectorProfile()
+{
+	if (!m_ds.IsProfiling())
+		return;
+
+	Sync();
+
+	GSDrawScanline::SelectorProfileMap profile;
+	for (const auto& r : m_r)
+		r->MergeSelectorProfile(&profile);
+	m_ds.PrintSelectorProfile(std::move(profile));
+}
+
+//
+
+GSTiledRasterizerList::GSTiledRasterizerList(int threads)
+	: m_tiles(std::make_unique<Tile[]>(TILE_COUNT))
+	, m_active_tiles(std::make_unique<u16[]>(TILE_COUNT))
+{
+	PerformanceMetrics::SetGSSWThreadCount(threads);
+}
+
+GSTiledRasterizerList::~GSTiledRasterizerList()
+{
+	// Workers have to go before the tiles they're draining.
+	m_workers.clear();
+
+	PerformanceMetrics::SetGSSWThreadCount(0);
+}
+
+std::unique_ptr<IRasterizer> GSTiledRasterizerList::Create(int threads)
+{
+	std::unique_ptr<GSTiledRasterizerList> rl(new GSTiledRasterizerList(threads));
+
+	const std::vector<u32>& procs = VMManager::Internal::GetSoftwareRendererProcessorList();
+	const bool pin = (EmuConfig.EnableThreadPinning && static_cast<size_t>(threads) <= procs.size());
+	if (EmuConfig.EnableThreadPinning && !pin)
+		WARNING_LOG("Not pinning SW threads, we need {} processors, but only have {}", threads, procs.size());
+
+	for (int i = 0; i < threads; i++)
+	{
+		const u64 affinity = pin ? (static_cast<u64>(1u) << procs[i]) : 0;
+
+		// Every worker owns all scanlines of whichever tile it's drawing, the tile rect is applied through the scissor.
+		rl->m_r.push_back(std::unique_ptr<GSRasterizer>(new GSRasterizer(&rl->m_ds, 0, 1)));
+
+		GSTiledRasterizerList* list = rl.get();
+		rl->m_workers.push_back(std::unique_ptr<GSWorker>(new GSWorker(
+			[i, affinity]() { OnWorkerStartup(i, affinity); },
+			[list, i](int& tile) {
+				list->RunTile(i, tile);
+				list->StealTiles(i);
+			},
+			[i]() { OnWorkerShutdown(i); },
+			GSConfig.SWWorkerWait)));
+		PerformanceMetrics::SetGSSWThreadWaitTimes(i, &rl->m_workers[i]->GetWorkWaitTimes(), &rl->m_workers[i]->GetEmptyWaitTimes());
+	}
+
+	return rl;
+}
+
+void GSTiledRasterizerList::Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data)
+{
+	GSVector4i r = data->bbox.rintersect(data->scissor);
+
+	if (!m_ds.SetupDraw(*data.get())) [[unlikely]]
+	{
+		Sync();
+		m_ds.ResetCodeCache();
+		m_ds.SetupDraw(*data.get());
+	}
+
+	pxAssert(r.top >= 0 && r.top < 2048 && r.bottom >= 0 && r.bottom < 2048);
+
+	// Edge AA can touch one column past the bounding box.
+	r.right = std::min(r.right + 1, data->scissor.right);
+	if (r.rempty())
+		return;
+
+	const GSVector4i tr = GSVector4i(
+		r.left >> TILE_SHIFT, r.top >> TILE_SHIFT,
+		(r.right + TILE_SIZE - 1) >> TILE_SHIFT, (r.bottom + TILE_SIZE - 1) >> TILE_SHIFT);
+
+	// Single tile, or nothing to bin by, push the whole draw.
+	if (!data->index || (tr.width() == 1 && tr.height() == 1))
+	{
+		for (int y = tr.top; y < tr.bottom; y++)
+		{
+			for (int x = tr.left; x < tr.right; x++)
+				PushTile(y * TILES_PER_ROW + x, data, data->index, data->index_count);
+		}
+
+		return;
+	}
+
+	BinPrimitives(*data.get(), tr);
+
+	const int tw = tr.width();
+	for (int y = tr.top; y < tr.bottom; y++)
+	{
+		for (int x = tr.left; x < tr.right; x++)
+		{
+			const int bin = (y - tr.top) * tw + (x - tr.left);
+			const int count = m_bin_offsets[bin + 1] - m_bin_offsets[bin];
+			if (count > 0)
+				PushTile(y * TILES_PER_ROW + x, data, data->binned_index + m_bin_offsets[bin], count);
+		}
+	}
+}
+
+void GSTiledRasterizerList::BinPrimitives(GSRasterizerData& data, const GSVector4i& tr)
+{
+	pxAssert(!data.binned_index);
+
+	int n = 0;
+	switch (data.primclass)
+	{
+		case GS_POINT_CLASS:
+			n = 1;
+			break;
+		case GS_LINE_CLASS:
+		case GS_SPRITE_CLASS:
+			n = 2;
+			break;
+		case GS_TRIANGLE_CLASS:
+			n = 3;
+			break;
+		default:
+			ASSUME(0);
+	}
+
+	const int prims = data.index_count / n;
+	const int tw = tr.width();
+	const int bins = tw * tr.height();
+
+	m_prim_tiles.resize(prims);
+	m_bin_offsets.assign(bins + 1, 0);
+
+	// First pass, work out which tiles each primitive touches and how many indices each tile gets.
+	const GSVertexSW* RESTRICT vertex = data.vertex;
+	const u16* RESTRICT index = data.index;
+	const GSVector4i tile_min = tr.xyxy();
+	const GSVector4i tile_max = tr.zwzw() - GSVector4i::x00000001();
+
+	for (int i = 0; i < prims; i++, index += n)
+	{
+		GSVector4 pmin = vertex[index[0]].p;
+		GSVector4 pmax = pmin;
+		for (int j = 1; j < n; j++)
+		{
+			pmin = pmin.min(vertex[index[j]].p);
+			pmax = pmax.max(vertex[index[j]].p);
+		}
+
+		// Be generous by a pixel on each side, rounding and edge AA can step slightly outside the vertices.
+		const GSVector4i p = GSVector4i(pmin.floor().xyxy(pmax.ceil())) + GSVector4i(-1, -1, 1, 1);
+		const GSVector4i pt = p.sra32<TILE_SHIFT>();
+
+		GSVector4i& t = m_prim_tiles[i];
+		if (pt.z < tr.left || pt.w < tr.top || pt.x >= tr.right || pt.y >= tr.bottom)
+		{
+			// Entirely outside the scissored draw area, doesn't go in any bin.
+			t = GSVector4i(0, 0, -1, -1);
+			continue;
+		}
+
+		t = pt.max_i32(tile_min).min_i32(tile_max);
+		for (int y = t.y; y <= t.w; y++)
+		{
+			for (int x = t.x; x <= t.z; x++)
+				m_bin_offsets[(y - tr.top) * tw + (x - tr.left) + 1] += n;
+		}
+	}
+
+	for (int i = 0; i < bins; i++)
+		m_bin_offsets[i + 1] += m_bin_offsets[i];
+
+	const int total = m_bin_offsets[bins];
+	if (total == 0)
+		return;
+
+	// Second pass, copy the indices out. Primitives are visited in order, so each bin keeps the draw order.
+	u16* RESTRICT binned = static_cast<u16*>(m_bin_heap.alloc(sizeof(u16) * total, 64));
+	data.binned_index = binned;
+
+	m_bin_fill.assign(m_bin_offsets.begin(), m_bin_offsets.end() - 1);
+
+	index = data.index;
+	for (int i = 0; i < prims; i++, index += n)
+	{
+		const GSVector4i& t = m_prim_tiles[i];
+		for (int y = t.y; y <= t.w; y++)
+		{
+			for (int x = t.x; x <= t.z; x++)
+			{
+				int& pos = m_bin_fill[(y - tr.top) * tw + (x - tr.left)];
+				for (int j = 0; j < n; j++)
+					binned[pos++] = index[j];
+			}
+		}
+	}
+}
+
+void GSTiledRasterizerList::PushTile(int tile, const GSRingHeap::SharedPtr<GSRasterizerData>& data, const u16* index, int index_count)
+{
+	Tile& t = m_tiles[tile];
+
+	if (!t.active)
+	{
+		t.active = true;
+		const int count = m_active_tile_count.load(std::memory_order_relaxed);
+		m_active_tiles[count] = static_cast<u16>(tile);
+		m_active_tile_count.store(count + 1, std::memory_order_release);
+	}
+
+	while (!t.queue.push(TileJob{data, index, index_count}))
+		std::this_thread::yield();
+
+	// Pairs with the fence in DrainTile(), either we see the tile going idle, or the worker sees our job.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	u8 expected = TILE_IDLE;
+	if (t.state.compare_exchange_strong(expected, TILE_QUEUED, std::memory_order_acq_rel))
+	{
+		m_workers[m_next_worker]->Push(tile);
+		m_next_worker = (m_next_worker + 1) % static_cast<u32>(m_workers.size());
+	}
+}
+
+void GSTiledRasterizerList::RunTile(int worker, int tile)
+{
+	// Another worker may have stolen it already, in which case this entry is stale.
+	u8 expected = TILE_QUEUED;
+	if (m_tiles[tile].state.compare_exchange_strong(expected, TILE_RUNNING, std::memory_order_acq_rel))
+		DrainTile(worker, tile);
+}
+
+void GSTiledRasterizerList::DrainTile(int worker, int tile)
+{
+	Tile& t = m_tiles[tile];
+	GSRasterizer& r = *m_r[worker];
+
+	const int tx = (tile % TILES_PER_ROW) << TILE_SHIFT;
+	const int ty = (tile / TILES_PER_ROW) << TILE_SHIFT;
+	const GSVector4i rect(tx, ty, tx + TILE_SIZE, ty + TILE_SIZE);
+
+	for (;;)
+	{
+		TileJob job;
+		while (t.queue.pop(job))
+		{
+			GSRasterizerData& data = *job.data.get();
+			r.Draw(data, data.scissor.rintersect(rect), job.index, job.index_count);
+			job = {};
+		}
+
+		t.state.store(TILE_IDLE, std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		// The GS thread may have pushed after we emptied the queue but before it saw us go idle.
+		if (t.queue.empty())
+			break;
+
+		u8 expected = TILE_IDLE;
+		if (!t.state.compare_exchange_strong(expected, TILE_RUNNING, std::memory_order_acq_rel))
+			break;
+	}
+}
+
+void GSTiledRasterizerList::StealTiles(int worker)
+{
+	const int count = m_active_tile_count.load(std::memory_order_acquire);
+	if (count == 0)
+		return;
+
+	// Start at a different place for each worker, so they don't all fight over the same tiles.
+	const int start = (worker * count) / static_cast<int>(m_workers.size());
+	for (int i = 0; i < count; i++)
+	{
+		const int tile = m_active_tiles[(start + i) % count];
+		if (m_tiles[tile].state.load(std::memory_order_relaxed) != TILE_QUEUED)
+			continue;
+
+		u8 expected = TILE_QUEUED;
+		if (m_tiles[tile].state.compare_exchange_strong(expected, TILE_RUNNING, std::memory_order_acq_rel))
+			DrainTile(worker, tile);
+	}
+}
+
+void GSTiledRasterizerList::Sync()
+{
+	if (!IsSynced())
+	{
+		for (size_t i = 0; i < m_workers.size(); i++)
+		{
+			m_workers[i]->Wait();
+		}
+
+		g_perfmon.Put(GSPerfMon::SyncPoint, 1);
+	}
+}
+
+bool GSTiledRasterizerList::IsSynced() const
+{
+	// Stolen tiles are drawn from within the thief's own job, so an empty queue means everything's done.
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		if (!m_workers[i]->IsEmpty())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int GSTiledRasterizerList::GetPixels(bool reset)
+{
+	int pixels = 0;
+
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		pixels += m_r[i]->GetPixels(reset);
+	}
+
+	return pixels;
+}
+
+void GSTiledRasterizerList::PrintStats()
+{
+}
+
+void GSTiledRasterizerList::PrintSelectorProfile()
+{
+	if (!m_ds.IsProfiling())
+		return;
+
+	Sync();
+
+	GSDrawScanline::SelectorProfileMap profile;
+	for (const auto& r : m_r)
+		r->MergeSelectorProfile(&profile);
+	m_ds.PrintSelectorProfile(std::move(profile));
+}
+
 #define INIT4(x0, x1, x2, x3, x4) static_cast<DrawEdgeTrianglePtr>(&GSRasterizer::DrawEdgeTriangle<x0, x1, x2, x3, x4>)
 #define INIT3(x0, x1, x2, x3) { INIT4(x0, x1, x2, x3, false)    , INIT4(x0, x1, x2, x3, true) } 
 #define INIT2(x0, x1, x2)     { INIT3(x0, x1, x2, false)        , INIT3(x0, x1, x2, true)     } 
@@ -28,11 +28,19 @@ public:
 	int vertex_count;
 	u16* index;
 	int index_count;
+	u16* binned_index;
 	u64 frame;
 	u64 start;
 	int pixels;
 	int counter;
 	u8 scanmsk_value;
+	bool wait_for_source;
+
+	// Hierarchical Z, hiz is null when it isn't used for this draw.
+	// Spans are skipped when every block they touch has an entry tagged hiz_tag with a min depth >= hiz_limit.
+	const std::atomic<u64>* hiz;
+	u64 hiz_tag;
+	u64 hiz_limit;
 
 	GSScanlineGlobalData global;
 
@@ -49,10 +57,16 @@ public:
 		, vertex_count(0)
 		, index(NULL)
 		, index_count(0)
+		, binned_index(nullptr)
 		, frame(0)
 		, start(0)
 		, pixels(0)
 		, scanmsk_value(0)
+		, wait_for_source(false)
+		, hiz(nullptr)
+		, hiz_tag(0)
+		, hiz_limit(0)
+		, global()
 	{
 		counter = s_counter++;
 	}
@@ -61,7 +75,13 @@ public:
 	{
 		if (buff != NULL)
 			GSRingHeap::free(buff);
+
+		if (binned_index)
+			GSRingHeap::free(binned_index);
 	}
+
+	/// Blocks until the textures sampled by this draw have been converted, called when wait_for_source is set.
+	virtual void WaitForSource() const {}
 };
 
 class alignas(32) GSRasterizer final : public GSVirtualAlignedClass<32>
@@ -79,14 +99,23 @@ protected:
 	struct { GSVertexSW* buff; int count; } m_edge;
 	struct { int sum, actual, total; } m_pixels;
 	int m_primcount;
+	bool m_profiling;
+	GSDrawScanline::SelectorProfileMap m_profile;
 
 	// For the current draw.
 	GSScanlineLocalData m_local = {};
 	GSDrawScanline::SetupPrimPtr m_setup_prim = nullptr;
 	GSDrawScanline::DrawScanlinePtr m_draw_scanline = nullptr;
 	GSDrawScanline::DrawScanlinePtr m_draw_edge = nullptr;
+	const std::atomic<u64>* m_hiz = nullptr;
+	u64 m_hiz_tag = 0;
+	u64 m_hiz_limit = 0;
+	int m_hiz_block_shift = 0;
+	u64 m_hiz_rejected_spans = 0;
+	u64 m_hiz_rejected_pixels = 0;
 
 	__forceinline bool HasEdge() const { return (m_draw_edge != nullptr); }
+	__forceinline bool IsHiZOccluded(int pixels, int left, int top) const;
 
 	template <bool step_x, bool pos_x, bool pos_y, bool tl, bool side>
 	void DrawEdgeTriangle(const GSVertexSW& v0, const GSVertexSW& v1, const GSVertexSW& dv,
@@ -133,7 +162,11 @@ public:
 	__forceinline int FindMyNextScanline(int top) const;
 
 	void Draw(GSRasterizerData& data);
+	void Draw(GSRasterizerData& data, const GSVector4i& scissor, const u16* index, int index_count);
 	int GetPixels(bool reset);
+
+	/// Adds this rasterizer's per-selector totals to profile. Must not be drawing.
+	void MergeSelectorProfile(GSDrawScanline::SelectorProfileMap* profile) const;
 };
 
 class IRasterizer : public GSVirtualAlignedClass<32>
@@ -146,6 +179,10 @@ public:
 	virtual bool IsSynced() const = 0;
 	virtual int GetPixels(bool reset = true) = 0;
 	virtual void PrintStats() = 0;
+	virtual GSDrawScanline& GetDrawScanline() = 0;
+
+	/// Waits for pending draws and logs the per-selector profile, if profiling is enabled.
+	virtual void PrintSelectorProfile() = 0;
 };
 
 class GSSingleRasterizer final : public IRasterizer
@@ -159,6 +196,8 @@ public:
 	bool IsSynced() const override;
 	int GetPixels(bool reset = true) override;
 	void PrintStats() override;
+	GSDrawScanline& GetDrawScanline() override { return m_ds; }
+	void PrintSelectorProfile() override;
 
 	void Draw(GSRasterizerData& data);
 
@@ -182,9 +221,6 @@ protected:
 
 	GSRasterizerList(int threads);
 
-	static void OnWorkerStartup(int i, u64 affinity);
-	static void OnWorkerShutdown(int i);
-
 public:
 	~GSRasterizerList() override;
 
@@ -197,6 +233,85 @@ public:
 	bool IsSynced() const override;
 	int GetPixels(bool reset) override;
 	void PrintStats() override;
+	GSDrawScanline& GetDrawScanline() override { return m_ds; }
+	void PrintSelectorProfile() override;
+};
+
+/// Splits the screen into square tiles instead of interleaved scanline bands.
+/// Each draw is binned into the tiles its primitives touch, and any idle worker can pick up any queued tile,
+/// so threads don't sit idle when a draw only covers a small part of the screen.
+class GSTiledRasterizerList final : public IRasterizer
+{
+protected:
+	static constexpr int TILE_SHIFT = 6;
+	static constexpr int TILE_SIZE = 1 << TILE_SHIFT;
+	static constexpr int TILES_PER_ROW = 2048 >> TILE_SHIFT;
+	static constexpr int TILE_COUNT = TILES_PER_ROW * TILES_PER_ROW;
+
+	enum : u8
+	{
+		TILE_IDLE,
+		TILE_QUEUED,
+		TILE_RUNNING,
+	};
+
+	struct TileJob
+	{
+		GSRingHeap::SharedPtr<GSRasterizerData> data;
+		const u16* index = nullptr;
+		int index_count = 0;
+	};
+
+	struct alignas(64) Tile
+	{
+		// Only the GS thread pushes, and only the worker which moved the tile to TILE_RUNNING pops.
+		ringbuffer_base<TileJob, 256> queue;
+		std::atomic<u8> state{TILE_IDLE};
+		bool active = false;
+	};
+
+	using GSWorker = GSJobQueue<int, 4096>;
+
+	GSDrawScanline m_ds;
+
+	// Worker threads depend on the rasterizers and tiles, so don't change the order.
+	std::vector<std::unique_ptr<GSRasterizer>> m_r;
+	std::unique_ptr<Tile[]> m_tiles;
+	std::vector<std::unique_ptr<GSWorker>> m_workers;
+
+	// Tiles which have been used at least once, scanned by idle workers looking for work to steal.
+	std::unique_ptr<u16[]> m_active_tiles;
+	std::atomic<int> m_active_tile_count{0};
+
+	GSRingHeap m_bin_heap;
+	std::vector<GSVector4i> m_prim_tiles;
+	std::vector<int> m_bin_offsets;
+	std::vector<int> m_bin_fill;
+	u32 m_next_worker = 0;
+
+	GSTiledRasterizerList(int threads);
+
+	void BinPrimitives(GSRasterizerData& data, const GSVector4i& tr);
+	void PushTile(int tile, const GSRingHeap::SharedPtr<GSRasterizerData>& data, const u16* index, int index_count);
+
+	void RunTile(int worker, int tile);
+	void DrainTile(int worker, int tile);
+	void StealTiles(int worker);
+
+public:
+	~GSTiledRasterizerList() override;
+
+	static std::unique_ptr<IRasterizer> Create(int threads);
+
+	// IRasterizer
+
+	void Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data) override;
+	void Sync() override;
+	bool IsSynced() const override;
+	int GetPixels(bool reset) override;
+	void PrintStats() override;
+	GSDrawScanline& GetDrawScanline() override { return m_ds; }
+	void PrintSelectorProfile() override;
 };
 
 MULTI_ISA_UNSHARED_END
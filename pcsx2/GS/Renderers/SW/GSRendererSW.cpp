@@ -5,9 +5,15 @@
 #include "GS/GSGL.h"
 #include "GS/GSPng.h"
 #include "GS/GSUtil.h"
+#include "VMManager.h"
 
+#include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
 #include "common/StringUtil.h"
 
+#include "fmt/format.h"
+
 MULTI_ISA_UNSHARED_IMPL;
 
 GSRenderer* CURRENT_ISA::makeGSRendererSW(int threads)
@@ -26,13 +32,18 @@ GSRendererSW::GSRendererSW(int threads)
 {
 	m_nativeres = true; // ignore ini, sw is always native
 
-	m_tc = std::make_unique<GSTextureCacheSW>();
+	m_tc = std::make_unique<GSTextureCacheSW>(GSConfig.SWParallelTextureUpdate ? threads : 0);
+
+	if (GSConfig.SWHierarchicalZ)
+		m_hiz = std::make_unique<std::atomic<u64>[]>(GS_MAX_PAGES * GS_BLOCKS_PER_PAGE);
 	m_rl = GSRasterizerList::Create(threads);
 
 	m_output = (u8*)_aligned_malloc(1024 * 1024 * sizeof(u32), VECTOR_ALIGNMENT);
 
 	std::fill(std::begin(m_fzb_pages), std::end(m_fzb_pages), 0);
 	std::fill(std::begin(m_tex_pages), std::end(m_tex_pages), 0);
+
+	LoadHotSelectors();
 }
 
 GSRendererSW::~GSRendererSW()
@@ -49,11 +60,41 @@ void GSRendererSW::Reset(bool hardware_reset)
 
 	m_tc->RemoveAll();
 
+	if (m_hiz)
+	{
+		for (u32 page = 0; page < GS_MAX_PAGES; page++)
+		{
+			if (m_hiz_page_psm[page] != 0)
+				InvalidateHiZPage(page);
+		}
+	}
+
 	GSRenderer::Reset(hardware_reset);
 }
 
 void GSRendererSW::Destroy()
 {
+	// Anything still batched belongs to a GS state which is going away.
+	m_batch = nullptr;
+
+	if (m_batch_draws > 0)
+	{
+		DevCon.WriteLn("SW draw coalescing: %llu of %llu small draws merged into %llu batches", m_batch_merged,
+			m_batch_draws, m_batch_count);
+	}
+
+	if (m_rl && m_hiz)
+	{
+		const GSDrawScanline& ds = m_rl->GetDrawScanline();
+		DevCon.WriteLn("SW hierarchical Z: rejected %llu spans (%llu pixels), built %llu pages", ds.GetHiZRejectedSpans(),
+			ds.GetHiZRejectedPixels(), m_hiz_pages_built);
+	}
+
+	if (m_rl)
+		m_rl->PrintSelectorProfile();
+
+	SaveHotSelectors();
+
 	// Need to destroy worker queue first to stop any pending thread work
 	m_rl.reset();
 	m_tc.reset();
@@ -68,6 +109,130 @@ void GSRendererSW::Destroy()
 	m_output = nullptr;
 }
 
+void GSRendererSW::GameChanged()
+{
+	SaveHotSelectors();
+	LoadHotSelectors();
+}
+
+namespace
+{
+	struct HotSelectorsHeader
+	{
+		static constexpr u32 MAGIC = 0x53485753; // SWHS
+		static constexpr u32 VERSION = 1;
+
+		u32 magic;
+		u32 version;
+		u32 selector_size; // sizeof(GSScanlineSelector), catches layout changes which forget to bump the version
+		u32 num_ds_selectors;
+		u32 num_sp_selectors;
+	};
+
+	static constexpr u32 MAX_HOT_SELECTORS = 4096;
+} // namespace
+
+void GSRendererSW::LoadHotSelectors()
+{
+	m_hot_selectors_path.clear();
+	m_hot_ds_selectors.clear();
+	m_hot_sp_selectors.clear();
+
+	if (!m_rl)
+		return;
+
+	GSDrawScanline& ds = m_rl->GetDrawScanline();
+	ds.StopPrecompile();
+	ds.ResetUsedSelectors();
+
+	// Same lifetime rules as the hardware renderers' shader caches.
+	const std::string serial = VMManager::GetDiscSerial();
+	const u32 crc = VMManager::GetCurrentCRC();
+	if (GSConfig.DisableShaderCache || (serial.empty() && crc == 0))
+		return;
+
+	m_hot_selectors_path = Path::Combine(EmuFolders::Cache,
+		fmt::format("sw_selectors_{}_{:08X}.bin", serial.empty() ? "unknown" : Path::SanitizeFileName(serial), crc));
+
+	const std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(m_hot_selectors_path.c_str());
+	if (!data.has_value())
+		return;
+
+	HotSelectorsHeader hdr;
+	if (data->size() < sizeof(hdr))
+		return;
+
+	std::memcpy(&hdr, data->data(), sizeof(hdr));
+	if (hdr.magic != HotSelectorsHeader::MAGIC || hdr.version != HotSelectorsHeader::VERSION ||
+		hdr.selector_size != sizeof(GSScanlineSelector) || hdr.num_ds_selectors > MAX_HOT_SELECTORS ||
+		hdr.num_sp_selectors > MAX_HOT_SELECTORS ||
+		data->size() != sizeof(hdr) + (hdr.num_ds_selectors + hdr.num_sp_selectors) * sizeof(u64))
+	{
+		Console.Warning("Ignoring invalid SW selector list '%s'", m_hot_selectors_path.c_str());
+		return;
+	}
+
+	const u64* keys = reinterpret_cast<const u64*>(data->data() + sizeof(hdr));
+	m_hot_ds_selectors.assign(keys, keys + hdr.num_ds_selectors);
+	m_hot_sp_selectors.assign(keys + hdr.num_ds_selectors, keys + hdr.num_ds_selectors + hdr.num_sp_selectors);
+
+	DevCon.WriteLn("Precompiling %zu SW draw and %zu setup selectors from '%s'", m_hot_ds_selectors.size(),
+		m_hot_sp_selectors.size(), m_hot_selectors_path.c_str());
+	ds.BeginPrecompile(m_hot_ds_selectors, m_hot_sp_selectors);
+}
+
+void GSRendererSW::SaveHotSelectors()
+{
+	if (m_hot_selectors_path.empty() || !m_rl)
+		return;
+
+	std::vector<u64> ds_keys, sp_keys;
+	m_rl->GetDrawScanline().GetUsedSelectors(&ds_keys, &sp_keys);
+
+	// Keep selectors from earlier sessions which weren't hit this time, they're probably from another area of the game.
+	const auto merge = [](std::vector<u64>& used, const std::vector<u64>& previous) {
+		std::sort(used.begin(), used.end());
+		const size_t num_sorted = used.size();
+		for (const u64 key : previous)
+		{
+			if (used.size() >= MAX_HOT_SELECTORS)
+				break;
+			if (!std::binary_search(used.begin(), used.begin() + num_sorted, key))
+				used.push_back(key);
+		}
+		if (used.size() > MAX_HOT_SELECTORS)
+			used.resize(MAX_HOT_SELECTORS);
+	};
+	const size_t num_used = ds_keys.size() + sp_keys.size();
+	merge(ds_keys, m_hot_ds_selectors);
+	merge(sp_keys, m_hot_sp_selectors);
+
+	// Nothing new, don't bother rewriting the file.
+	if (ds_keys.size() == m_hot_ds_selectors.size() && sp_keys.size() == m_hot_sp_selectors.size())
+		return;
+
+	HotSelectorsHeader hdr;
+	hdr.magic = HotSelectorsHeader::MAGIC;
+	hdr.version = HotSelectorsHeader::VERSION;
+	hdr.selector_size = sizeof(GSScanlineSelector);
+	hdr.num_ds_selectors = static_cast<u32>(ds_keys.size());
+	hdr.num_sp_selectors = static_cast<u32>(sp_keys.size());
+
+	std::vector<u8> data(sizeof(hdr) + (ds_keys.size() + sp_keys.size()) * sizeof(u64));
+	std::memcpy(data.data(), &hdr, sizeof(hdr));
+	std::memcpy(data.data() + sizeof(hdr), ds_keys.data(), ds_keys.size() * sizeof(u64));
+	std::memcpy(data.data() + sizeof(hdr) + ds_keys.size() * sizeof(u64), sp_keys.data(), sp_keys.size() * sizeof(u64));
+
+	if (!FileSystem::WriteBinaryFile(m_hot_selectors_path.c_str(), data.data(), data.size()))
+	{
+		Console.Warning("Failed to write SW selector list '%s'", m_hot_selectors_path.c_str());
+		return;
+	}
+
+	DevCon.WriteLn("Saved %zu SW selectors (%zu used this session) to '%s'", ds_keys.size() + sp_keys.size(), num_used,
+		m_hot_selectors_path.c_str());
+}
+
 void GSRendererSW::VSync(u32 field, bool registers_written, bool idle_frame)
 {
 	Sync(0); // IncAge might delete a cached texture in use
@@ -658,7 +823,11 @@ void GSRendererSW::Queue(GSRingHeap::SharedPtr<GSRasterizerData>& item)
 		fflush(s_fp);
 	}
 
-	m_rl->Queue(item);
+	if (m_hiz)
+		UpdateHiZ(sd);
+
+	if (!QueueBatched(item))
+		m_rl->Queue(item);
 
 	// invalidate new parts rendered onto
 
@@ -679,8 +848,16 @@ void GSRendererSW::Sync(int reason)
 
 	u64 t = LOG ? GetCPUTicks() : 0;
 
+	FlushBatch();
+
 	m_rl->Sync();
 
+	if (m_hiz)
+	{
+		std::memset(m_hiz_unsafe, 0, sizeof(m_hiz_unsafe));
+		std::memset(m_hiz_write_psm, 0, sizeof(m_hiz_write_psm));
+	}
+
 	if constexpr (LOG && false)
 	{
 		std::string s;
@@ -713,6 +890,288 @@ void GSRendererSW::Sync(int reason)
 	g_perfmon.Put(GSPerfMon::Fillrate, pixels);
 }
 
+bool GSRendererSW::IsSynced() const
+{
+	return !m_batch.get() && m_rl->IsSynced();
+}
+
+bool GSRendererSW::QueueBatched(const GSRingHeap::SharedPtr<GSRasterizerData>& item)
+{
+	SharedData* sd = static_cast<SharedData*>(item.get());
+
+	if (m_batch.get())
+	{
+		SharedData* batch = static_cast<SharedData*>(m_batch.get());
+
+		if (CanMergeDraw(batch, sd))
+		{
+			MergeDraw(batch, sd);
+			batch->m_merged.push_back(item);
+
+			m_batch_rect = m_batch_rect.runion(sd->bbox.rintersect(sd->scissor));
+			m_batch_draws++;
+			m_batch_merged++;
+
+			if (batch->index_count >= BATCH_MAX_INDICES)
+				FlushBatch();
+
+			return true;
+		}
+
+		FlushBatch();
+	}
+
+	if (!GSConfig.SWDrawCoalescing || sd->index_count > BATCH_MAX_DRAW_INDICES)
+		return false;
+
+	m_batch = item;
+	m_batch_rect = sd->bbox.rintersect(sd->scissor);
+	m_batch_vertex_capacity = sd->vertex_count;
+	m_batch_index_capacity = sd->index_count;
+	m_batch_draws++;
+	return true;
+}
+
+bool GSRendererSW::CanMergeDraw(const SharedData* batch, const SharedData* sd) const
+{
+	if (sd->index_count > BATCH_MAX_DRAW_INDICES ||
+		batch->vertex_count + sd->vertex_count > BATCH_MAX_VERTICES ||
+		batch->primclass != sd->primclass ||
+		batch->scanmsk_value != sd->scanmsk_value ||
+		batch->frame != sd->frame ||
+		!batch->scissor.eq(sd->scissor))
+	{
+		return false;
+	}
+
+	// Primitives within a draw are rasterized in order, but keep merged draws apart so the batch never depends on it.
+	if (!m_batch_rect.rintersect(sd->bbox.rintersect(sd->scissor)).rempty())
+		return false;
+
+	const GSScanlineGlobalData& a = batch->global;
+	const GSScanlineGlobalData& b = sd->global;
+
+	if (a.sel.key != b.sel.key)
+		return false;
+
+	// Everything except the clut and dimx copies, which are compared by value below.
+	const u8* pa = reinterpret_cast<const u8*>(&a);
+	const u8* pb = reinterpret_cast<const u8*>(&b);
+	const size_t clut_offset = reinterpret_cast<const u8*>(&a.clut) - pa;
+	const size_t fbo_offset = reinterpret_cast<const u8*>(&a.fbo) - pa;
+
+	if (std::memcmp(pa, pb, clut_offset) != 0 || std::memcmp(pa + fbo_offset, pb + fbo_offset, sizeof(a) - fbo_offset) != 0)
+		return false;
+
+	for (size_t i = 0;; i++)
+	{
+		if (batch->m_tex[i].t != sd->m_tex[i].t)
+			return false;
+		if (!batch->m_tex[i].t)
+			break;
+	}
+
+	if ((a.clut != nullptr) != (b.clut != nullptr) || (a.dimx != nullptr) != (b.dimx != nullptr))
+		return false;
+
+	if (a.clut && std::memcmp(a.clut, b.clut, sizeof(u32) * GSLocalMemory::m_psm[batch->m_tex[0].t->m_TEX0.PSM].pal) != 0)
+		return false;
+
+	if (a.dimx && std::memcmp(a.dimx, b.dimx, sizeof(m_dimx)) != 0)
+		return false;
+
+	return true;
+}
+
+void GSRendererSW::MergeDraw(SharedData* batch, SharedData* sd)
+{
+	const int vertex_count = batch->vertex_count + sd->vertex_count;
+	const int index_count = batch->index_count + sd->index_count;
+
+	if (vertex_count > m_batch_vertex_capacity || index_count > m_batch_index_capacity)
+	{
+		m_batch_vertex_capacity = (std::min(std::max(vertex_count * 2, 256), BATCH_MAX_VERTICES) + 1) & ~1;
+		m_batch_index_capacity = std::max(index_count * 2, 512);
+
+		u8* buff = static_cast<u8*>(m_vertex_heap.alloc(sizeof(GSVertexSW) * m_batch_vertex_capacity + sizeof(u16) * m_batch_index_capacity, 64));
+		GSVertexSW* vertex = reinterpret_cast<GSVertexSW*>(buff);
+		u16* index = reinterpret_cast<u16*>(buff + sizeof(GSVertexSW) * m_batch_vertex_capacity);
+
+		std::memcpy(vertex, batch->vertex, sizeof(GSVertexSW) * batch->vertex_count);
+		std::memcpy(index, batch->index, sizeof(u16) * batch->index_count);
+
+		GSRingHeap::free(batch->buff);
+		batch->buff = buff;
+		batch->vertex = vertex;
+		batch->index = index;
+	}
+
+	std::memcpy(batch->vertex + batch->vertex_count, sd->vertex, sizeof(GSVertexSW) * sd->vertex_count);
+
+	const u16 base = static_cast<u16>(batch->vertex_count);
+	u16* RESTRICT dst = batch->index + batch->index_count;
+	for (int i = 0; i < sd->index_count; i++)
+		dst[i] = sd->index[i] + base;
+
+	batch->vertex_count = vertex_count;
+	batch->index_count = index_count;
+	batch->bbox = batch->bbox.runion(sd->bbox);
+
+	for (size_t i = 0; batch->m_tex[i].t; i++)
+		batch->m_tex[i].r = batch->m_tex[i].r.runion(sd->m_tex[i].r);
+
+	batch->wait_for_source |= sd->wait_for_source;
+
+	if (batch->hiz && sd->hiz)
+		batch->hiz_limit = std::max(batch->hiz_limit, sd->hiz_limit);
+	else
+		batch->hiz = nullptr;
+
+	// The vertices have been copied, only the page references are still needed.
+	GSRingHeap::free(sd->buff);
+	sd->buff = nullptr;
+	sd->vertex = nullptr;
+	sd->index = nullptr;
+}
+
+void GSRendererSW::FlushBatch()
+{
+	if (!m_batch.get())
+		return;
+
+	if (!static_cast<SharedData*>(m_batch.get())->m_merged.empty())
+		m_batch_count++;
+
+	m_rl->Queue(m_batch);
+	m_batch = nullptr;
+}
+
+void GSRendererSW::UpdateHiZ(SharedData* sd)
+{
+	const GSScanlineGlobalData& gd = sd->global;
+
+	const bool ztest = gd.sel.zb && (gd.sel.ztst == ZTST_GEQUAL || gd.sel.ztst == ZTST_GREATER) && !gd.sel.zoverflow;
+
+	if (GSConfig.SWHierarchicalZ && ztest)
+	{
+		// m_vt is still the vertex trace of this draw. Round the max up generously, z went through a float on the way.
+		static constexpr u32 zmax_format[] = {0xFFFFFFFFu, 0x00FFFFFFu, 0x0000FFFFu, 0x0000FFFFu};
+		const u64 format_max = zmax_format[gd.sel.zpsm];
+		u64 zmax = static_cast<u64>(std::ceil(static_cast<double>(m_vt.m_max.p.z) * (1.0 + 1.0 / (1 << 22)))) + 1;
+
+		if (zmax <= format_max || gd.sel.zclamp)
+		{
+			zmax = std::min(zmax, format_max);
+
+			const u32 zpsm = sd->m_zpsm;
+
+			sd->m_zb_pages.loopPages([this, zpsm](u32 page) {
+				// Reading while depth tested writes in the same format are pending still gives a lower bound.
+				if ((m_hiz_unsafe[page >> 5] & (1u << (page & 31))) || (m_hiz_write_psm[page] != 0 && m_hiz_write_psm[page] != zpsm))
+					return;
+
+				if (m_hiz_page_psm[page] != zpsm || (m_hiz_stale[page >> 5] & (1u << (page & 31))))
+					BuildHiZPage(page, zpsm);
+			});
+
+			sd->hiz = m_hiz.get();
+			sd->hiz_tag = static_cast<u64>(zpsm) << 32;
+			sd->hiz_limit = (gd.sel.ztst == ZTST_GEQUAL) ? zmax + 1 : zmax;
+		}
+	}
+
+	// Now account for what this draw writes.
+
+	if (gd.sel.fb && gd.sel.fwrite)
+		InvalidateHiZPages(sd->m_fb_pages, true);
+
+	if (gd.sel.zb && gd.sel.zwrite)
+	{
+		if (ztest)
+		{
+			const u32 zpsm = sd->m_zpsm;
+
+			sd->m_zb_pages.loopPages([this, zpsm](u32 page) {
+				// Only monotonic when read back in the same format.
+				if (m_hiz_write_psm[page] == 0)
+					m_hiz_write_psm[page] = static_cast<u8>(zpsm);
+				else if (m_hiz_write_psm[page] != zpsm)
+					m_hiz_unsafe[page >> 5] |= 1u << (page & 31);
+
+				if (m_hiz_page_psm[page] == zpsm)
+					m_hiz_stale[page >> 5] |= 1u << (page & 31);
+				else if (m_hiz_page_psm[page] != 0)
+					InvalidateHiZPage(page);
+			});
+		}
+		else
+		{
+			InvalidateHiZPages(sd->m_zb_pages, true);
+		}
+	}
+}
+
+void GSRendererSW::BuildHiZPage(u32 page, u32 psm)
+{
+	const u8* src = m_mem.m_vm8 + page * GS_PAGE_SIZE;
+	std::atomic<u64>* dst = &m_hiz[page * GS_BLOCKS_PER_PAGE];
+	const u64 tag = static_cast<u64>(psm) << 32;
+
+	// Pixel order within a block doesn't matter for its min, so read the block linearly.
+	for (u32 i = 0; i < GS_BLOCKS_PER_PAGE; i++, src += GS_BLOCK_SIZE)
+	{
+		const GSVector4i* RESTRICT v = reinterpret_cast<const GSVector4i*>(src);
+		u32 zmin;
+
+		if (psm == PSMZ16 || psm == PSMZ16S)
+		{
+			GSVector4i m = v[0];
+			for (u32 j = 1; j < GS_BLOCK_SIZE / sizeof(GSVector4i); j++)
+				m = m.min_u16(v[j]);
+
+			alignas(16) u16 z[8];
+			GSVector4i::store<true>(z, m);
+			zmin = *std::min_element(std::begin(z), std::end(z));
+		}
+		else
+		{
+			const GSVector4i mask = GSVector4i(psm == PSMZ24 ? 0x00FFFFFF : 0xFFFFFFFF);
+
+			GSVector4i m = v[0] & mask;
+			for (u32 j = 1; j < GS_BLOCK_SIZE / sizeof(GSVector4i); j++)
+				m = m.min_u32(v[j] & mask);
+
+			zmin = m.minv_u32();
+		}
+
+		dst[i].store(tag | zmin, std::memory_order_relaxed);
+	}
+
+	m_hiz_page_psm[page] = static_cast<u8>(psm);
+	m_hiz_stale[page >> 5] &= ~(1u << (page & 31));
+	m_hiz_pages_built++;
+}
+
+void GSRendererSW::InvalidateHiZPage(u32 page)
+{
+	std::atomic<u64>* dst = &m_hiz[page * GS_BLOCKS_PER_PAGE];
+	for (u32 i = 0; i < GS_BLOCKS_PER_PAGE; i++)
+		dst[i].store(0, std::memory_order_relaxed);
+
+	m_hiz_page_psm[page] = 0;
+	m_hiz_stale[page >> 5] &= ~(1u << (page & 31));
+}
+
+void GSRendererSW::InvalidateHiZPages(const GSOffset::PageLooper& pages, bool unsafe)
+{
+	pages.loopPages([this, unsafe](u32 page) {
+		if (m_hiz_page_psm[page] != 0)
+			InvalidateHiZPage(page);
+		if (unsafe)
+			m_hiz_unsafe[page >> 5] |= 1u << (page & 31);
+	});
+}
+
 void GSRendererSW::InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r)
 {
 	if constexpr (LOG)
@@ -726,7 +1185,7 @@ void GSRendererSW::InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 
 	// check if the changing pages either used as a texture or a target
 
-	if (!m_rl->IsSynced())
+	if (!IsSynced())
 	{
 		pages.loopPagesWithBreak([this](u32 page)
 		{
@@ -740,6 +1199,9 @@ void GSRendererSW::InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 	}
 
 	m_tc->InvalidatePages(pages, off.psm()); // if texture update runs on a thread and Sync(5) happens then this must come later
+
+	if (m_hiz)
+		InvalidateHiZPages(pages, false);
 }
 
 void GSRendererSW::InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool clut)
@@ -750,7 +1212,7 @@ void GSRendererSW::InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 		fflush(s_fp);
 	}
 
-	if (!m_rl->IsSynced())
+	if (!IsSynced())
 	{
 		GSOffset off = m_mem.GetOffset(BITBLTBUF.SBP, BITBLTBUF.SBW, BITBLTBUF.SPSM);
 		GSOffset::PageLooper pages = off.pageLooperForRect(r);
@@ -817,7 +1279,7 @@ void GSRendererSW::ReleasePages(const GSOffset::PageLooper& pages, const int typ
 
 bool GSRendererSW::CheckTargetPages(const GSOffset::PageLooper* fb_pages, const GSOffset::PageLooper* zb_pages, const GSVector4i& r)
 {
-	const bool synced = m_rl->IsSynced();
+	const bool synced = IsSynced();
 
 	const bool fb = (fb_pages != nullptr);
 	const bool zb = (zb_pages != nullptr);
@@ -1001,7 +1463,7 @@ bool GSRendererSW::CheckTargetPages(const GSOffset::PageLooper* fb_pages, const
 
 bool GSRendererSW::CheckSourcePages(SharedData* sd)
 {
-	if (!m_rl->IsSynced())
+	if (!IsSynced())
 	{
 		for (size_t i = 0; sd->m_tex[i].t != NULL; i++)
 		{
@@ -1630,11 +2092,23 @@ void GSRendererSW::SharedData::SetSource(GSTextureCacheSW::Texture* t, const GSV
 	m_tex[level + 1].t = nullptr;
 }
 
+void GSRendererSW::SharedData::WaitForSource() const
+{
+	for (size_t i = 0; m_tex[i].t; i++)
+	{
+		m_tex[i].t->WaitForRect(m_tex[i].r);
+	}
+}
+
 void GSRendererSW::SharedData::UpdateSource()
 {
+	GSTextureCacheSW* tc = GSRendererSW::GetInstance()->m_tc.get();
+
+	wait_for_source = (m_tex[0].t && tc->HasWorkers());
+
 	for (size_t i = 0; m_tex[i].t; i++)
 	{
-		if (m_tex[i].t->Update(m_tex[i].r))
+		if (m_tex[i].t->Update(m_tex[i].r, tc))
 		{
 			global.tex[i] = m_tex[i].t->m_buff;
 		}
@@ -1658,6 +2132,7 @@ void GSRendererSW::SharedData::UpdateSource()
 
 			s = GetDrawDumpPath("%05lld_f%05lld_itex%d_%05x_%s.bmp", g_gs_renderer->s_n, frame, i, TEX0.TBP0, GSUtil::GetPSMName(TEX0.PSM));
 
+			m_tex[i].t->WaitForAll();
 			m_tex[i].t->Save(s);
 		}
 
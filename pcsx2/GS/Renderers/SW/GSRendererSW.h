@@ -44,6 +44,11 @@ public:
 
 		void SetSource(GSTextureCacheSW::Texture* t, const GSVector4i& r, int level);
 		void UpdateSource();
+
+		void WaitForSource() const override;
+
+		/// Draws coalesced into this one, kept alive so their pages stay in use until the batch is drawn.
+		std::vector<GSRingHeap::SharedPtr<GSRasterizerData>> m_merged;
 	};
 
 protected:
@@ -65,9 +70,45 @@ protected:
 	GSTexture* GetOutput(int i, float& scale, int& y_offset) override;
 	GSTexture* GetFeedbackOutput(float& scale) override;
 
+	/// Draws up to this many indices are held back, so following draws with the same state can be appended to them.
+	static constexpr int BATCH_MAX_DRAW_INDICES = 256;
+	static constexpr int BATCH_MAX_INDICES = 16384;
+	static constexpr int BATCH_MAX_VERTICES = 65535;
+
+	GSRingHeap::SharedPtr<GSRasterizerData> m_batch;
+	GSVector4i m_batch_rect;
+	int m_batch_vertex_capacity = 0;
+	int m_batch_index_capacity = 0;
+	u64 m_batch_draws = 0;
+	u64 m_batch_merged = 0;
+	u64 m_batch_count = 0;
+
+	/// Hierarchical Z, one entry per block of local memory holding the min depth stored in it, tagged with the
+	/// z format it was read as. Entries are only built by the GS thread, and stay valid while every pending write
+	/// to the block is depth tested with GEQUAL/GREATER, since those can only raise the depth.
+	std::unique_ptr<std::atomic<u64>[]> m_hiz;
+	u8 m_hiz_page_psm[GS_MAX_PAGES] = {}; // 0 if the page has no entries
+	u32 m_hiz_stale[GS_MAX_PAGES / 32] = {}; // written by depth tested draws since built, still a valid lower bound
+	u32 m_hiz_unsafe[GS_MAX_PAGES / 32] = {}; // pending draws may lower the depth, cleared on sync
+	u8 m_hiz_write_psm[GS_MAX_PAGES] = {}; // z format of pending depth tested writes, cleared on sync
+	u64 m_hiz_pages_built = 0;
+
+	void UpdateHiZ(SharedData* sd);
+	void BuildHiZPage(u32 page, u32 psm);
+	void InvalidateHiZPage(u32 page);
+	void InvalidateHiZPages(const GSOffset::PageLooper& pages, bool unsafe);
+
 	void Draw() override;
 	void Queue(GSRingHeap::SharedPtr<GSRasterizerData>& item);
 	void Sync(int reason);
+
+	/// Returns false while a batch is pending, or the rasterizer is still working.
+	bool IsSynced() const;
+
+	bool QueueBatched(const GSRingHeap::SharedPtr<GSRasterizerData>& item);
+	bool CanMergeDraw(const SharedData* batch, const SharedData* sd) const;
+	void MergeDraw(SharedData* batch, SharedData* sd);
+	void FlushBatch();
 	void InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r) override;
 	void InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool clut = false) override;
 
@@ -79,6 +120,14 @@ protected:
 
 	bool GetScanlineGlobalData(SharedData* data);
 
+	/// Selectors from previous sessions of the current game, precompiled in the background when it starts.
+	std::string m_hot_selectors_path;
+	std::vector<u64> m_hot_ds_selectors;
+	std::vector<u64> m_hot_sp_selectors;
+
+	void LoadHotSelectors();
+	void SaveHotSelectors();
+
 	template <u32 primclass>
 	void RewriteVerticesIfSTOverflow();
 
@@ -89,6 +138,7 @@ public:
 	__fi static GSRendererSW* GetInstance() { return static_cast<GSRendererSW*>(g_gs_renderer.get()); }
 
 	void Destroy() override;
+	void GameChanged() override;
 };
 
 MULTI_ISA_UNSHARED_END
@@ -7,11 +7,34 @@
 #include "GS/GSPng.h"
 #include "GS/GSUtil.h"
 
-GSTextureCacheSW::GSTextureCacheSW() = default;
+#include "common/Console.h"
+#include "common/StringUtil.h"
+
+#include <bit>
+
+GSTextureCacheSW::GSTextureCacheSW(int threads)
+{
+	for (int i = 0; i < threads; i++)
+	{
+		m_workers.push_back(std::make_unique<GSWorker>(
+			[i]() { Threading::SetNameOfCurrentThread(StringUtil::StdStringFromFormat("GS-SW-Tex-%d", i).c_str()); },
+			[](PageRowJob& job) {
+				ConvertPageRow(job);
+				job.t->m_pending_rows[job.row].fetch_sub(1, std::memory_order_release);
+			},
+			[]() {}));
+	}
+}
 
 GSTextureCacheSW::~GSTextureCacheSW()
 {
 	RemoveAll();
+
+	if (m_async_updates > 0)
+	{
+		DevCon.WriteLn("GS/SW: %llu texture updates converted on %zu threads (%llu page rows, %llu blocks)",
+			m_async_updates, m_workers.size(), m_async_rows, m_async_blocks);
+	}
 }
 
 GSTextureCacheSW::Texture* GSTextureCacheSW::Lookup(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, u32 tw0)
@@ -156,6 +179,8 @@ GSTextureCacheSW::Texture::Texture(u32 tw0, const GIFRegTEX0& TEX0, const GIFReg
 
 GSTextureCacheSW::Texture::~Texture()
 {
+	WaitForAll();
+
 	if (m_buff)
 	{
 		_aligned_free(m_buff);
@@ -164,6 +189,8 @@ GSTextureCacheSW::Texture::~Texture()
 
 void GSTextureCacheSW::Texture::Reset(u32 tw0, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
 {
+	WaitForAll();
+
 	if (m_buff && (m_TEX0.TW != TEX0.TW || m_TEX0.TH != TEX0.TH))
 	{
 		_aligned_free(m_buff);
@@ -197,7 +224,7 @@ void GSTextureCacheSW::Texture::Reset(u32 tw0, const GIFRegTEX0& TEX0, const GIF
 	}
 }
 
-bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
+bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect, GSTextureCacheSW* tc)
 {
 	if (m_complete)
 	{
@@ -254,6 +281,85 @@ bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
 	int bottom = r.bottom >> off.blockShiftY();
 	int right = r.right >> off.blockShiftX();
 
+	if (tc && tc->HasWorkers() && tw <= 1024 && th <= 1024)
+	{
+		// Blocks are claimed here, one row of pages at a time, so m_valid is only ever touched by this thread.
+		// Targets and transfers overlapping this texture sync the rasterizer, and draws wait for the rows they
+		// sample, so by then the conversions have finished and nothing else writes these blocks concurrently.
+		PageRowJob jobs[MAX_PAGE_ROWS];
+		u32 num_jobs = 0;
+
+		const int page_shift_y = std::countr_zero(static_cast<u32>(psm.pgs.y));
+
+		for (int y = r.top; y < r.bottom; y = ((y >> page_shift_y) + 1) << page_shift_y)
+		{
+			PageRowJob& job = jobs[num_jobs];
+			const int row_bottom = std::min(r.bottom, ((y >> page_shift_y) + 1) << page_shift_y);
+			const int top = y >> off.blockShiftY();
+			const int row_bottom_blk = row_bottom >> off.blockShiftY();
+
+			job.t = this;
+			job.row = y >> page_shift_y;
+			job.left = static_cast<u16>(r.left);
+			job.top = static_cast<u16>(y);
+			job.right = static_cast<u16>(r.right);
+			job.bottom = static_cast<u16>(row_bottom);
+			job.blocks = 0;
+			std::memset(job.mask, 0, sizeof(job.mask));
+
+			for (GSOffset::BNHelper bn = off.bnMulti(r.left, y); bn.blkY() < row_bottom_blk; bn.nextBlockY())
+			{
+				for (; bn.blkX() < right; bn.nextBlockX())
+				{
+					const u32 i = m_repeating ? static_cast<u32>((bn.blkY() << 7) + bn.blkX()) : bn.value();
+					const u32 row = i >> 5;
+					const u32 col = 1 << (i & 31);
+
+					if ((m_valid[row] & col) == 0)
+					{
+						m_valid[row] |= col;
+
+						const u32 bit = ((bn.blkY() - top) << 7) + bn.blkX();
+						job.mask[bit >> 5] |= 1u << (bit & 31);
+						job.blocks++;
+					}
+				}
+			}
+
+			if (job.blocks > 0)
+			{
+				blocks += job.blocks;
+				num_jobs++;
+			}
+		}
+
+		if (num_jobs >= ASYNC_MIN_ROWS && blocks >= ASYNC_MIN_BLOCKS)
+		{
+			for (u32 i = 0; i < num_jobs; i++)
+			{
+				m_pending_rows[jobs[i].row].fetch_add(1, std::memory_order_relaxed);
+				tc->m_workers[tc->m_next_worker]->Push(jobs[i]);
+				tc->m_next_worker = (tc->m_next_worker + 1) % static_cast<u32>(tc->m_workers.size());
+			}
+
+			tc->m_async_updates++;
+			tc->m_async_rows += num_jobs;
+			tc->m_async_blocks += blocks;
+		}
+		else
+		{
+			for (u32 i = 0; i < num_jobs; i++)
+				ConvertPageRow(jobs[i]);
+		}
+
+		if (blocks > 0)
+		{
+			g_perfmon.Put(GSPerfMon::Unswizzle, bs.x * bs.y * blocks << shift);
+		}
+
+		return true;
+	}
+
 	GSOffset::BNHelper bn = off.bnMulti(r.left, r.top);
 
 	if (m_repeating)
@@ -310,6 +416,59 @@ bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
 	return true;
 }
 
+void GSTextureCacheSW::Texture::WaitForRect(const GSVector4i& r) const
+{
+	const int shift = std::countr_zero(static_cast<u32>(GSLocalMemory::m_psm[m_TEX0.PSM].pgs.y));
+	const u32 first = std::min<u32>(std::max(r.top, 0) >> shift, MAX_PAGE_ROWS - 1);
+	const u32 last = std::min<u32>(std::max(r.bottom - 1, 0) >> shift, MAX_PAGE_ROWS - 1);
+
+	for (u32 i = first; i <= last; i++)
+	{
+		while (m_pending_rows[i].load(std::memory_order_acquire) != 0)
+			Threading::SpinWait();
+	}
+}
+
+void GSTextureCacheSW::Texture::WaitForAll() const
+{
+	for (const std::atomic<u16>& pending : m_pending_rows)
+	{
+		while (pending.load(std::memory_order_acquire) != 0)
+			Threading::SpinWait();
+	}
+}
+
+void GSTextureCacheSW::ConvertPageRow(const PageRowJob& job)
+{
+	const Texture* t = job.t;
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[t->m_TEX0.PSM];
+	const GSOffset& off = t->m_offset;
+
+	GSLocalMemory& mem = g_gs_renderer->m_mem;
+
+	const u32 pitch = (1 << t->m_tw) << (psm.pal == 0 ? 2 : 0);
+	const int shift = (psm.pal == 0 ? 2 : 0) + off.blockShiftX();
+	const int block_pitch = pitch * psm.bs.y;
+	const int top = job.top >> off.blockShiftY();
+	const int bottom = job.bottom >> off.blockShiftY();
+	const int right = job.right >> off.blockShiftX();
+
+	u8* dst = static_cast<u8*>(t->m_buff) + pitch * job.top;
+
+	for (GSOffset::BNHelper bn = off.bnMulti(job.left, job.top); bn.blkY() < bottom; bn.nextBlockY(), dst += block_pitch)
+	{
+		for (; bn.blkX() < right; bn.nextBlockX())
+		{
+			const u32 bit = ((bn.blkY() - top) << 7) + bn.blkX();
+
+			if (job.mask[bit >> 5] & (1u << (bit & 31)))
+			{
+				psm.rtxbP(mem, bn.value(), &dst[bn.blkX() << shift], pitch, t->m_TEXA);
+			}
+		}
+	}
+}
+
 bool GSTextureCacheSW::Texture::Save(const std::string& fn) const
 {
 	const u32* RESTRICT clut = g_gs_renderer->m_mem.m_clut;
@@ -5,11 +5,16 @@
 
 #include "GS/Renderers/Common/GSRenderer.h"
 #include "GS/Renderers/Common/GSFastList.h"
+#include "GS/GSJobQueue.h"
+#include <atomic>
 #include <unordered_set>
 
 class GSTextureCacheSW
 {
 public:
+	/// Rows of pages tracked for asynchronous conversion, 1024 texels high with the shortest (32 texel) pages.
+	static constexpr u32 MAX_PAGE_ROWS = 32;
+
 	class Texture
 	{
 	public:
@@ -27,6 +32,9 @@ public:
 		std::array<u16, GS_MAX_PAGES> m_erase_it;
 		const u32* RESTRICT m_sharedbits;
 
+		/// Conversions still queued or running on the cache's worker threads, per row of pages.
+		std::array<std::atomic<u16>, MAX_PAGE_ROWS> m_pending_rows = {};
+
 		// m_valid
 		// fast mode: each u32 bits map to the 32 blocks of that page
 		// repeating mode: 1 bpp image of the texture tiles (8x8), also having 512 elements is just a coincidence (worst case: (1024*1024)/(8*8)/(sizeof(u32)*8))
@@ -36,16 +44,47 @@ public:
 
 		void Reset(u32 tw0, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA);
 
-		bool Update(const GSVector4i& r);
+		/// Converts the invalid blocks within r. When tc has worker threads, large updates are split
+		/// into rows of pages and converted asynchronously, use WaitForRect() before sampling.
+		bool Update(const GSVector4i& r, GSTextureCacheSW* tc = nullptr);
 		bool Save(const std::string& fn) const;
+
+		/// Waits for asynchronous conversions of the rows of pages overlapping r.
+		void WaitForRect(const GSVector4i& r) const;
+		void WaitForAll() const;
 	};
 
 protected:
+	/// Minimum amount of work before an update is handed to the workers, smaller ones are converted inline.
+	static constexpr u32 ASYNC_MIN_ROWS = 2;
+	static constexpr u32 ASYNC_MIN_BLOCKS = 64;
+
+	/// Blocks which one update claimed in a single row of pages.
+	/// Pages are at most 8 blocks high, and textures at most 128 blocks wide.
+	struct PageRowJob
+	{
+		Texture* t;
+		u32 row;
+		u16 left, top, right, bottom; // in texels, block aligned
+		u32 blocks;
+		u32 mask[(8 * 128) / 32]; // bit ((y - top) * 128 + x) in blocks
+	};
+
+	using GSWorker = GSJobQueue<PageRowJob, 256>;
+
 	std::unordered_set<Texture*> m_textures;
 	std::array<FastList<Texture*>, GS_MAX_PAGES> m_map;
+	std::vector<std::unique_ptr<GSWorker>> m_workers;
+	u32 m_next_worker = 0;
+
+	u64 m_async_updates = 0;
+	u64 m_async_rows = 0;
+	u64 m_async_blocks = 0;
+
+	static void ConvertPageRow(const PageRowJob& job);
 
 public:
-	GSTextureCacheSW();
+	GSTextureCacheSW(int threads = 0);
 	virtual ~GSTextureCacheSW();
 
 	Texture* Lookup(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, u32 tw0 = 0);
@@ -54,4 +93,7 @@ public:
 
 	void RemoveAll();
 	void IncAge();
+
+	/// Returns true if texture updates may complete asynchronously.
+	bool HasWorkers() const { return !m_workers.empty(); }
 };
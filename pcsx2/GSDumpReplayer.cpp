@@ -2,7 +2,10 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "GS.h"
+#include "GS/GSDump.h"
 #include "GS/GSLzma.h"
+#include "GS/GSPerfMon.h"
+#include "GS/GSState.h"
 #include "GSDumpReplayer.h"
 #include "GameList.h"
 #include "Gif.h"
@@ -38,6 +41,10 @@ static void GSDumpReplayerCancelInstruction();
 static void GSDumpReplayerCpuClear(u32 addr, u32 size);
 
 static std::unique_ptr<GSDumpFile> s_dump_file;
+
+// The overlay is drawn on the GS thread, while the dump file is replaced on the CPU thread when streams restart.
+static std::atomic_bool s_overlay_streaming{false};
+static std::atomic<u32> s_overlay_packet_count{0};
 static u32 s_current_packet = 0;
 static u32 s_dump_frame_number = 0;
 static s32 s_dump_loop_count = 0;
@@ -46,6 +53,12 @@ static bool s_needs_state_loaded = false;
 static u64 s_frame_ticks = 0;
 static u64 s_next_frame_time = 0;
 static bool s_is_dump_runner = false;
+static bool s_dump_streaming = false;
+static std::string s_dump_filename;
+static bool s_has_seek_target = false;
+static u32 s_seek_frame = 0;
+static u64 s_seek_draw = 0;
+static bool s_load_next_keyframe = false;
 
 R5900cpu GSDumpReplayerCpu = {
 	GSDumpReplayerCpuReserve,
@@ -85,22 +98,78 @@ int GSDumpReplayer::GetLoopCount()
 	return s_dump_loop_count;
 }
 
+void GSDumpReplayer::SetStreaming(bool enabled)
+{
+	s_dump_streaming = enabled;
+}
+
+void GSDumpReplayer::SetSeekTarget(u32 frame, u64 draw)
+{
+	s_has_seek_target = true;
+	s_seek_frame = frame;
+	s_seek_draw = draw;
+}
+
+static void GSDumpReplayerSetDumpFile(std::unique_ptr<GSDumpFile> dump)
+{
+	s_dump_file = std::move(dump);
+	s_overlay_streaming.store(s_dump_file && s_dump_file->IsStreaming(), std::memory_order_release);
+	s_overlay_packet_count.store(s_dump_file ? static_cast<u32>(s_dump_file->GetPackets().size()) : 0,
+		std::memory_order_release);
+}
+
+static std::unique_ptr<GSDumpFile> GSDumpReplayerOpenDump(const char* filename, bool seek, Error* error)
+{
+	std::unique_ptr<GSDumpFile> dump = GSDumpFile::OpenGSDump(filename, error);
+	if (!dump)
+		return dump;
+
+	if (s_dump_streaming)
+	{
+		if (!dump->ReadHeader(error))
+			return {};
+
+		// Streams can only be positioned before the reader starts, fully loaded dumps seek on state load.
+		s_load_next_keyframe = false;
+		if (seek && s_has_seek_target && dump->ReadKeyframeIndex())
+		{
+			if (const GSDumpKeyframeIndexEntry* keyframe = dump->FindKeyframe(s_seek_frame, s_seek_draw))
+			{
+				if (!dump->SeekToKeyframe(*keyframe, error))
+					return {};
+
+				s_load_next_keyframe = true;
+			}
+		}
+
+		dump->StartStreaming();
+	}
+	else if (!dump->ReadFile(error))
+	{
+		return {};
+	}
+
+	return dump;
+}
+
 bool GSDumpReplayer::Initialize(const char* filename, Error* error)
 {
 	Common::Timer timer;
 	Console.WriteLn("(GSDumpReplayer) Reading file '%s'...", filename);
 
 	Error dump_error;
-	s_dump_file = GSDumpFile::OpenGSDump(filename, &dump_error);
-	if (!s_dump_file || !s_dump_file->ReadFile(&dump_error))
+	std::unique_ptr<GSDumpFile> dump = GSDumpReplayerOpenDump(filename, true, &dump_error);
+	if (!dump)
 	{
 		Error::SetStringFmt(error, TRANSLATE_FS("GSDumpReplayer", "Failed to open or read '{}': {}"),
 			Path::GetFileName(filename), dump_error.GetDescription());
-		s_dump_file.reset();
 		return false;
 	}
 
+	GSDumpReplayerSetDumpFile(std::move(dump));
+
 	Console.WriteLn("(GSDumpReplayer) Read file in %.2f ms.", timer.GetTimeMilliseconds());
+	s_dump_filename = filename;
 
 	// We replace all CPUs.
 	Cpu = &GSDumpReplayerCpu;
@@ -125,15 +194,16 @@ bool GSDumpReplayer::ChangeDump(const char* filename)
 	}
 
 	Error error;
-	std::unique_ptr<GSDumpFile> new_dump(GSDumpFile::OpenGSDump(filename));
-	if (!new_dump || !new_dump->ReadFile(&error))
+	std::unique_ptr<GSDumpFile> new_dump(GSDumpReplayerOpenDump(filename, true, &error));
+	if (!new_dump)
 	{
 		Host::ReportErrorAsync("GSDumpReplayer", fmt::format("Failed to open or read '{}': {}",
 													 Path::GetFileName(filename), error.GetDescription()));
 		return false;
 	}
 
-	s_dump_file = std::move(new_dump);
+	GSDumpReplayerSetDumpFile(std::move(new_dump));
+	s_dump_filename = filename;
 	s_current_packet = 0;
 
 	// Don't forget to reset the GS!
@@ -149,7 +219,8 @@ void GSDumpReplayer::Shutdown()
 	psxCpu = nullptr;
 	CpuVU0 = nullptr;
 	CpuVU1 = nullptr;
-	s_dump_file.reset();
+	GSDumpReplayerSetDumpFile(nullptr);
+	s_dump_filename = {};
 }
 
 std::string GSDumpReplayer::GetDumpSerial()
@@ -191,8 +262,28 @@ void GSDumpReplayerCpuShutdown()
 {
 }
 
+// Streamed dumps can't seek, so going back to the first packet means opening the file again.
+static bool GSDumpReplayerRestartStream(bool seek)
+{
+	Error error;
+	std::unique_ptr<GSDumpFile> dump = GSDumpReplayerOpenDump(s_dump_filename.c_str(), seek, &error);
+	if (!dump)
+	{
+		Host::ReportErrorAsync("GSDumpReplayer", fmt::format("Failed to reopen '{}': {}",
+													 Path::GetFileName(s_dump_filename), error.GetDescription()));
+		return false;
+	}
+
+	GSDumpReplayerSetDumpFile(std::move(dump));
+	s_current_packet = 0;
+	return true;
+}
+
 void GSDumpReplayerCpuReset()
 {
+	if (s_dump_file->IsStreaming() && s_current_packet != 0)
+		GSDumpReplayerRestartStream(true);
+
 	s_needs_state_loaded = true;
 	s_current_packet = 0;
 	s_dump_frame_number = 0;
@@ -213,6 +304,68 @@ static void GSDumpReplayerLoadInitialState()
 		Host::ReportFormattedErrorAsync("GSDumpReplayer", "Failed to load GS state.");
 }
 
+static void GSDumpReplayerLoadKeyframe(const GSDumpFile::GSData& packet)
+{
+	GSDumpKeyframe keyframe = {};
+	if (packet.length >= sizeof(keyframe))
+		std::memcpy(&keyframe, packet.data, sizeof(keyframe));
+	if (packet.length < (sizeof(keyframe) + keyframe.state_size + Ps2MemSize::GSregs))
+	{
+		Host::ReportFormattedErrorAsync("GSDumpReplayer", "Keyframe packet is corrupted.");
+		return;
+	}
+
+	const u8* state = packet.data + sizeof(keyframe);
+	std::memcpy(PS2MEM_GS, state + keyframe.state_size, Ps2MemSize::GSregs);
+
+	freezeData fd = {static_cast<int>(keyframe.state_size), const_cast<u8*>(state)};
+	MTGS::FreezeData mfd = {&fd, 0};
+	MTGS::Freeze(FreezeAction::Load, mfd);
+	if (mfd.retval != 0)
+	{
+		Host::ReportFormattedErrorAsync("GSDumpReplayer", "Failed to load GS keyframe state.");
+		return;
+	}
+
+	// Keep frame and draw numbers in line with playing from the start, so dump ranges still match.
+	s_dump_frame_number = keyframe.frame;
+	MTGS::RunOnGSThread([frame = keyframe.frame, draw = keyframe.draw]() {
+		GSState::s_n = draw;
+		g_perfmon.SetFrame(static_cast<int>(frame));
+	});
+
+	Console.WriteLn("(GSDumpReplayer) Seeked to keyframe at frame %u, draw %llu.", keyframe.frame,
+		static_cast<unsigned long long>(keyframe.draw));
+}
+
+static void GSDumpReplayerSeekToTarget()
+{
+	if (!s_has_seek_target || s_dump_file->IsStreaming())
+		return;
+
+	const GSDumpFile::GSDataArray& packets = s_dump_file->GetPackets();
+	std::optional<u32> target_packet;
+	for (u32 i = 0; i < static_cast<u32>(packets.size()); i++)
+	{
+		const GSDumpFile::GSData& packet = packets[i];
+		if (packet.id != GSDumpTypes::GSType::Keyframe || packet.length < sizeof(GSDumpKeyframe))
+			continue;
+
+		GSDumpKeyframe keyframe;
+		std::memcpy(&keyframe, packet.data, sizeof(keyframe));
+		if (keyframe.frame > s_seek_frame || keyframe.draw > s_seek_draw)
+			break;
+
+		target_packet = i;
+	}
+
+	if (target_packet.has_value())
+	{
+		s_current_packet = target_packet.value();
+		s_load_next_keyframe = true;
+	}
+}
+
 static void GSDumpReplayerSendPacketToMTGS(GIF_PATH path, const u8* data, size_t length)
 {
 	pxAssert((length % 16) == 0 && length < UINT32_MAX);
@@ -256,28 +409,68 @@ static void GSDumpReplayerFrameLimit()
 	s_next_frame_time = std::max(now, s_next_frame_time + s_frame_ticks);
 }
 
-void GSDumpReplayerCpuStep()
+static void GSDumpReplayerEndOfDump()
 {
-	if (s_needs_state_loaded)
+	s_dump_frame_number = 0;
+	if (s_dump_loop_count > 0)
+		s_dump_loop_count--;
+	else if (s_dump_loop_count == 0)
 	{
-		GSDumpReplayerLoadInitialState();
-		s_needs_state_loaded = false;
+		Host::RequestVMShutdown(false, false, false);
+		s_dump_running = false;
 	}
+}
+
+static const GSDumpFile::GSData* GSDumpReplayerNextPacket()
+{
+	const GSDumpFile::GSData* packet;
+	if (s_dump_file->IsStreaming())
+		packet = s_dump_file->GetNextPacket();
+	else if (s_current_packet < s_dump_file->GetPackets().size())
+		packet = &s_dump_file->GetPackets()[s_current_packet];
+	else
+		packet = nullptr;
 
-	const GSDumpFile::GSData& packet = s_dump_file->GetPackets()[s_current_packet];
-	s_current_packet = (s_current_packet + 1) % static_cast<u32>(s_dump_file->GetPackets().size());
-	if (s_current_packet == 0)
+	// The end is only seen after the last packet, so loop handling happens on the following step.
+	if (!packet)
 	{
-		s_dump_frame_number = 0;
-		if (s_dump_loop_count > 0)
-			s_dump_loop_count--;
-		else if (s_dump_loop_count == 0)
+		GSDumpReplayerEndOfDump();
+		if (!s_dump_running)
+			return nullptr;
+
+		s_current_packet = 0;
+		if (s_dump_file->IsStreaming())
+			packet = GSDumpReplayerRestartStream(false) ? s_dump_file->GetNextPacket() : nullptr;
+		else if (!s_dump_file->GetPackets().empty())
+			packet = &s_dump_file->GetPackets()[0];
+
+		if (!packet)
 		{
 			Host::RequestVMShutdown(false, false, false);
 			s_dump_running = false;
+			return nullptr;
 		}
 	}
 
+	s_current_packet++;
+	return packet;
+}
+
+void GSDumpReplayerCpuStep()
+{
+	if (s_needs_state_loaded)
+	{
+		GSDumpReplayerLoadInitialState();
+		s_needs_state_loaded = false;
+		GSDumpReplayerSeekToTarget();
+	}
+
+	const GSDumpFile::GSData* next_packet = GSDumpReplayerNextPacket();
+	if (!next_packet)
+		return;
+
+	const GSDumpFile::GSData& packet = *next_packet;
+
 	switch (packet.id)
 	{
 		case GSDumpTypes::GSType::Transfer:
@@ -342,6 +535,20 @@ void GSDumpReplayerCpuStep()
 			std::memcpy(PS2MEM_GS, packet.data, std::min<s32>(static_cast<u32>(packet.length), Ps2MemSize::GSregs));
 		}
 		break;
+
+		case GSDumpTypes::GSType::Keyframe:
+		{
+			// When playing through, the GS already has this state.
+			if (s_load_next_keyframe)
+			{
+				s_load_next_keyframe = false;
+				GSDumpReplayerLoadKeyframe(packet);
+			}
+		}
+		break;
+
+		case GSDumpTypes::GSType::KeyframeIndex:
+			break;
 	}
 }
 
@@ -399,7 +606,10 @@ void GSDumpReplayer::RenderUI()
 	DRAW_LINE(font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
 
 	text.clear();
-	fmt::format_to(std::back_inserter(text), "Packet Number: {}/{}", s_current_packet, static_cast<u32>(s_dump_file->GetPackets().size()));
+	if (s_overlay_streaming.load(std::memory_order_acquire))
+		fmt::format_to(std::back_inserter(text), "Packet Number: {}", s_current_packet);
+	else
+		fmt::format_to(std::back_inserter(text), "Packet Number: {}/{}", s_current_packet, s_overlay_packet_count.load(std::memory_order_acquire));
 	DRAW_LINE(font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
 
 #undef DRAW_LINE
@@ -18,6 +18,13 @@ namespace GSDumpReplayer
 	bool IsRunner();
 	void SetIsDumpRunner(bool is_runner);
 
+	/// Streams packets from disk through a bounded buffer instead of loading the whole dump up front.
+	/// Takes effect the next time a dump is opened.
+	void SetStreaming(bool enabled);
+
+	/// Starts playback at the last keyframe at or before both the frame and the draw, for dumps which have them.
+	void SetSeekTarget(u32 frame, u64 draw);
+
 	bool Initialize(const char* filename, Error* error = nullptr);
 	bool ChangeDump(const char* filename);
 	void Shutdown();
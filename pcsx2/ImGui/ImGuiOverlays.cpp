@@ -366,6 +366,12 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 					else
 						s_software_thread_lines.push_back(SmallString("SW-{}: ", thread));
 					FormatProcessorStat(s_software_thread_lines[thread], PerformanceMetrics::GetGSSWThreadUsage(thread), PerformanceMetrics::GetGSSWThreadAverageTime(thread));
+					if (PerformanceMetrics::HasGSSWThreadWaitTimes(thread))
+					{
+						s_software_thread_lines[thread].append_format(" spin {:.2f}ms sleep {:.2f}ms sync spin {:.2f}ms sleep {:.2f}ms",
+							PerformanceMetrics::GetGSSWThreadSpinTime(thread), PerformanceMetrics::GetGSSWThreadSleepTime(thread),
+							PerformanceMetrics::GetGSSWThreadSyncSpinTime(thread), PerformanceMetrics::GetGSSWThreadSyncSleepTime(thread));
+					}
 					DRAW_LINE(fixed_font, font_size, s_software_thread_lines[thread].c_str(), white_color);
 				}
 
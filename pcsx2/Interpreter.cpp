@@ -288,6 +288,32 @@ void intSetBranch()
 	branch2 = /*cpuRegs.branch =*/ 1;
 }
 
+void intExecuteBlock(u32 max_insts)
+{
+	// Cycles from delay slots executed through intDoBranch() are never flushed under the recompiler.
+	cpuBlockCycles = 0;
+
+	for (u32 i = 0; i < max_insts; i++)
+	{
+		const u32 pc = cpuRegs.pc;
+
+		// Leave breakpoints to the recompiler, it compiles them as individual blocks.
+		if (i != 0 && (isBreakpointNeeded(pc) != 0 || isMemcheckNeeded(pc) != 0))
+			break;
+
+		execI();
+
+		// Taken branches and exceptions leave the sequential path. Stopping anywhere else is fine,
+		// as the next block simply starts at the following instruction.
+		if (cpuRegs.pc != pc + 4)
+			break;
+	}
+
+	// Taken branches have already added their cycles.
+	if (cpuBlockCycles >= 8)
+		intUpdateCPUCycles();
+}
+
 ////////////////////////////////////////////////////////////////////
 // R5900 Branching Instructions!
 // These are the interpreter versions of the branch instructions.  Unlike other
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "Common.h"
+#include "DebugTools/JitProfiler.h"
 #include "Gif_Unit.h"
 #include "MTVU.h"
 #include "VMManager.h"
@@ -128,6 +129,7 @@ void VU_Thread::Reset()
 void VU_Thread::ExecuteRingBuffer()
 {
 	Threading::SetNameOfCurrentThread("MTVU");
+	JitProfiler::RegisterThread("MTVU");
 
 	for (;;)
 	{
@@ -204,6 +206,7 @@ void VU_Thread::ExecuteRingBuffer()
 		}
 	}
 
+	JitProfiler::UnregisterThread();
 	semaEvent.Kill();
 }
 
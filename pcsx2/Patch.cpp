@@ -1195,6 +1195,11 @@ void Patch::ApplyDynamicPatches(u32 pc)
 		ApplyDynaPatch(dynpatch, pc);
 }
 
+bool Patch::HasDynamicPatches()
+{
+	return !s_active_pnach_dynamic_patches.empty() || !s_active_gamedb_dynamic_patches.empty();
+}
+
 void Patch::LoadDynamicPatches(const std::vector<DynamicPatch>& patches)
 {
 	for (const DynamicPatch& it : patches)
@@ -97,6 +97,7 @@ namespace Patch
 	// Functions for Dynamic EE patching.
 	extern void LoadDynamicPatches(const std::vector<DynamicPatch>& patches);
 	extern void ApplyDynamicPatches(u32 pc);
+	extern bool HasDynamicPatches();
 
 	// Apply all loaded patches that should be applied when the entry point is
 	// being recompiled.
@@ -454,6 +454,9 @@ Pcsx2Config::RecompilerOptions::RecompilerOptions()
 	EnableVU1 = true;
 	EnableFastmem = true;
 	PauseOnTLBMiss = false;
+	EnableEETranslationCache = false;
+	EnableEESuperblocks = false;
+	EnableEEDeferredCompilation = false;
 
 	// vu and fpu clamping default to standard overflow.
 	vu0Overflow = true;
@@ -532,6 +535,9 @@ void Pcsx2Config::RecompilerOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(EnableVU1);
 	SettingsWrapBitBool(EnableFastmem);
 	SettingsWrapBitBool(PauseOnTLBMiss);
+	SettingsWrapBitBool(EnableEETranslationCache);
+	SettingsWrapBitBool(EnableEESuperblocks);
+	SettingsWrapBitBool(EnableEEDeferredCompilation);
 
 	SettingsWrapBitBool(vu0Overflow);
 	SettingsWrapBitBool(vu0ExtraOverflow);
@@ -696,6 +702,7 @@ const char* Pcsx2Config::GSOptions::GetRendererName(GSRendererType type)
 		case GSRendererType::VK:    return "Vulkan";
 		case GSRendererType::SW:    return "Software";
 		case GSRendererType::Null:  return "Null";
+		case GSRendererType::NullHW: return "Null (Hardware)";
 		default:                    return "";
 			// clang-format on
 	}
@@ -748,6 +755,11 @@ Pcsx2Config::GSOptions::GSOptions()
 	HWSpinCPUForReadbacks = false;
 	GPUPaletteConversion = false;
 	AutoFlushSW = true;
+	SWExtraThreadsTiled = false;
+	SWSelectorProfiling = false;
+	SWParallelTextureUpdate = false;
+	SWDrawCoalescing = false;
+	SWHierarchicalZ = false;
 	PreloadFrameWithGSData = false;
 	Mipmap = true;
 	HWMipmap = true;
@@ -767,6 +779,7 @@ Pcsx2Config::GSOptions::GSOptions()
 	UserHacks_BilinearHack = GSBilinearDirtyMode::Automatic;
 	UserHacks_NativePaletteDraw = false;
 
+	GSDumpKeyframes = false;
 	DumpReplaceableTextures = false;
 	DumpReplaceableMipmaps = false;
 	DumpTexturesWithFMVActive = false;
@@ -823,12 +836,15 @@ bool Pcsx2Config::GSOptions::OptionsAreEqual(const GSOptions& right) const
 		OpEqu(TextureFiltering) &&
 		OpEqu(TexturePreloading) &&
 		OpEqu(GSDumpCompression) &&
+		OpEqu(GSDumpCompressionLevel) &&
 		OpEqu(HWDownloadMode) &&
 		OpEqu(CASMode) &&
 		OpEqu(Dithering) &&
 		OpEqu(MaxAnisotropy) &&
+		OpEqu(TextureHashCacheBudget) &&
 		OpEqu(SWExtraThreads) &&
 		OpEqu(SWExtraThreadsHeight) &&
+		OpEqu(SWWorkerWait) &&
 		OpEqu(TriFilter) &&
 		OpEqu(TVShader) &&
 		OpEqu(GetSkipCountFunctionId) &&
@@ -990,6 +1006,7 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBoolEx(FXAA, "fxaa");
 	SettingsWrapBitBool(ShadeBoost);
 	SettingsWrapBitBoolEx(DumpGSData, "DumpGSData");
+	SettingsWrapBitBoolEx(GSDumpKeyframes, "GSDumpKeyframes");
 	SettingsWrapBitBoolEx(SaveRT, "SaveRT");
 	SettingsWrapBitBoolEx(SaveFrame, "SaveFrame");
 	SettingsWrapBitBoolEx(SaveTexture, "SaveTexture");
@@ -1028,7 +1045,9 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapIntEnumEx(AccurateBlendingUnit, "accurate_blending_unit");
 	SettingsWrapIntEnumEx(TextureFiltering, "filter");
 	SettingsWrapIntEnumEx(TexturePreloading, "texture_preloading");
+	SettingsWrapBitfieldEx(TextureHashCacheBudget, "TextureHashCacheBudget");
 	SettingsWrapIntEnumEx(GSDumpCompression, "GSDumpCompression");
+	SettingsWrapBitfieldEx(GSDumpCompressionLevel, "GSDumpCompressionLevel");
 	SettingsWrapIntEnumEx(HWDownloadMode, "HWDownloadMode");
 	SettingsWrapIntEnumEx(CASMode, "CASMode");
 	SettingsWrapBitfieldEx(CAS_Sharpness, "CASSharpness");
@@ -1036,6 +1055,12 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitfieldEx(MaxAnisotropy, "MaxAnisotropy");
 	SettingsWrapBitfieldEx(SWExtraThreads, "extrathreads");
 	SettingsWrapBitfieldEx(SWExtraThreadsHeight, "extrathreads_height");
+	SettingsWrapIntEnumEx(SWWorkerWait, "SWWorkerWait");
+	SettingsWrapBitBoolEx(SWExtraThreadsTiled, "extrathreads_tiled");
+	SettingsWrapBitBoolEx(SWSelectorProfiling, "SWSelectorProfiling");
+	SettingsWrapBitBoolEx(SWParallelTextureUpdate, "SWParallelTextureUpdate");
+	SettingsWrapBitBoolEx(SWDrawCoalescing, "SWDrawCoalescing");
+	SettingsWrapBitBoolEx(SWHierarchicalZ, "SWHierarchicalZ");
 	SettingsWrapBitfieldEx(TVShader, "TVShader");
 	SettingsWrapBitfieldEx(SkipDrawStart, "UserHacks_SkipDraw_Start");
 	SettingsWrapBitfieldEx(SkipDrawEnd, "UserHacks_SkipDraw_End");
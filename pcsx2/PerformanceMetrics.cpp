@@ -57,12 +57,45 @@ static float s_capture_thread_time = 0.0f;
 static PerformanceMetrics::FrameTimeHistory s_frame_time_history;
 static u32 s_frame_time_history_pos = 0;
 
+struct GSSWWaitStats
+{
+	const Threading::WorkSemaWaitTimes* totals = nullptr;
+	u64 last_spin_ns = 0;
+	u64 last_sleep_ns = 0;
+	double spin_time = 0.0;
+	double sleep_time = 0.0;
+
+	void Reset()
+	{
+		if (!totals)
+			return;
+
+		last_spin_ns = totals->spin_ns.load(std::memory_order_relaxed);
+		last_sleep_ns = totals->sleep_ns.load(std::memory_order_relaxed);
+	}
+
+	void Update(double ns_divider)
+	{
+		if (!totals)
+			return;
+
+		const u64 spin_ns = totals->spin_ns.load(std::memory_order_relaxed);
+		const u64 sleep_ns = totals->sleep_ns.load(std::memory_order_relaxed);
+		spin_time = static_cast<double>(spin_ns - last_spin_ns) * ns_divider;
+		sleep_time = static_cast<double>(sleep_ns - last_sleep_ns) * ns_divider;
+		last_spin_ns = spin_ns;
+		last_sleep_ns = sleep_ns;
+	}
+};
+
 struct GSSWThreadStats
 {
 	Threading::ThreadHandle handle;
 	u64 last_cpu_time = 0;
 	double usage = 0.0;
 	double time = 0.0;
+	GSSWWaitStats work_wait;
+	GSSWWaitStats sync_wait;
 };
 std::vector<GSSWThreadStats> s_gs_sw_threads;
 
@@ -123,7 +156,11 @@ void PerformanceMetrics::Reset()
 	s_last_capture_time = GSCapture::IsCapturing() ? GSCapture::GetEncoderThreadHandle().GetCPUTime() : 0;
 
 	for (GSSWThreadStats& stat : s_gs_sw_threads)
+	{
 		stat.last_cpu_time = stat.handle.GetCPUTime();
+		stat.work_wait.Reset();
+		stat.sync_wait.Reset();
+	}
 }
 
 void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_skipping_present)
@@ -212,6 +249,8 @@ void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_sk
 	s_vu_thread_time = static_cast<double>(vu_delta) * time_divider;
 	s_capture_thread_time = static_cast<double>(capture_delta) * time_divider;
 
+	// Wait totals are kept in nanoseconds, report them in milliseconds per frame like the thread times.
+	const double ns_divider = (1.0 / 1000000.0) * (1.0 / static_cast<double>(s_frames_since_last_update));
 	for (GSSWThreadStats& thread : s_gs_sw_threads)
 	{
 		const u64 time = thread.handle.GetCPUTime();
@@ -219,6 +258,8 @@ void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_sk
 		thread.last_cpu_time = time;
 		thread.usage = static_cast<double>(delta) * pct_divider;
 		thread.time = static_cast<double>(delta) * time_divider;
+		thread.work_wait.Update(ns_divider);
+		thread.sync_wait.Update(ns_divider);
 	}
 
 	s_frames_since_last_update = 0;
@@ -252,6 +293,14 @@ void PerformanceMetrics::SetGSSWThread(u32 index, Threading::ThreadHandle thread
 	s_gs_sw_threads[index].handle = std::move(thread);
 }
 
+void PerformanceMetrics::SetGSSWThreadWaitTimes(u32 index, const Threading::WorkSemaWaitTimes* work, const Threading::WorkSemaWaitTimes* sync)
+{
+	s_gs_sw_threads[index].work_wait = {work};
+	s_gs_sw_threads[index].work_wait.Reset();
+	s_gs_sw_threads[index].sync_wait = {sync};
+	s_gs_sw_threads[index].sync_wait.Reset();
+}
+
 u64 PerformanceMetrics::GetFrameNumber()
 {
 	return s_frame_number;
@@ -352,6 +401,37 @@ double PerformanceMetrics::GetGSSWThreadAverageTime(u32 index)
 	return s_gs_sw_threads[index].time;
 }
 
+bool PerformanceMetrics::HasGSSWThreadWaitTimes(u32 index)
+{
+	return (s_gs_sw_threads[index].work_wait.totals != nullptr);
+}
+
+double PerformanceMetrics::GetGSSWThreadSpinTime(u32 index)
+{
+	return s_gs_sw_threads[index].work_wait.spin_time;
+}
+
+double PerformanceMetrics::GetGSSWThreadSleepTime(u32 index)
+{
+	return s_gs_sw_threads[index].work_wait.sleep_time;
+}
+
+double PerformanceMetrics::GetGSSWThreadSyncSpinTime(u32 index)
+{
+	return s_gs_sw_threads[index].sync_wait.spin_time;
+}
+
+double PerformanceMetrics::GetGSSWThreadSyncSleepTime(u32 index)
+{
+	return s_gs_sw_threads[index].sync_wait.sleep_time;
+}
+
+u64 PerformanceMetrics::GetGSSWThreadCPUTime(u32 index)
+{
+	const Threading::ThreadHandle& handle = s_gs_sw_threads[index].handle;
+	return handle ? handle.GetCPUTime() : 0;
+}
+
 float PerformanceMetrics::GetGPUUsage()
 {
 	return s_gpu_usage;
@@ -29,6 +29,9 @@ namespace PerformanceMetrics
 	/// Sets timers for GS software threads.
 	void SetGSSWThreadCount(u32 count);
 	void SetGSSWThread(u32 index, Threading::ThreadHandle thread);
+	/// Sets the wait totals for a GS software thread, `work` for the worker waiting on the GS thread, `sync` for the other way around.
+	/// The totals must stay alive until the thread count is reset.
+	void SetGSSWThreadWaitTimes(u32 index, const Threading::WorkSemaWaitTimes* work, const Threading::WorkSemaWaitTimes* sync);
 
 	u64 GetFrameNumber();
 
@@ -54,6 +57,13 @@ namespace PerformanceMetrics
 	u32 GetGSSWThreadCount();
 	double GetGSSWThreadUsage(u32 index);
 	double GetGSSWThreadAverageTime(u32 index);
+	bool HasGSSWThreadWaitTimes(u32 index);
+	double GetGSSWThreadSpinTime(u32 index);
+	double GetGSSWThreadSleepTime(u32 index);
+	double GetGSSWThreadSyncSpinTime(u32 index);
+	double GetGSSWThreadSyncSleepTime(u32 index);
+	/// Returns the CPU time consumed by a GS software thread so far, at the Threading::GetThreadTicksPerSecond() frequency.
+	u64 GetGSSWThreadCPUTime(u32 index);
 
 	float GetGPUUsage();
 	float GetGPUAverageTime();
@@ -290,6 +290,11 @@ void intSetBranch();
 // parts of the Recs (namely COP0's branch codes and stuff).
 void intDoBranch(u32 target);
 
+// Interprets guest code from cpuRegs.pc on behalf of the recompiler, for blocks it hasn't compiled.
+// Stops after a taken branch or an exception, or after max_insts instructions. Events are only
+// tested at taken branches, and the caller is expected to dispatch from cpuRegs.pc afterwards.
+void intExecuteBlock(u32 max_insts);
+
 // modules loaded at hardcoded addresses by the kernel
 const u32 EEKERNEL_START	= 0;
 const u32 EENULL_START		= 0x81FC0;
@@ -514,7 +514,10 @@ __noinline static void RaiseAddressError(u32 addr, bool store)
 	// TODO: This doesn't actually get raised in the CPU yet.
 	Console.Error(message);
 
-	Cpu->CancelInstruction();
+	// Blocks interpreted on behalf of the recompiler can't be cancelled. Carry on with the
+	// access instead, the same as compiled code, which doesn't check alignment.
+	if (Cpu == &intCpu)
+		Cpu->CancelInstruction();
 }
 
 void LB()
@@ -8,6 +8,7 @@
 #include "Counters.h"
 #include "DEV9/DEV9.h"
 #include "DebugTools/DebugInterface.h"
+#include "DebugTools/JitProfiler.h"
 #include "DebugTools/SymbolImporter.h"
 #include "Elfheader.h"
 #include "FW.h"
@@ -374,6 +375,7 @@ bool VMManager::Internal::CPUThreadInitialize()
 {
 	Threading::SetNameOfCurrentThread("CPU Thread");
 	PerformanceMetrics::SetCPUThread(Threading::ThreadHandle::GetForCallingThread());
+	JitProfiler::RegisterThread("CPU");
 
 	// On Win32, we have a bunch of things which use COM (e.g. SDL, XAudio2, etc).
 	// We need to initialize COM first, before anything else does, because otherwise they might
@@ -440,6 +442,7 @@ void VMManager::Internal::CPUThreadShutdown()
 	WaitForSaveStateFlush();
 
 	PerformanceMetrics::SetCPUThread(Threading::ThreadHandle());
+	JitProfiler::UnregisterThread();
 
 	USBshutdown();
 
@@ -1594,6 +1597,9 @@ VMBootResult VMManager::Initialize(const VMBootParameters& boot_params, Error* e
 
 	SetEmuThreadAffinities();
 
+	// Nothing has been compiled yet, so the profiler sees every block.
+	JitProfiler::ApplyConfig(EmuConfig.Profiler);
+
 	// do we want to load state?
 	if (!GSDumpReplayer::IsReplayingDump() && !state_to_load.empty())
 	{
@@ -1621,6 +1627,8 @@ void VMManager::Shutdown(bool save_resume_state)
 		vu1Thread.WaitVU();
 	MTGS::WaitGS();
 
+	JitProfiler::Stop();
+
 	if (!GSDumpReplayer::IsReplayingDump() && save_resume_state)
 	{
 		std::string resume_file_name(GetCurrentSaveStateFileName(-1));
@@ -2908,6 +2916,11 @@ void VMManager::CheckForCPUConfigChanges(const Pcsx2Config& old_config)
 
 	Console.WriteLn("Updating CPU configuration...");
 	FPControlRegister::SetCurrent(EmuConfig.Cpu.FPUFPCR);
+
+	// Must happen before the caches are cleared, blocks are only registered while profiling.
+	if (EmuConfig.Profiler != old_config.Profiler)
+		JitProfiler::ApplyConfig(EmuConfig.Profiler);
+
 	Internal::ClearCPUExecutionCaches();
 	memBindConditionalHandlers();
 
@@ -1405,6 +1405,19 @@ void vtlb_Core_Free()
 // is 4096 (4k), which is why you'll see a lot of 0xfff's, >><< 12's, and 0x1000's in the
 // code below.
 //
+// Sub-page Granularity:
+// Host protection can't be finer than a page, but each page also records which 256 byte
+// granules hold recompiled code, and how often a write fault landed on a granule which held
+// none.  A page which keeps faulting on data next to its code is 'mixed': re-protecting it
+// only leads to another fault and another recompile of every block in the page, so the
+// recompiler leaves such pages under manual protection, where a write only discards the
+// blocks it actually overlaps.
+//
+
+static constexpr u32 SMC_GRANULE_SHIFT = 8;
+static constexpr u32 SMC_MIXED_PAGE_FAULTS = 2;
+
+vtlb_SMCCounters mmap_SMCCounters;
 
 struct vtlb_PageProtectionInfo
 {
@@ -1416,6 +1429,12 @@ struct vtlb_PageProtectionInfo
 	u32 ReverseRamMap;
 
 	vtlb_ProtectionMode Mode;
+
+	// Bit per granule which contains recompiled code. Cleared along with the page's blocks.
+	u16 CodeGranules;
+
+	// Number of write faults which hit a granule without code (saturating).
+	u8 DataFaults;
 };
 
 alignas(16) static vtlb_PageProtectionInfo m_PageProtectInfo[Ps2MemSize::TotalRam >> __pageshift];
@@ -1470,6 +1489,36 @@ void mmap_MarkCountedRamPage(u32 paddr)
 	vtlb_UpdateFastmemProtection(rampage << __pageshift, __pagesize, PageAccess_ReadOnly());
 }
 
+// paddr - physically mapped PS2 address
+// size - size of the recompiled block in bytes. Blocks never cross a page.
+void mmap_MarkCodeGranules(u32 paddr, u32 size)
+{
+	pxAssert(eeMem);
+
+	uptr ptr = (uptr)PSM(paddr);
+	uptr offset = ptr - (uptr)eeMem->Main;
+	if (!ptr || offset >= Ps2MemSize::ExposedRam || size == 0)
+		return;
+
+	const u32 first = (offset & __pagemask) >> SMC_GRANULE_SHIFT;
+	const u32 last = ((offset & __pagemask) + size - 1) >> SMC_GRANULE_SHIFT;
+	m_PageProtectInfo[offset >> __pageshift].CodeGranules |= static_cast<u16>(((2u << last) - 1) & ~((1u << first) - 1));
+}
+
+// Returns true if the page has repeatedly taken write faults on granules which held no code,
+// i.e. code and frequently written data share the page.
+bool mmap_IsMixedRamPage(u32 paddr)
+{
+	pxAssert(eeMem);
+
+	uptr ptr = (uptr)PSM(paddr);
+	uptr offset = ptr - (uptr)eeMem->Main;
+	if (!ptr || offset >= Ps2MemSize::ExposedRam)
+		return false;
+
+	return (m_PageProtectInfo[offset >> __pageshift].DataFaults >= SMC_MIXED_PAGE_FAULTS);
+}
+
 // offset - offset of address relative to psM.
 // All recompiled blocks belonging to the page are cleared, and any new blocks recompiled
 // from code residing in this page will use manual protection.
@@ -1478,12 +1527,28 @@ static __fi void mmap_ClearCpuBlock(uint offset)
 	pxAssert(eeMem);
 
 	int rampage = offset >> __pageshift;
+	vtlb_PageProtectionInfo& info = m_PageProtectInfo[rampage];
 
 	// Assertion: This function should never be run on a block that's already under
 	// manual protection.  Indicates a logic error in the recompiler or protection code.
-	pxAssertMsg(m_PageProtectInfo[rampage].Mode != ProtMode_Manual,
+	pxAssertMsg(info.Mode != ProtMode_Manual,
 		"Attempted to clear a block that is already under manual protection.");
 
+	// The blocks in the page carry no integrity checks, so all of them have to go once the
+	// page is writable, even when the write only touched data.
+	const u32 granule = (offset & __pagemask) >> SMC_GRANULE_SHIFT;
+	if (info.CodeGranules & (1u << granule))
+	{
+		mmap_SMCCounters.CodeWrites++;
+	}
+	else
+	{
+		mmap_SMCCounters.DataWrites++;
+		if (info.DataFaults != 0xff)
+			info.DataFaults++;
+	}
+	info.CodeGranules = 0;
+
 	HostSys::MemProtect(&eeMem->Main[rampage << __pageshift], __pagesize, PageAccess_ReadWrite());
 	vtlb_UpdateFastmemProtection(rampage << __pageshift, __pagesize, PageAccess_ReadWrite());
 	m_PageProtectInfo[rampage].Mode = ProtMode_Manual;
@@ -1536,6 +1601,14 @@ PageFaultHandler::HandlerResult PageFaultHandler::HandlePageFault(void* exceptio
 void mmap_ResetBlockTracking()
 {
 	//DbgCon.WriteLn( "vtlb/mmap: Block Tracking reset..." );
+	const vtlb_SMCCounters& c = mmap_SMCCounters;
+	if (c.CodeWrites | c.DataWrites | c.PageResets | c.BlockDiscards)
+	{
+		DevCon.WriteLn("vtlb/mmap: SMC faults: %u code, %u data; manual pages reset: %u; manual blocks discarded: %u",
+			c.CodeWrites, c.DataWrites, c.PageResets, c.BlockDiscards);
+	}
+	mmap_SMCCounters = {};
+
 	std::memset(m_PageProtectInfo, 0, sizeof(m_PageProtectInfo));
 	if (eeMem)
 		HostSys::MemProtect(eeMem->Main, Ps2MemSize::ExposedRam, PageAccess_ReadWrite());
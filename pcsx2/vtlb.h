@@ -228,8 +228,21 @@ enum vtlb_ProtectionMode
 	ProtMode_NotRequired // page doesn't require any protection
 };
 
+// Self-modifying code statistics, logged and cleared when block tracking is reset.
+struct vtlb_SMCCounters
+{
+	u32 CodeWrites; // write faults on a sub-page granule which held recompiled code
+	u32 DataWrites; // write faults on a sub-page granule which held no recompiled code
+	u32 PageResets; // manual pages which were cleared and re-protected
+	u32 BlockDiscards; // manual blocks which failed their integrity check
+};
+
+extern vtlb_SMCCounters mmap_SMCCounters;
+
 extern vtlb_ProtectionMode mmap_GetRamPageInfo(u32 paddr);
 extern void mmap_MarkCountedRamPage(u32 paddr);
+extern void mmap_MarkCodeGranules(u32 paddr, u32 size);
+extern bool mmap_IsMixedRamPage(u32 paddr);
 extern void mmap_ResetBlockTracking();
 
 // --------------------------------------------------------------------------------------
@@ -9,6 +9,7 @@
 #include "IopHw.h"
 #include "Common.h"
 #include "VMManager.h"
+#include "DebugTools/JitProfiler.h"
 
 #include <time.h>
 
@@ -883,6 +884,8 @@ void recResetIOP()
 {
 	DevCon.WriteLn("iR3000A Recompiler reset.");
 
+	JitProfiler::InvalidateBlocks(SysMemory::GetIOPRec(), SysMemory::GetIOPRecEnd());
+
 	xSetPtr(SysMemory::GetIOPRec());
 	_DynGen_Dispatchers();
 	recPtr = xGetPtr();
@@ -1762,6 +1765,7 @@ StartRecomp:
 	s_pCurBlockEx->x86size = xGetPtr() - recPtr;
 
 	Perf::iop.RegisterPC((void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
+	JitProfiler::RegisterBlock(JitProfiler::Source::IOP, (void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
 
 	recPtr = xGetPtr();
 
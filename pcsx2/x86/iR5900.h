@@ -67,6 +67,10 @@ void recompileNextInstruction(bool delayslot, bool swapped_delay_slot);
 void SetBranchReg(u32 reg);
 void SetBranchImm(u32 imm);
 
+// used for the two sides of a conditional branch which can be profiled or continued in a superblock
+void SetBranchTaken(u32 imm);
+void SetBranchFallthrough(u32 imm);
+
 void iFlushCall(int flushtype);
 void recBranchCall(void (*func)());
 void recCall(void (*func)());
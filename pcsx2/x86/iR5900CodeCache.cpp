@@ -0,0 +1,860 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Config.h"
+#include "Memory.h"
+#include "R5900.h"
+#include "VMManager.h"
+#include "vtlb.h"
+#include "x86/iR5900CodeCache.h"
+#include "GS/GSXXH.h"
+
+#include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/emitter/x86emitter.h"
+
+#include "fmt/format.h"
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+#if defined(_WIN32)
+#include "common/RedtapeWindows.h"
+#elif defined(__APPLE__)
+#include <dlfcn.h>
+#include <mach-o/getsect.h>
+#include <mach-o/loader.h>
+#else
+#include <dlfcn.h>
+#include <link.h>
+#endif
+
+using namespace x86Emitter;
+
+namespace EE::CodeCache
+{
+	static constexpr u32 CACHE_MAGIC = 0x43524545; // EERC
+	static constexpr u32 CACHE_VERSION = 1;
+
+	// Upper bound on the amount of block data kept in memory/written to disk per title.
+	static constexpr size_t MAX_CACHE_SIZE = 128 * _1mb;
+
+	// Everything we relocate lives above 4GB, so that 32-bit absolute addresses can't refer to it.
+	static constexpr uptr MIN_REGION_ADDRESS = 0x100000000ULL;
+	static constexpr uptr MAX_USER_ADDRESS = 0x800000000000ULL;
+
+	enum RelocationRegion : u8
+	{
+		REGION_BODY,
+		REGION_IMAGE,
+		REGION_DATA,
+		REGION_STUBS,
+		REGION_COUNT
+	};
+
+	enum GuardKind : u32
+	{
+		GUARD_POINTER,
+		GUARD_HANDLER,
+	};
+
+	struct BlockHeader
+	{
+		u32 startpc;
+		u32 endpc;
+		u32 final_pc;
+		u32 flags;
+		u32 guest_size;
+		u32 code_size;
+		u32 num_relocations;
+		u32 num_links;
+		u32 num_loadstores;
+		u32 num_guards;
+	};
+
+	struct RelocationRecord
+	{
+		u32 offset;
+		u8 type;
+		u8 region;
+		u8 bias; // distance from the field to the end of the instruction, for Rel32
+		u8 pad;
+		u64 target_offset;
+	};
+	static_assert(sizeof(RelocationRecord) == 16);
+
+	struct LinkRecord
+	{
+		u32 offset;
+		u32 pc;
+	};
+
+	struct LoadStoreRecord
+	{
+		u32 offset;
+		u32 guest_pc;
+		u32 gpr_bitmask;
+		u32 fpr_bitmask;
+		u8 code_size;
+		u8 address_register;
+		u8 data_register;
+		u8 size_in_bits;
+		u8 is_signed;
+		u8 is_load;
+		u8 is_fpr;
+		u8 pad;
+	};
+
+	struct GuardRecord
+	{
+		u32 vaddr;
+		u32 kind;
+		u64 value;
+	};
+
+	struct CacheStats
+	{
+		u32 hits;
+		u32 misses;
+		u32 rejected;
+		u32 stored;
+		u32 skipped;
+	};
+
+	static bool LoadFromFile();
+	static void WriteToFile();
+	static bool IsBlobValid(const std::vector<u8>& blob);
+	static uptr GetModuleBase(const void* addr);
+	static u64 GetImageHash(uptr image_base);
+	static bool IsInImage(uptr addr);
+	static bool GetConstAccessState(u32 vaddr, GuardRecord* guard);
+	static bool ClassifyTarget(uptr target, const u8* body_start, const u8* body_end, RelocationRegion* region, u64* offset);
+
+	static bool s_active = false;
+	static bool s_dirty = false;
+	static std::string s_cache_path;
+	static u64 s_environment_hash = 0;
+	static std::unordered_map<u64, std::vector<u8>> s_blocks;
+	static size_t s_total_size = 0;
+	static CacheStats s_stats = {};
+
+	static uptr s_image_base = 0;
+	static uptr s_image_lo = 0;
+	static uptr s_image_hi = 0;
+	static const u8* s_stubs_start = nullptr;
+	static const u8* s_stubs_end = nullptr;
+
+	// Block currently being compiled.
+	static bool s_recording = false;
+	static bool s_recording_rejected = false;
+	static u32 s_recording_startpc = 0;
+	static u32 s_recording_endpc = 0;
+	static u32 s_recording_flags = 0;
+	static u8* s_recording_body = nullptr;
+	static std::vector<xRelocation> s_recording_relocations;
+	static std::vector<LinkSite> s_recording_links;
+	static std::vector<std::pair<uptr, LoadStoreRecord>> s_recording_loadstores;
+	static std::vector<GuardRecord> s_recording_guards;
+} // namespace EE::CodeCache
+
+uptr EE::CodeCache::GetModuleBase(const void* addr)
+{
+#ifdef _WIN32
+	HMODULE mod;
+	if (!GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+			static_cast<LPCWSTR>(addr), &mod))
+	{
+		return 0;
+	}
+
+	return reinterpret_cast<uptr>(mod);
+#else
+	Dl_info info;
+	if (!dladdr(addr, &info))
+		return 0;
+
+	return reinterpret_cast<uptr>(info.dli_fbase);
+#endif
+}
+
+// Identifies the exact build of the executable, since any change to the recompiler changes the code
+// it generates. Returns zero if the image can't be identified.
+u64 EE::CodeCache::GetImageHash(uptr image_base)
+{
+	XXH3_state_t state;
+	XXH3_64bits_reset(&state);
+
+#if defined(_WIN32)
+	// The code sections may be relocated at load time, so use the linker's identity for the image instead. The
+	// CodeView record holds the PDB GUID, which is new for every link.
+	const IMAGE_DOS_HEADER* dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(image_base);
+	const IMAGE_NT_HEADERS* nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(image_base + dos->e_lfanew);
+	const IMAGE_DATA_DIRECTORY& debug_dir = nt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_DEBUG];
+	const IMAGE_DEBUG_DIRECTORY* debug = reinterpret_cast<const IMAGE_DEBUG_DIRECTORY*>(image_base + debug_dir.VirtualAddress);
+	bool found = false;
+	for (u32 i = 0; i < debug_dir.Size / sizeof(IMAGE_DEBUG_DIRECTORY); i++)
+	{
+		if (debug[i].Type != IMAGE_DEBUG_TYPE_CODEVIEW || debug[i].AddressOfRawData == 0)
+			continue;
+
+		GSXXH3_64bits_update(&state, reinterpret_cast<const void*>(image_base + debug[i].AddressOfRawData), debug[i].SizeOfData);
+		found = true;
+	}
+
+	if (!found)
+		return 0;
+
+	GSXXH3_64bits_update(&state, &nt->FileHeader, sizeof(nt->FileHeader));
+	GSXXH3_64bits_update(&state, &nt->OptionalHeader.SizeOfImage, sizeof(nt->OptionalHeader.SizeOfImage));
+#elif defined(__APPLE__)
+	unsigned long size = 0;
+	const u8* text = getsectiondata(reinterpret_cast<const mach_header_64*>(image_base), "__TEXT", "__text", &size);
+	if (!text || size == 0)
+		return 0;
+
+	GSXXH3_64bits_update(&state, text, size);
+#else
+	// Position independent code has no text relocations, so the executable segments are identical to the file.
+	struct Search
+	{
+		uptr image_base;
+		XXH3_state_t* state;
+		bool found;
+	};
+	Search search = {image_base, &state, false};
+	dl_iterate_phdr([](dl_phdr_info* info, size_t, void* data) -> int {
+		Search* search = static_cast<Search*>(data);
+		Dl_info dlinfo;
+		if (info->dlpi_phnum == 0 || !dladdr(reinterpret_cast<const void*>(info->dlpi_addr + info->dlpi_phdr[0].p_vaddr), &dlinfo) ||
+			reinterpret_cast<uptr>(dlinfo.dli_fbase) != search->image_base)
+		{
+			return 0;
+		}
+
+		for (u32 i = 0; i < info->dlpi_phnum; i++)
+		{
+			const auto& phdr = info->dlpi_phdr[i];
+			if (phdr.p_type != PT_LOAD || !(phdr.p_flags & PF_X))
+				continue;
+
+			GSXXH3_64bits_update(search->state, reinterpret_cast<const void*>(info->dlpi_addr + phdr.p_vaddr), phdr.p_filesz);
+			search->found = true;
+		}
+
+		return 1;
+	}, &search);
+
+	if (!search.found)
+		return 0;
+#endif
+
+	return GSXXH3_64bits_digest(&state);
+}
+
+bool EE::CodeCache::IsInImage(uptr addr)
+{
+	if (addr >= s_image_lo && addr <= s_image_hi)
+		return true;
+
+	// Module lookups are slow, so remember the range we've already confirmed. Segments of an image
+	// are mapped contiguously, so anything between two confirmed addresses is part of it too.
+	if (GetModuleBase(reinterpret_cast<const void*>(addr)) != s_image_base)
+		return false;
+
+	s_image_lo = std::min(s_image_lo, addr);
+	s_image_hi = std::max(s_image_hi, addr);
+	return true;
+}
+
+bool EE::CodeCache::ClassifyTarget(uptr target, const u8* body_start, const u8* body_end, RelocationRegion* region, u64* offset)
+{
+	const uptr data_start = reinterpret_cast<uptr>(SysMemory::GetDataPtr(0));
+	if (target >= reinterpret_cast<uptr>(body_start) && target < reinterpret_cast<uptr>(body_end))
+	{
+		*region = REGION_BODY;
+		*offset = target - reinterpret_cast<uptr>(body_start);
+	}
+	else if (target >= reinterpret_cast<uptr>(s_stubs_start) && target < reinterpret_cast<uptr>(s_stubs_end))
+	{
+		*region = REGION_STUBS;
+		*offset = target - reinterpret_cast<uptr>(s_stubs_start);
+	}
+	else if (target >= data_start && target < (data_start + HostMemoryMap::MainSize))
+	{
+		*region = REGION_DATA;
+		*offset = target - data_start;
+	}
+	else if (IsInImage(target))
+	{
+		*region = REGION_IMAGE;
+		*offset = target - s_image_base;
+	}
+	else
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool EE::CodeCache::GetConstAccessState(u32 vaddr, GuardRecord* guard)
+{
+	const auto vmv = vtlb_private::vtlbdata.vmap[vaddr >> vtlb_private::VTLB_PAGE_BITS];
+	guard->vaddr = vaddr;
+	if (vmv.isHandler(vaddr))
+	{
+		guard->kind = GUARD_HANDLER;
+		guard->value = (static_cast<u64>(vmv.assumeHandlerGetID()) << 32) | vmv.assumeHandlerGetPAddr(vaddr);
+		return true;
+	}
+
+	// Only pointers into data memory can be expressed independently of this run.
+	const uptr ptr = vmv.assumePtr(vaddr);
+	const uptr data_start = reinterpret_cast<uptr>(SysMemory::GetDataPtr(0));
+	if (ptr < data_start || ptr >= (data_start + HostMemoryMap::MainSize))
+		return false;
+
+	guard->kind = GUARD_POINTER;
+	guard->value = ptr - data_start;
+	return true;
+}
+
+u64 EE::CodeCache::GetBlockKey(u32 startpc, u32 endpc, u32 flags, const u8* guest)
+{
+	const u64 key[3] = {(static_cast<u64>(startpc) << 32) | endpc, flags, GSXXH3_64bits(guest, endpc - startpc)};
+	return GSXXH3_64bits(key, sizeof(key));
+}
+
+bool EE::CodeCache::IsBlobValid(const std::vector<u8>& blob)
+{
+	if (blob.size() < sizeof(BlockHeader))
+		return false;
+
+	BlockHeader hdr;
+	std::memcpy(&hdr, blob.data(), sizeof(hdr));
+
+	const u64 expected_size = sizeof(BlockHeader) + static_cast<u64>(hdr.guest_size) + hdr.code_size +
+							  static_cast<u64>(hdr.num_relocations) * sizeof(RelocationRecord) +
+							  static_cast<u64>(hdr.num_links) * sizeof(LinkRecord) +
+							  static_cast<u64>(hdr.num_loadstores) * sizeof(LoadStoreRecord) +
+							  static_cast<u64>(hdr.num_guards) * sizeof(GuardRecord);
+	return (expected_size == blob.size() && hdr.endpc > hdr.startpc && hdr.guest_size == (hdr.endpc - hdr.startpc));
+}
+
+void EE::CodeCache::Reset(const u8* stubs_start, const u8* stubs_end, std::span<const void* const> entry_points)
+{
+	if (!EmuConfig.Cpu.Recompiler.EnableEETranslationCache)
+	{
+		Shutdown();
+		return;
+	}
+
+	const uptr image_base = GetModuleBase(&cpuRegs);
+	const void* const anchors[] = {&cpuRegs, &vtlb_private::vtlbdata, reinterpret_cast<const void*>(&vtlb_AddLoadStoreInfo), &EmuConfig};
+	for (const void* anchor : anchors)
+	{
+		if (image_base == 0 || GetModuleBase(anchor) != image_base)
+		{
+			Console.Warning("EE translation cache disabled: unable to locate executable image.");
+			Shutdown();
+			return;
+		}
+	}
+
+	if (image_base < MIN_REGION_ADDRESS || reinterpret_cast<uptr>(SysMemory::GetDataPtr(0)) < MIN_REGION_ADDRESS ||
+		reinterpret_cast<uptr>(SysMemory::GetEERec()) < MIN_REGION_ADDRESS)
+	{
+		Console.Warning("EE translation cache disabled: host memory is mapped below 4GB.");
+		Shutdown();
+		return;
+	}
+
+	// The build is identified by its code rather than its version, since local builds share a version.
+	static const u64 image_hash = GetImageHash(image_base);
+	if (image_hash == 0)
+	{
+		Console.Warning("EE translation cache disabled: unable to identify executable image.");
+		Shutdown();
+		return;
+	}
+
+	// Anything which changes the generated code without being visible in the guest code goes into the
+	// environment hash, and invalidates the whole file.
+	std::vector<u8> env;
+	const auto append = [&env](const auto& value) {
+		const u8* bytes = reinterpret_cast<const u8*>(&value);
+		env.insert(env.end(), bytes, bytes + sizeof(value));
+	};
+
+	append(image_hash);
+	for (const void* anchor : anchors)
+		append(static_cast<u64>(reinterpret_cast<uptr>(anchor) - image_base));
+	for (const void* entry_point : entry_points)
+		append(static_cast<u64>(static_cast<const u8*>(entry_point) - stubs_start));
+	append(static_cast<u64>(stubs_end - stubs_start));
+
+	Pcsx2Config::RecompilerOptions recompiler = EmuConfig.Cpu.Recompiler;
+	recompiler.EnableEETranslationCache = false;
+	append(EmuConfig.Cpu.bitset);
+	append(recompiler.bitset);
+	append(EmuConfig.Cpu.FPUFPCR.bitmask);
+	append(EmuConfig.Cpu.FPUDivFPCR.bitmask);
+	append(EmuConfig.Cpu.VU0FPCR.bitmask);
+	append(EmuConfig.Cpu.VU1FPCR.bitmask);
+	append(EmuConfig.Gamefixes.bitset);
+	append(EmuConfig.Speedhacks.bitset);
+	append(EmuConfig.Speedhacks.EECycleRate);
+	append(EmuConfig.Speedhacks.EECycleSkip);
+	append(static_cast<u8>(EmuConfig.EnablePatches));
+	append(static_cast<u8>(CHECK_EXTRAMEM));
+	append(static_cast<u8>(x86Emitter::use_avx));
+	const u64 environment_hash = GSXXH3_64bits(env.data(), env.size());
+
+	const std::string serial = VMManager::GetDiscSerial();
+	const std::string cache_path = Path::Combine(Path::Combine(EmuFolders::Cache, "ee_cache"),
+		Path::SanitizeFileName(fmt::format("{}_{:08X}.bin", serial.empty() ? "bios" : serial, VMManager::GetDiscCRC())));
+
+	s_image_base = image_base;
+	s_stubs_start = stubs_start;
+	s_stubs_end = stubs_end;
+
+	// Blocks are kept in memory across recompiler resets, as long as the title and settings don't change.
+	if (s_active && s_cache_path == cache_path && s_environment_hash == environment_hash)
+		return;
+
+	Shutdown();
+
+	s_image_base = image_base;
+	s_image_lo = image_base;
+	s_image_hi = image_base;
+	s_stubs_start = stubs_start;
+	s_stubs_end = stubs_end;
+	s_cache_path = std::move(cache_path);
+	s_environment_hash = environment_hash;
+	s_active = true;
+
+	if (LoadFromFile())
+		Console.WriteLnFmt("EE translation cache: loaded {} blocks ({} KB) from {}", s_blocks.size(), s_total_size / _1kb, Path::GetFileName(s_cache_path));
+}
+
+void EE::CodeCache::Shutdown()
+{
+	if (!s_active)
+		return;
+
+	if (s_dirty)
+		WriteToFile();
+
+	Console.WriteLnFmt("EE translation cache: {} hits, {} misses, {} rejected, {} stored, {} skipped (cache full)",
+		s_stats.hits, s_stats.misses, s_stats.rejected, s_stats.stored, s_stats.skipped);
+
+	s_recording = false;
+	xSetRelocationLog(nullptr);
+	s_active = false;
+	s_dirty = false;
+	s_cache_path = {};
+	s_environment_hash = 0;
+	s_blocks.clear();
+	s_total_size = 0;
+	s_stats = {};
+}
+
+bool EE::CodeCache::IsActive()
+{
+	return s_active;
+}
+
+bool EE::CodeCache::LoadFromFile()
+{
+	std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(s_cache_path.c_str());
+	if (!data.has_value())
+		return false;
+
+	u32 magic, version, count;
+	u64 environment_hash;
+	constexpr size_t file_header_size = sizeof(magic) + sizeof(version) + sizeof(environment_hash) + sizeof(count);
+	if (data->size() < file_header_size)
+		return false;
+
+	const u8* ptr = data->data();
+	const u8* const end = ptr + data->size();
+	std::memcpy(&magic, ptr, sizeof(magic));
+	std::memcpy(&version, ptr + 4, sizeof(version));
+	std::memcpy(&environment_hash, ptr + 8, sizeof(environment_hash));
+	std::memcpy(&count, ptr + 16, sizeof(count));
+	ptr += file_header_size;
+
+	if (magic != CACHE_MAGIC || version != CACHE_VERSION || environment_hash != s_environment_hash)
+	{
+		Console.WriteLn("EE translation cache: discarding out of date cache file.");
+		return false;
+	}
+
+	for (u32 i = 0; i < count; i++)
+	{
+		u32 size;
+		if (static_cast<size_t>(end - ptr) < sizeof(size))
+			break;
+		std::memcpy(&size, ptr, sizeof(size));
+		ptr += sizeof(size);
+		if (static_cast<size_t>(end - ptr) < size || (s_total_size + size) > MAX_CACHE_SIZE)
+			break;
+
+		std::vector<u8> blob(ptr, ptr + size);
+		ptr += size;
+		if (!IsBlobValid(blob))
+			continue;
+
+		BlockHeader hdr;
+		std::memcpy(&hdr, blob.data(), sizeof(hdr));
+		const u64 key = GetBlockKey(hdr.startpc, hdr.endpc, hdr.flags, blob.data() + sizeof(hdr));
+		if (s_blocks.contains(key))
+			continue;
+
+		s_total_size += blob.size();
+		s_blocks.emplace(key, std::move(blob));
+	}
+
+	return true;
+}
+
+void EE::CodeCache::WriteToFile()
+{
+	const std::string dir(Path::GetDirectory(s_cache_path));
+	if (!FileSystem::EnsureDirectoryExists(dir.c_str(), false))
+	{
+		Console.ErrorFmt("EE translation cache: failed to create directory {}", dir);
+		return;
+	}
+
+	std::vector<u8> data;
+	data.reserve(s_total_size + s_blocks.size() * sizeof(u32) + 32);
+	const auto append = [&data](const void* ptr, size_t size) {
+		data.insert(data.end(), static_cast<const u8*>(ptr), static_cast<const u8*>(ptr) + size);
+	};
+
+	const u32 count = static_cast<u32>(s_blocks.size());
+	append(&CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	append(&CACHE_VERSION, sizeof(CACHE_VERSION));
+	append(&s_environment_hash, sizeof(s_environment_hash));
+	append(&count, sizeof(count));
+	for (const auto& [key, blob] : s_blocks)
+	{
+		const u32 size = static_cast<u32>(blob.size());
+		append(&size, sizeof(size));
+		append(blob.data(), blob.size());
+	}
+
+	if (!FileSystem::WriteBinaryFile(s_cache_path.c_str(), data.data(), data.size()))
+	{
+		Console.ErrorFmt("EE translation cache: failed to write {}", s_cache_path);
+		return;
+	}
+
+	s_dirty = false;
+}
+
+bool EE::CodeCache::EmitBlock(u32 startpc, u32 endpc, u32 flags, u32* final_pc, std::vector<LinkSite>* links)
+{
+	const u8* guest = static_cast<const u8*>(PSM(startpc));
+	const auto iter = s_blocks.find(GetBlockKey(startpc, endpc, flags, guest));
+	if (iter == s_blocks.end())
+	{
+		s_stats.misses++;
+		return false;
+	}
+
+	const std::vector<u8>& blob = iter->second;
+	BlockHeader hdr;
+	std::memcpy(&hdr, blob.data(), sizeof(hdr));
+	if (hdr.startpc != startpc || hdr.endpc != endpc || hdr.flags != flags ||
+		std::memcmp(blob.data() + sizeof(hdr), guest, hdr.guest_size) != 0)
+	{
+		s_stats.misses++;
+		return false;
+	}
+
+	const u8* code = blob.data() + sizeof(hdr) + hdr.guest_size;
+	const u8* relocations = code + hdr.code_size;
+	const u8* link_records = relocations + hdr.num_relocations * sizeof(RelocationRecord);
+	const u8* loadstores = link_records + hdr.num_links * sizeof(LinkRecord);
+	const u8* guards = loadstores + hdr.num_loadstores * sizeof(LoadStoreRecord);
+
+	// Constant memory accesses must still resolve to the same place.
+	for (u32 i = 0; i < hdr.num_guards; i++)
+	{
+		GuardRecord stored, current;
+		std::memcpy(&stored, guards + i * sizeof(GuardRecord), sizeof(stored));
+		if (!GetConstAccessState(stored.vaddr, &current) || current.kind != stored.kind || current.value != stored.value)
+		{
+			s_stats.misses++;
+			return false;
+		}
+	}
+
+	u8* dest = xGetPtr();
+	if ((dest + hdr.code_size) > SysMemory::GetEERecEnd())
+		return false;
+
+	std::memcpy(dest, code, hdr.code_size);
+
+	const uptr region_bases[REGION_COUNT] = {
+		reinterpret_cast<uptr>(dest),
+		s_image_base,
+		reinterpret_cast<uptr>(SysMemory::GetDataPtr(0)),
+		reinterpret_cast<uptr>(s_stubs_start),
+	};
+
+	for (u32 i = 0; i < hdr.num_relocations; i++)
+	{
+		RelocationRecord reloc;
+		std::memcpy(&reloc, relocations + i * sizeof(RelocationRecord), sizeof(reloc));
+		if (reloc.region >= REGION_COUNT || reloc.offset >= hdr.code_size)
+		{
+			s_stats.misses++;
+			return false;
+		}
+
+		u8* field = dest + reloc.offset;
+		const uptr target = region_bases[reloc.region] + reloc.target_offset;
+		if (reloc.type == xReloc_Rel32)
+		{
+			const sptr displacement = static_cast<sptr>(target) - reinterpret_cast<sptr>(field) - reloc.bias;
+			if (displacement != static_cast<s32>(displacement))
+			{
+				s_stats.misses++;
+				return false;
+			}
+
+			const s32 value = static_cast<s32>(displacement);
+			std::memcpy(field, &value, sizeof(value));
+		}
+		else
+		{
+			const u64 value = target;
+			std::memcpy(field, &value, sizeof(value));
+		}
+	}
+
+	for (u32 i = 0; i < hdr.num_loadstores; i++)
+	{
+		LoadStoreRecord ls;
+		std::memcpy(&ls, loadstores + i * sizeof(LoadStoreRecord), sizeof(ls));
+		vtlb_AddLoadStoreInfo(reinterpret_cast<uptr>(dest + ls.offset), ls.code_size, ls.guest_pc, ls.gpr_bitmask,
+			ls.fpr_bitmask, ls.address_register, ls.data_register, ls.size_in_bits, ls.is_signed != 0, ls.is_load != 0,
+			ls.is_fpr != 0);
+	}
+
+	links->clear();
+	for (u32 i = 0; i < hdr.num_links; i++)
+	{
+		LinkRecord link;
+		std::memcpy(&link, link_records + i * sizeof(LinkRecord), sizeof(link));
+		links->push_back({reinterpret_cast<s32*>(dest + link.offset), link.pc});
+	}
+
+	xSetPtr(dest + hdr.code_size);
+	*final_pc = hdr.final_pc;
+	s_stats.hits++;
+	return true;
+}
+
+void EE::CodeCache::BeginRecording(u32 startpc, u32 endpc, u32 flags)
+{
+	s_recording = true;
+	s_recording_rejected = false;
+	s_recording_startpc = startpc;
+	s_recording_endpc = endpc;
+	s_recording_flags = flags;
+	s_recording_body = xGetPtr();
+	s_recording_relocations.clear();
+	s_recording_links.clear();
+	s_recording_loadstores.clear();
+	s_recording_guards.clear();
+	xSetRelocationLog(&s_recording_relocations);
+}
+
+void EE::CodeCache::NoteLink(s32* jumpptr, u32 pc)
+{
+	if (s_recording)
+		s_recording_links.push_back({jumpptr, pc});
+}
+
+void EE::CodeCache::NoteLoadStore(uptr code_address, u32 code_size, u32 guest_pc, u32 gpr_bitmask, u32 fpr_bitmask,
+	u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr)
+{
+	if (!s_recording)
+		return;
+
+	const LoadStoreRecord ls = {0, guest_pc, gpr_bitmask, fpr_bitmask, static_cast<u8>(code_size), address_register,
+		data_register, size_in_bits, is_signed, is_load, is_fpr, 0};
+	s_recording_loadstores.emplace_back(code_address, ls);
+}
+
+void EE::CodeCache::NoteConstAccess(u32 vaddr)
+{
+	if (!s_recording)
+		return;
+
+	GuardRecord guard;
+	if (GetConstAccessState(vaddr, &guard))
+		s_recording_guards.push_back(guard);
+	else
+		s_recording_rejected = true;
+}
+
+void EE::CodeCache::EndRecording(u32 final_pc)
+{
+	if (!s_recording)
+		return;
+
+	xSetRelocationLog(nullptr);
+	s_recording = false;
+
+	const u8* body_start = s_recording_body;
+	const u8* body_end = xGetPtr();
+	if (s_recording_rejected)
+	{
+		s_stats.rejected++;
+		return;
+	}
+
+	std::vector<RelocationRecord> relocations;
+	relocations.reserve(s_recording_relocations.size());
+	for (const xRelocation& reloc : s_recording_relocations)
+	{
+		// Relocations in the block prefix are re-emitted on load.
+		if (reloc.field < body_start || reloc.field >= body_end)
+			continue;
+
+		const uptr target = reinterpret_cast<uptr>(reloc.target);
+		const bool internal = (target >= reinterpret_cast<uptr>(body_start) && target < reinterpret_cast<uptr>(body_end));
+		RelocationRegion region;
+		u64 target_offset;
+
+		switch (reloc.type)
+		{
+			case xReloc_Rel8:
+			{
+				if (!internal)
+				{
+					s_stats.rejected++;
+					return;
+				}
+			}
+			break;
+
+			case xReloc_Rel32:
+			{
+				// Relative references within the body stay valid wherever it's copied to.
+				if (internal)
+					break;
+
+				s32 displacement;
+				std::memcpy(&displacement, reloc.field, sizeof(displacement));
+				const sptr bias = static_cast<sptr>(target) - reinterpret_cast<sptr>(reloc.field) - displacement;
+				if (bias < 0 || bias > 0xFF || !ClassifyTarget(target, body_start, body_end, &region, &target_offset))
+				{
+					s_stats.rejected++;
+					return;
+				}
+
+				relocations.push_back({static_cast<u32>(reloc.field - body_start), xReloc_Rel32, region,
+					static_cast<u8>(bias), 0, target_offset});
+			}
+			break;
+
+			case xReloc_Abs32:
+			{
+				// Should never happen since every region is above 4GB, but don't silently bake in a pointer.
+				if (ClassifyTarget(target, body_start, body_end, &region, &target_offset))
+				{
+					s_stats.rejected++;
+					return;
+				}
+			}
+			break;
+
+			case xReloc_Abs64:
+			{
+				if (ClassifyTarget(target, body_start, body_end, &region, &target_offset))
+				{
+					relocations.push_back({static_cast<u32>(reloc.field - body_start), xReloc_Abs64, region, 0, 0,
+						target_offset});
+				}
+				else if (target >= MIN_REGION_ADDRESS && target < MAX_USER_ADDRESS)
+				{
+					// Looks like a pointer to something we can't relocate (heap, other libraries).
+					s_stats.rejected++;
+					return;
+				}
+			}
+			break;
+		}
+	}
+
+	BlockHeader hdr = {};
+	hdr.startpc = s_recording_startpc;
+	hdr.endpc = s_recording_endpc;
+	hdr.final_pc = final_pc;
+	hdr.flags = s_recording_flags;
+	hdr.guest_size = s_recording_endpc - s_recording_startpc;
+	hdr.code_size = static_cast<u32>(body_end - body_start);
+	hdr.num_relocations = static_cast<u32>(relocations.size());
+	hdr.num_links = 0;
+	hdr.num_loadstores = 0;
+	hdr.num_guards = static_cast<u32>(s_recording_guards.size());
+
+	std::vector<LinkRecord> links;
+	for (const LinkSite& link : s_recording_links)
+	{
+		const u8* ptr = reinterpret_cast<const u8*>(link.jumpptr);
+		if (ptr >= body_start && ptr < body_end)
+			links.push_back({static_cast<u32>(ptr - body_start), link.pc});
+	}
+	hdr.num_links = static_cast<u32>(links.size());
+
+	std::vector<LoadStoreRecord> loadstores;
+	for (auto& [code_address, ls] : s_recording_loadstores)
+	{
+		const u8* ptr = reinterpret_cast<const u8*>(code_address);
+		if (ptr < body_start || ptr >= body_end)
+			continue;
+
+		ls.offset = static_cast<u32>(ptr - body_start);
+		loadstores.push_back(ls);
+	}
+	hdr.num_loadstores = static_cast<u32>(loadstores.size());
+
+	const u8* guest = static_cast<const u8*>(PSM(s_recording_startpc));
+	std::vector<u8> blob;
+	blob.reserve(sizeof(hdr) + hdr.guest_size + hdr.code_size + relocations.size() * sizeof(RelocationRecord) +
+				 links.size() * sizeof(LinkRecord) + loadstores.size() * sizeof(LoadStoreRecord) +
+				 s_recording_guards.size() * sizeof(GuardRecord));
+	const auto append = [&blob](const void* ptr, size_t size) {
+		blob.insert(blob.end(), static_cast<const u8*>(ptr), static_cast<const u8*>(ptr) + size);
+	};
+	append(&hdr, sizeof(hdr));
+	append(guest, hdr.guest_size);
+	append(body_start, hdr.code_size);
+	append(relocations.data(), relocations.size() * sizeof(RelocationRecord));
+	append(links.data(), links.size() * sizeof(LinkRecord));
+	append(loadstores.data(), loadstores.size() * sizeof(LoadStoreRecord));
+	append(s_recording_guards.data(), s_recording_guards.size() * sizeof(GuardRecord));
+
+	const u64 key = GetBlockKey(hdr.startpc, hdr.endpc, hdr.flags, guest);
+	const auto iter = s_blocks.find(key);
+	const size_t old_size = (iter != s_blocks.end()) ? iter->second.size() : 0;
+	if ((s_total_size - old_size + blob.size()) > MAX_CACHE_SIZE)
+	{
+		s_stats.skipped++;
+		return;
+	}
+
+	s_total_size = s_total_size - old_size + blob.size();
+	s_blocks[key] = std::move(blob);
+	s_dirty = true;
+	s_stats.stored++;
+}
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Defs.h"
+
+#include <span>
+#include <vector>
+
+// --------------------------------------------------------------------------------------
+//  EE::CodeCache
+// --------------------------------------------------------------------------------------
+// Persistent translation cache for the EE recompiler. The body of each recompiled block
+// (everything after the SMC checks) is captured along with the host addresses it encodes,
+// and written to disk per title. On the next boot, blocks whose guest code is unchanged are
+// copied back and relocated instead of being recompiled.
+//
+// Blocks are only cached when every address they encode can be expressed relative to a
+// region which is stable between runs of the same build: the block itself, the executable
+// image, the data memory, or the EE dispatchers. Anything else (heap pointers, other blocks,
+// absolute 32-bit pointers) makes the block uncacheable, and it is simply recompiled.
+//
+namespace EE::CodeCache
+{
+	/// Flags which are part of the block key, in addition to the guest code.
+	enum BlockFlags : u32
+	{
+		BLOCK_FLAG_SPLIT = (1u << 0), // Block was split (page boundary or existing block).
+		BLOCK_FLAG_DIE = (1u << 1), // COP0 Config.DIE was set when compiling.
+		BLOCK_FLAG_PROFILE = (1u << 2), // Block counts its executions and branch directions.
+		BLOCK_FLAG_SUPER = (1u << 3), // Block continues past one or more conditional branches.
+	};
+
+	/// Link site which must be registered with the block manager after a block is emitted.
+	struct LinkSite
+	{
+		s32* jumpptr;
+		u32 pc;
+	};
+
+	/// Returns the key a block is stored under. guest points to the code from startpc to endpc.
+	u64 GetBlockKey(u32 startpc, u32 endpc, u32 flags, const u8* guest);
+
+	/// Called after the dispatchers have been generated. Flushes the previous cache if the
+	/// title or configuration changed, and loads the cache for the running title.
+	/// entry_points is the list of dispatcher addresses, used to detect layout changes.
+	void Reset(const u8* stubs_start, const u8* stubs_end, std::span<const void* const> entry_points);
+
+	/// Writes any new blocks to disk and releases the cache.
+	void Shutdown();
+
+	/// Returns true if blocks should be looked up/recorded.
+	bool IsActive();
+
+	/// Copies the cached body for the specified block to the current emitter pointer.
+	/// On success, the emitter pointer is advanced, final_pc is set to the guest pc after the
+	/// block, and any link sites which need to be registered are returned in links.
+	bool EmitBlock(u32 startpc, u32 endpc, u32 flags, u32* final_pc, std::vector<LinkSite>* links);
+
+	/// Starts capturing relocations for a block body which begins at the current emitter pointer.
+	void BeginRecording(u32 startpc, u32 endpc, u32 flags);
+
+	/// Captures the body up to the current emitter pointer, and adds it to the cache if it is relocatable.
+	void EndRecording(u32 final_pc);
+
+	/// Records a jump to another block which was registered with the block manager.
+	void NoteLink(s32* jumpptr, u32 pc);
+
+	/// Records fastmem backpatch information for a load/store in the block.
+	void NoteLoadStore(uptr code_address, u32 code_size, u32 guest_pc, u32 gpr_bitmask, u32 fpr_bitmask,
+		u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr);
+
+	/// Records a memory access which was resolved at compile time through the vtlb.
+	void NoteConstAccess(u32 vaddr);
+} // namespace EE::CodeCache
@@ -4,6 +4,7 @@
 #include "Common.h"
 #include "CDVD/CDVD.h"
 #include "DebugTools/Breakpoints.h"
+#include "DebugTools/JitProfiler.h"
 #include "Elfheader.h"
 #include "GS.h"
 #include "Memory.h"
@@ -15,6 +16,7 @@
 #include "x86/BaseblockEx.h"
 #include "x86/iR5900.h"
 #include "x86/iR5900Analysis.h"
+#include "x86/iR5900CodeCache.h"
 
 #include "common/AlignedMalloc.h"
 #include "common/FastJmp.h"
@@ -87,9 +89,139 @@ static u32 s_nInstCacheSize = 0;
 
 static BASEBLOCK* s_pCurBlock = nullptr;
 static BASEBLOCKEX* s_pCurBlockEx = nullptr;
+static std::vector<EE::CodeCache::LinkSite> s_cachedBlockLinks;
 u32 s_nEndBlock = 0; // what pc the current block ends
 u32 s_branchTo;
 static bool s_nBlockFF;
+static bool s_nBlockSuper; // block continues past at least one conditional branch
+static bool s_nBlockProfile; // block counts its executions and branch directions
+static std::vector<u32> s_superBranches; // branches which the current superblock continues past
+
+// Superblocks: blocks ending in a conditional branch count their executions, and the direction
+// taken by the branch. Once a block has run EE_HOT_BLOCK_THRESHOLD times, it's recompiled,
+// following any branches which are almost never taken. The taken side becomes an exit from
+// the block. Counters are kept in a table indexed by pc rather than in BASEBLOCKEX, because the
+// latter moves around as blocks are inserted and removed.
+struct EEProfileEntry
+{
+	u32 pc; // HWADDR of the block start or branch which owns this entry
+	u32 countdown; // executions left before the block is recompiled as a superblock
+	u32 taken;
+	u32 not_taken;
+};
+
+static constexpr u32 EE_PROFILE_TABLE_SIZE = 0x4000;
+static constexpr u32 EE_HOT_BLOCK_THRESHOLD = 1024;
+static constexpr u32 EE_SUPERBLOCK_MIN_SAMPLES = 64;
+static constexpr u32 EE_SUPERBLOCK_MAX_INSTS = 256;
+
+// Blocks never cross a page, apart from the delay slot of a branch at the end of one. Superblocks
+// can overlap blocks which end before them, so walks back from an address need to cover this.
+static constexpr u32 EE_MAX_BLOCK_SPAN = 0x1000 + 8;
+
+alignas(16) static EEProfileEntry s_profileTable[EE_PROFILE_TABLE_SIZE];
+static bool s_superblocks = false;
+
+// Deferred compilation: new blocks are interpreted for their first few runs, since a lot of code
+// (particularly while loading) only ever runs once or twice. Past that, the number of instructions
+// compiled in each frame's worth of cycles is limited, and blocks over the limit keep being
+// interpreted until a later frame, unless they're running often.
+struct EEColdBlock
+{
+	u32 pc; // HWADDR of the block start which owns this entry
+	u32 runs; // times the block has been interpreted
+};
+
+static constexpr u32 EE_COLD_TABLE_SIZE = 0x4000;
+static constexpr u32 EE_WARM_BLOCK_RUNS = 2;
+static constexpr u32 EE_FORCE_COMPILE_RUNS = 64;
+static constexpr u32 EE_INTERPRET_MAX_INSTS = 256;
+static constexpr u32 EE_COMPILE_WINDOW_CYCLES = PS2CLK / 60;
+static constexpr u32 EE_COMPILE_WINDOW_INSTS = 8192;
+
+static EEColdBlock s_coldBlocks[EE_COLD_TABLE_SIZE];
+static bool s_deferCompile = false;
+static u32 s_compileWindowStart = 0;
+static u32 s_compileWindowInsts = 0;
+
+static EEProfileEntry* recGetProfile(u32 pc)
+{
+	return &s_profileTable[(HWADDR(pc) >> 2) & (EE_PROFILE_TABLE_SIZE - 1)];
+}
+
+// Returns the profile entry for pc, resetting it if it was last used by another pc.
+static EEProfileEntry* recClaimProfile(u32 pc)
+{
+	EEProfileEntry* prof = recGetProfile(pc);
+	if (prof->pc != HWADDR(pc))
+	{
+		prof->pc = HWADDR(pc);
+		prof->countdown = EE_HOT_BLOCK_THRESHOLD;
+		prof->taken = 0;
+		prof->not_taken = 0;
+	}
+
+	return prof;
+}
+
+// Marks every register as live and used after pinst, so nothing is dropped before a side exit.
+static void recMarkAllLive(EEINST* pinst)
+{
+	for (u8& reg : pinst->regs)
+		reg |= EEINST_LIVE | EEINST_USED;
+	for (u8& reg : pinst->fpuregs)
+		reg |= EEINST_LIVE | EEINST_USED;
+	for (u8& reg : pinst->vfregs)
+		reg |= EEINST_LIVE | EEINST_USED;
+	for (u8& reg : pinst->viregs)
+		reg |= EEINST_LIVE | EEINST_USED;
+}
+
+// Returns true if the current superblock continues past the branch at pc.
+static bool recIsSuperBranch(u32 pc)
+{
+	return s_nBlockSuper && std::find(s_superBranches.begin(), s_superBranches.end(), pc) != s_superBranches.end();
+}
+
+// Returns true if the scan of a hot block can continue past the conditional branch at pc.
+static bool recCanContinuePastBranch(u32 startpc, u32 pc, u32 branchTo)
+{
+	// Stay within the page, and leave loops back into the block to end it as usual.
+	if ((pc - startpc) / 4 >= EE_SUPERBLOCK_MAX_INSTS || ((pc + 8) & ~0xfffu) != (pc & ~0xfffu) ||
+		(branchTo > startpc && branchTo < pc))
+	{
+		return false;
+	}
+
+	// The COP2 analysis passes assume that the block only exits at its end, and branches in
+	// delay slots are left to the normal path.
+	const u32 delay_code = *(u32*)PSM(pc + 4);
+	const u32 delay_op = delay_code >> 26;
+	if (delay_op == 022 || delay_op == 066 || delay_op == 076 ||
+		(delay_op >= 1 && delay_op < 8) || (delay_op >= 024 && delay_op < 030) ||
+		(delay_op == 0 && ((delay_code & 0x3f) == 8 || (delay_code & 0x3f) == 9)))
+	{
+		return false;
+	}
+
+	const EEProfileEntry* prof = recGetProfile(pc);
+	if (prof->pc != HWADDR(pc))
+		return false;
+
+	const u32 samples = prof->taken + prof->not_taken;
+	return (samples >= EE_SUPERBLOCK_MIN_SAMPLES && prof->taken <= samples / 16);
+}
+
+// Returns the end of a block whose scan stopped at the branch at pc.
+static u32 recGetBranchBlockEnd(u32 startpc, u32 pc)
+{
+	// Branches back into the block end it at their target, so the loop gets a block of its own,
+	// unless that would cut off part of the path a superblock has already followed.
+	if (s_branchTo > startpc && s_branchTo < pc && (s_superBranches.empty() || s_branchTo >= s_superBranches.back() + 8))
+		return s_branchTo;
+	else
+		return pc + 8;
+}
 
 // save states for branches
 GPR_reg64 s_saveConstRegs[32];
@@ -99,6 +231,7 @@ static EEINST* s_psaveInstInfo = nullptr;
 static u32 s_savenBlockCycles = 0;
 
 static void iBranchTest(u32 newpc = 0xffffffff);
+static void recLinkBlock(u32 pc, s32* jumpptr);
 static void ClearRecLUT(BASEBLOCK* base, int count);
 static u32 scaleblockcycles();
 static void recExitExecution();
@@ -344,8 +477,10 @@ void recCall(void (*func)())
 // =====================================================================================================
 
 static void recRecompile(const u32 startpc);
+static bool recCompileOrInterpret(const u32 startpc);
 static void dyna_block_discard(u32 start, u32 sz);
 static void dyna_page_reset(u32 start, u32 sz);
+static void dyna_hot_block();
 
 static const void* DispatcherEvent = nullptr;
 static const void* DispatcherReg = nullptr;
@@ -353,6 +488,7 @@ static const void* JITCompile = nullptr;
 static const void* EnterRecompiledCode = nullptr;
 static const void* DispatchBlockDiscard = nullptr;
 static const void* DispatchPageReset = nullptr;
+static const void* DispatchHotBlock = nullptr;
 
 static void recEventTest()
 {
@@ -373,7 +509,17 @@ static const void* _DynGen_JITCompile()
 
 	u8* retval = xGetAlignedCallTarget();
 
-	xFastCall((const void*)recRecompile, ptr32[&cpuRegs.pc]);
+	xFastCall((const void*)recCompileOrInterpret, ptr32[&cpuRegs.pc]);
+
+	// If the block was interpreted instead, it has already run, so check for events
+	// and dispatch to wherever it ended up.
+	xTEST(al, al);
+	xForwardJNZ8 compiled;
+	xMOV(eax, ptr[&cpuRegs.cycle]);
+	xSUB(eax, ptr[&cpuRegs.nextEventCycle]);
+	xJS(DispatcherReg);
+	xJMP(DispatcherEvent);
+	compiled.SetTarget();
 
 	// C equivalent:
 	// u32 addr = cpuRegs.pc;
@@ -461,6 +607,14 @@ static const void* _DynGen_DispatchPageReset()
 	return retval;
 }
 
+static const void* _DynGen_DispatchHotBlock()
+{
+	u8* retval = xGetPtr();
+	xFastCall((const void*)dyna_hot_block);
+	xJMP(DispatcherReg);
+	return retval;
+}
+
 static void _DynGen_Dispatchers()
 {
 	const u8* start = xGetAlignedCallTarget();
@@ -474,6 +628,7 @@ static void _DynGen_Dispatchers()
 	EnterRecompiledCode = _DynGen_EnterRecompiledCode();
 	DispatchBlockDiscard = _DynGen_DispatchBlockDiscard();
 	DispatchPageReset = _DynGen_DispatchPageReset();
+	DispatchHotBlock = _DynGen_DispatchHotBlock();
 
 	recBlocks.SetJITCompile(JITCompile);
 
@@ -576,12 +731,17 @@ static void recResetRaw()
 	}
 
 	EE::Profiler.Reset();
+	JitProfiler::InvalidateBlocks(SysMemory::GetEERec(), SysMemory::GetEERecEnd());
 
 	xSetPtr(SysMemory::GetEERec());
 	_DynGen_Dispatchers();
 	vtlb_DynGenDispatchers();
 	recPtr = xGetPtr();
 
+	const void* const entry_points[] = {DispatcherEvent, DispatcherReg, JITCompile, EnterRecompiledCode,
+		DispatchBlockDiscard, DispatchPageReset, DispatchHotBlock};
+	EE::CodeCache::Reset(SysMemory::GetEERec(), recPtr, entry_points);
+
 	ClearRecLUT(recLutReserve_RAM.data(),
 		Ps2MemSize::ExposedRam + Ps2MemSize::Rom + Ps2MemSize::Rom1 + Ps2MemSize::Rom2);
 	recRAMCopy.fill(0);
@@ -599,10 +759,21 @@ static void recResetRaw()
 
 	memset(manual_page, 0, sizeof(manual_page));
 	memset(manual_counter, 0, sizeof(manual_counter));
+
+	// Profiles are only meaningful for the blocks they were collected for.
+	s_superblocks = EmuConfig.Cpu.Recompiler.EnableEESuperblocks;
+	memset(s_profileTable, 0xff, sizeof(s_profileTable));
+
+	s_deferCompile = EmuConfig.Cpu.Recompiler.EnableEEDeferredCompilation;
+	memset(s_coldBlocks, 0xff, sizeof(s_coldBlocks));
+	s_compileWindowStart = cpuRegs.cycle;
+	s_compileWindowInsts = 0;
 }
 
 void recShutdown()
 {
+	EE::CodeCache::Shutdown();
+
 	recRAMCopy.deallocate();
 	recLutReserve_RAM.deallocate();
 
@@ -744,6 +915,7 @@ void recClear(u32 addr, u32 size)
 		ceiling = pexblock->startpc;
 
 	int toRemoveLast = blockidx;
+	bool skipped = false;
 
 	while ((pexblock = recBlocks[blockidx]))
 	{
@@ -764,7 +936,17 @@ void recClear(u32 addr, u32 size)
 		if (blockend <= addr)
 		{
 			lowerextent = std::max(lowerextent, blockend);
-			break;
+			if (!s_superblocks || blockstart + EE_MAX_BLOCK_SPAN <= addr)
+				break;
+
+			// A superblock starting before this block may still reach into the range.
+			if (toRemoveLast != blockidx)
+			{
+				recBlocks.Remove((blockidx + 1), toRemoveLast);
+			}
+			toRemoveLast = --blockidx;
+			skipped = true;
+			continue;
 		}
 
 		lowerextent = std::min(lowerextent, blockstart);
@@ -793,7 +975,9 @@ void recClear(u32 addr, u32 size)
 		}
 	}
 
-	if (upperextent > lowerextent)
+	// Blocks which were kept may start inside the extents, in which case only the starts of the
+	// removed blocks (which were cleared above) can be reset.
+	if (!skipped && upperextent > lowerextent)
 		ClearRecLUT(PC_GETBLOCK(lowerextent), upperextent - lowerextent);
 }
 
@@ -885,6 +1069,31 @@ void SetBranchImm(u32 imm)
 	iBranchTest(imm);
 }
 
+// Both are called with pc just past the delay slot of the branch.
+void SetBranchTaken(u32 imm)
+{
+	if (s_nBlockProfile)
+		xADD(ptr32[&recGetProfile(pc - 8)->taken], 1);
+
+	SetBranchImm(imm);
+}
+
+void SetBranchFallthrough(u32 imm)
+{
+	// Everything was flushed before the branch was tested, so the taken side didn't change
+	// any state which the fall-through side depends on. Keep compiling along this path.
+	if (recIsSuperBranch(pc - 8))
+	{
+		g_branch = 0;
+		return;
+	}
+
+	if (s_nBlockProfile)
+		xADD(ptr32[&recGetProfile(pc - 8)->not_taken], 1);
+
+	SetBranchImm(imm);
+}
+
 u8* recBeginThunk()
 {
 	// if recPtr reached the mem limit reset whole mem
@@ -1343,6 +1552,13 @@ u32 scaleblockcycles_clear()
 	return scaled;
 }
 
+// Hardlinks a jump to the block at the specified pc, and notes it for the translation cache.
+static void recLinkBlock(u32 pc, s32* jumpptr)
+{
+	recBlocks.Link(HWADDR(pc), jumpptr);
+	EE::CodeCache::NoteLink(jumpptr, pc);
+}
+
 // Generates dynarec code for Event tests followed by a block dispatch (branch).
 // Parameters:
 //   newpc - address to jump to at the end of the block.  If newpc == 0xffffffff then
@@ -1380,7 +1596,7 @@ static void iBranchTest(u32 newpc)
 		if (newpc == 0xffffffff)
 			xJS(DispatcherReg);
 		else
-			recBlocks.Link(HWADDR(newpc), xJcc32(Jcc_Signed));
+			recLinkBlock(newpc, xJcc32(Jcc_Signed));
 
 		xJMP((void*)DispatcherEvent);
 	}
@@ -1999,6 +2215,7 @@ static void PreBlockCheck(u32 blockpc)
 void dyna_block_discard(u32 start, u32 sz)
 {
 	eeRecPerfLog.Write(Color_StrongGray, "Clearing Manual Block @ 0x%08X  [size=%d]", start, sz * 4);
+	mmap_SMCCounters.BlockDiscards++;
 	recClear(start, sz);
 }
 
@@ -2008,10 +2225,19 @@ void dyna_block_discard(u32 start, u32 sz)
 void dyna_page_reset(u32 start, u32 sz)
 {
 	recClear(start & ~0xfffUL, 0x400);
+	mmap_SMCCounters.PageResets++;
 	manual_counter[start >> 12]++;
 	mmap_MarkCountedRamPage(start);
 }
 
+// called when a profiled block has run enough times to be worth recompiling as a superblock.
+// The block is always entered with cpuRegs.pc set to its start, so it can be cleared by pc.
+void dyna_hot_block()
+{
+	eeRecPerfLog.Write("Hot block @ 0x%08X", cpuRegs.pc);
+	recClear(cpuRegs.pc, 1);
+}
+
 static void memory_protect_recompiled_code(u32 startpc, u32 size)
 {
 	u32 inpage_ptr = HWADDR(startpc);
@@ -2024,6 +2250,9 @@ static void memory_protect_recompiled_code(u32 startpc, u32 size)
 	// note: blocks are guaranteed to reside within the confines of a single page.
 	const vtlb_ProtectionMode PageType = contains_thread_stack ? ProtMode_Manual : mmap_GetRamPageInfo(inpage_ptr);
 
+	if (PageType != ProtMode_NotRequired)
+		mmap_MarkCodeGranules(inpage_ptr, inpage_sz);
+
 	switch (PageType)
 	{
 		case ProtMode_NotRequired:
@@ -2060,7 +2289,10 @@ static void memory_protect_recompiled_code(u32 startpc, u32 size)
 
 			// (ideally, perhaps, manual_counter should be reset to 0 every few minutes?)
 
-			if (!contains_thread_stack && manual_counter[inpage_ptr >> 12] <= 3)
+			// Pages which keep faulting on data stored beside their code skip the counted stage
+			// altogether, since every re-protect would just fault and recompile the page again.
+
+			if (!contains_thread_stack && manual_counter[inpage_ptr >> 12] <= 3 && !mmap_IsMixedRamPage(inpage_ptr))
 			{
 				// Counted blocks add a weighted (by block size) value into manual_page each time they're
 				// run.  If the block gets run a lot, it resets and re-protects itself in the hope
@@ -2166,7 +2398,7 @@ static bool recSkipTimeoutLoop(s32 reg, bool is_timeout_loop)
 	xMOV(ptr32[&cpuRegs.GPR.r[reg].UL[0]], edx); // write back new value of v0
 	xJNZ((void*)DispatcherEvent); // jump to dispatcher if new v0 is not zero (i.e. an event)
 	xMOV(ptr32[&cpuRegs.pc], s_nEndBlock); // otherwise end of loop
-	recBlocks.Link(HWADDR(s_nEndBlock), xJcc32());
+	recLinkBlock(s_nEndBlock, xJcc32());
 
 	g_branch = 1;
 	pc = s_nEndBlock;
@@ -2174,6 +2406,21 @@ static bool recSkipTimeoutLoop(s32 reg, bool is_timeout_loop)
 	return true;
 }
 
+// Blocks which depend on debugger or patch state can't be shared with the translation cache.
+static bool recIsBlockCacheable(u32 startpc, u32 endpc)
+{
+	if (!EE::CodeCache::IsActive() || (EmuConfig.EnablePatches && Patch::HasDynamicPatches()))
+		return false;
+
+	for (u32 i = startpc; i < endpc; i += 4)
+	{
+		if (isBreakpointNeeded(i) != 0 || isMemcheckNeeded(i) != 0 || vtlb_IsFaultingPC(i))
+			return false;
+	}
+
+	return true;
+}
+
 static void recRecompile(const u32 startpc)
 {
 	u32 i = 0;
@@ -2296,6 +2543,14 @@ static void recRecompile(const u32 startpc)
 	s32 timeout_reg = -1;
 	bool is_timeout_loop = true;
 
+	// Hot blocks are recompiled as superblocks, following branches which are almost never taken.
+	EEProfileEntry* const block_prof = s_superblocks ? recGetProfile(startpc) : nullptr;
+	const bool hot = block_prof && block_prof->pc == HWADDR(startpc) && block_prof->countdown == 0;
+	bool has_cop2 = false;
+	s_nBlockSuper = false;
+	s_nBlockProfile = false;
+	s_superBranches.clear();
+
 	// compile breakpoints as individual blocks
 	const int n1 = isBreakpointNeeded(i);
 	const int n2 = isMemcheckNeeded(i);
@@ -2328,7 +2583,8 @@ static void recRecompile(const u32 startpc)
 				break;
 			}
 
-			if (pblock->GetFnptr() != (uptr)JITCompile)
+			// superblocks run through the blocks along their path
+			if (!s_nBlockSuper && pblock->GetFnptr() != (uptr)JITCompile)
 			{
 				willbranch3 = 1;
 				s_nEndBlock = i;
@@ -2339,6 +2595,20 @@ static void recRecompile(const u32 startpc)
 		//HUH ? PSM ? whut ? THIS IS VIRTUAL ACCESS GOD DAMMIT
 		cpuRegs.code = *(int*)PSM(i);
 
+		// cop2, lqc2, sqc2
+		if (_Opcode_ == 022 || _Opcode_ == 066 || _Opcode_ == 076)
+		{
+			// The COP2 analysis passes assume that the block only exits at its end.
+			if (s_nBlockSuper)
+			{
+				willbranch3 = 1;
+				s_nEndBlock = i;
+				break;
+			}
+
+			has_cop2 = true;
+		}
+
 		if (is_timeout_loop)
 		{
 			if ((cpuRegs.code >> 26) == 8 || (cpuRegs.code >> 26) == 9)
@@ -2382,11 +2652,19 @@ static void recRecompile(const u32 startpc)
 				{
 					// branches
 					s_branchTo = _Imm_ * 4 + i + 4;
-					if (s_branchTo > startpc && s_branchTo < i)
-						s_nEndBlock = s_branchTo;
-					else
-						s_nEndBlock = i + 8;
 
+					// bltz, bgez
+					if (hot && _Rt_ < 2 && !has_cop2 && recCanContinuePastBranch(startpc, i, s_branchTo))
+					{
+						s_superBranches.push_back(i);
+						s_nBlockSuper = true;
+						is_timeout_loop = false;
+						s_branchTo = -1;
+						i += 8;
+						continue;
+					}
+
+					s_nEndBlock = recGetBranchBlockEnd(startpc, i);
 					goto StartRecomp;
 				}
 				break;
@@ -2407,11 +2685,19 @@ static void recRecompile(const u32 startpc)
 			case 22:
 			case 23:
 				s_branchTo = _Imm_ * 4 + i + 4;
-				if (s_branchTo > startpc && s_branchTo < i)
-					s_nEndBlock = s_branchTo;
-				else
-					s_nEndBlock = i + 8;
 
+				// beq, bne, blez, bgtz
+				if (hot && _Opcode_ < 8 && !has_cop2 && recCanContinuePastBranch(startpc, i, s_branchTo))
+				{
+					s_superBranches.push_back(i);
+					s_nBlockSuper = true;
+					is_timeout_loop = false;
+					s_branchTo = -1;
+					i += 8;
+					continue;
+				}
+
+				s_nEndBlock = recGetBranchBlockEnd(startpc, i);
 				goto StartRecomp;
 
 			case 16: // cp0
@@ -2433,11 +2719,7 @@ static void recRecompile(const u32 startpc)
 					// BC1F, BC1T, BC1FL, BC1TL
 					// BC2F, BC2T, BC2FL, BC2TL
 					s_branchTo = _Imm_ * 4 + i + 4;
-					if (s_branchTo > startpc && s_branchTo < i)
-						s_nEndBlock = s_branchTo;
-					else
-						s_nEndBlock = i + 8;
-
+					s_nEndBlock = recGetBranchBlockEnd(startpc, i);
 					goto StartRecomp;
 				}
 				break;
@@ -2453,7 +2735,7 @@ StartRecomp:
 	// which alter the machine state apart from registers, it will do the same thing on every
 	// iteration.
 	s_nBlockFF = false;
-	if (s_branchTo == startpc)
+	if (s_branchTo == startpc && !s_nBlockSuper)
 	{
 		s_nBlockFF = true;
 
@@ -2535,6 +2817,26 @@ StartRecomp:
 		is_timeout_loop = false;
 	}
 
+	if (s_nBlockSuper)
+	{
+		eeRecPerfLog.Write("Superblock @ %08X : size=%d insts, %d branches followed",
+			startpc, (s_nEndBlock - startpc) / 4, static_cast<int>(s_superBranches.size()));
+	}
+
+	// Blocks ending in a branch which a superblock could follow count down to being recompiled.
+	if (block_prof && !hot && !has_cop2 && !willbranch3 && (s_nEndBlock - startpc) >= 8)
+	{
+		const u32 branch_code = *(u32*)PSM(s_nEndBlock - 8);
+		const u32 branch_op = branch_code >> 26;
+		const u32 branch_rt = (branch_code >> 16) & 0x1f;
+		if ((branch_op >= 4 && branch_op < 8) || (branch_op == 1 && branch_rt < 2))
+		{
+			recClaimProfile(startpc);
+			recClaimProfile(s_nEndBlock - 8);
+			s_nBlockProfile = true;
+		}
+	}
+
 	// rec info //
 	bool has_cop2_instructions = false;
 	{
@@ -2553,6 +2855,11 @@ StartRecomp:
 		for (i = s_nEndBlock; i > startpc; i -= 4)
 		{
 			cpuRegs.code = *(int*)PSM(i - 4);
+
+			// Superblock exits are after the delay slot, and anything can be read after them.
+			if (recIsSuperBranch(i - 8))
+				recMarkAllLive(pcur);
+
 			pcur[-1] = pcur[0];
 			recBackpropBSC(cpuRegs.code, pcur - 1, pcur);
 			pcur--;
@@ -2589,11 +2896,28 @@ StartRecomp:
 #endif
 #endif
 
+	if (s_nBlockProfile)
+	{
+		xSUB(ptr32[&block_prof->countdown], 1);
+		xJZ(DispatchHotBlock);
+	}
+
 	// Detect and handle self-modified code
 	memory_protect_recompiled_code(startpc, (s_nEndBlock - startpc) >> 2);
 
+	// Reuse the block body from the translation cache if we can, otherwise record it as it's compiled.
+	// The SMC checks above depend on the current page protection state, so they're always generated.
+	const u32 cache_flags = (willbranch3 ? EE::CodeCache::BLOCK_FLAG_SPLIT : 0) |
+							(((cpuRegs.CP0.n.Config >> 18) & 0x1) ? EE::CodeCache::BLOCK_FLAG_DIE : 0) |
+							(s_nBlockProfile ? EE::CodeCache::BLOCK_FLAG_PROFILE : 0) |
+							(s_nBlockSuper ? EE::CodeCache::BLOCK_FLAG_SUPER : 0);
+	const bool cacheable = recIsBlockCacheable(startpc, s_nEndBlock);
+	const bool from_cache = cacheable && EE::CodeCache::EmitBlock(startpc, s_nEndBlock, cache_flags, &pc, &s_cachedBlockLinks);
+	if (cacheable && !from_cache)
+		EE::CodeCache::BeginRecording(startpc, s_nEndBlock, cache_flags);
+
 	// Skip Recompilation if sceMpegIsEnd Pattern detected
-	const bool doRecompilation = !skipMPEG_By_Pattern(startpc) && !recSkipTimeoutLoop(timeout_reg, is_timeout_loop);
+	const bool doRecompilation = !from_cache && !skipMPEG_By_Pattern(startpc) && !recSkipTimeoutLoop(timeout_reg, is_timeout_loop);
 
 	if (doRecompilation)
 	{
@@ -2663,7 +2987,11 @@ StartRecomp:
 			if (oldBlock->startpc >= HWADDR(pc))
 				continue;
 			if ((oldBlock->startpc + oldBlock->size * 4) <= HWADDR(startpc))
-				break;
+			{
+				if (!s_superblocks || oldBlock->startpc + EE_MAX_BLOCK_SPAN <= HWADDR(startpc))
+					break;
+				continue;
+			}
 
 			if (memcmp(&recRAMCopy[oldBlock->startpc / 4], PSM(oldBlock->startpc),
 					oldBlock->size * 4))
@@ -2683,7 +3011,13 @@ StartRecomp:
 	if (!(pc & 0x10000000))
 		maxrecmem = std::max((pc & ~0xa0000000), maxrecmem);
 
-	if (g_branch == 2)
+	if (from_cache)
+	{
+		// The cached body already contains the block tail, we just need to hook up its links.
+		for (const EE::CodeCache::LinkSite& link : s_cachedBlockLinks)
+			recLinkBlock(link.pc, link.jumpptr);
+	}
+	else if (g_branch == 2)
 	{
 		// Branch type 2 - This is how I "think" this works (air):
 		// Performs a branch/event test but does not actually "break" the block.
@@ -2717,11 +3051,14 @@ StartRecomp:
 			{
 				xMOV(ptr32[&cpuRegs.pc], pc);
 				xADD(ptr32[&cpuRegs.cycle], scaleblockcycles());
-				recBlocks.Link(HWADDR(pc), xJcc32());
+				recLinkBlock(pc, xJcc32());
 			}
 		}
 	}
 
+	if (cacheable && !from_cache)
+		EE::CodeCache::EndRecording(pc);
+
 	pxAssert(xGetPtr() < SysMemory::GetEERecEnd());
 
 	s_pCurBlockEx->x86size = static_cast<u32>(xGetPtr() - recPtr);
@@ -2733,6 +3070,7 @@ StartRecomp:
 	}
 #endif
 	Perf::ee.RegisterPC((void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
+	JitProfiler::RegisterBlock(JitProfiler::Source::EE, (void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
 
 	recPtr = xGetPtr();
 
@@ -2742,6 +3080,61 @@ StartRecomp:
 	s_pCurBlockEx = nullptr;
 }
 
+// Returns true if the block at startpc should be interpreted for now, rather than compiled.
+static bool recShouldDeferCompile(u32 startpc)
+{
+	// Boot hooks, breakpoints and the Goemon TLB hack all depend on going through recRecompile().
+	if (!s_deferCompile || !VMManager::Internal::HasBootedELF() || EmuConfig.Gamefixes.GoemonTlbHack ||
+		isBreakpointNeeded(startpc) != 0 || isMemcheckNeeded(startpc) != 0)
+	{
+		return false;
+	}
+
+	if ((cpuRegs.cycle - s_compileWindowStart) >= EE_COMPILE_WINDOW_CYCLES)
+	{
+		s_compileWindowStart = cpuRegs.cycle;
+		s_compileWindowInsts = 0;
+	}
+
+	EEColdBlock* cold = &s_coldBlocks[(HWADDR(startpc) >> 2) & (EE_COLD_TABLE_SIZE - 1)];
+	if (cold->pc != HWADDR(startpc))
+	{
+		cold->pc = HWADDR(startpc);
+		cold->runs = 0;
+	}
+
+	if (cold->runs < EE_WARM_BLOCK_RUNS ||
+		(s_compileWindowInsts >= EE_COMPILE_WINDOW_INSTS && cold->runs < EE_FORCE_COMPILE_RUNS))
+	{
+		cold->runs++;
+		return true;
+	}
+
+	return false;
+}
+
+// Called by JITCompile. Returns false if the block was interpreted instead of being compiled.
+static bool recCompileOrInterpret(const u32 startpc)
+{
+	if (recShouldDeferCompile(startpc))
+	{
+		intExecuteBlock(EE_INTERPRET_MAX_INSTS);
+
+		// Events raised by the interpreter's branches may have asked us to stop.
+		if (eeRecExitRequested)
+		{
+			eeRecExitRequested = false;
+			recExitExecution();
+		}
+
+		return false;
+	}
+
+	recRecompile(startpc);
+	s_compileWindowInsts += (pc - startpc) >> 2;
+	return true;
+}
+
 R5900cpu recCpu = {
 	recReserve,
 	recShutdown,
@@ -148,7 +148,7 @@ static void recBEQ_process(int process)
 			recompileNextInstruction(true, false);
 		}
 
-		SetBranchImm(branchTo);
+		SetBranchTaken(branchTo);
 
 		x86SetJ32(j32Ptr[0]);
 
@@ -160,7 +160,7 @@ static void recBEQ_process(int process)
 			recompileNextInstruction(true, false);
 		}
 
-		SetBranchImm(pc);
+		SetBranchFallthrough(pc);
 	}
 }
 
@@ -212,7 +212,7 @@ static void recBNE_process(int process)
 		recompileNextInstruction(true, false);
 	}
 
-	SetBranchImm(branchTo);
+	SetBranchTaken(branchTo);
 
 	x86SetJ32(j32Ptr[0]);
 
@@ -224,7 +224,7 @@ static void recBNE_process(int process)
 		recompileNextInstruction(true, false);
 	}
 
-	SetBranchImm(pc);
+	SetBranchFallthrough(pc);
 }
 
 void recBNE()
@@ -551,7 +551,7 @@ void recBLEZ()
 		recompileNextInstruction(true, false);
 	}
 
-	SetBranchImm(branchTo);
+	SetBranchTaken(branchTo);
 
 	x86SetJ32(j32Ptr[0]);
 
@@ -563,7 +563,7 @@ void recBLEZ()
 		recompileNextInstruction(true, false);
 	}
 
-	SetBranchImm(pc);
+	SetBranchFallthrough(pc);
 }
 
 //// BGTZ
@@ -600,7 +600,7 @@ void recBGTZ()
 		recompileNextInstruction(true, false);
 	}
 
-	SetBranchImm(branchTo);
+	SetBranchTaken(branchTo);
 
 	x86SetJ32(j32Ptr[0]);
 
@@ -612,7 +612,7 @@ void recBGTZ()
 		recompileNextInstruction(true, false);
 	}
 
-	SetBranchImm(pc);
+	SetBranchFallthrough(pc);
 }
 
 ////////////////////////////////////////////////////
@@ -642,7 +642,7 @@ void recBLTZ()
 		recompileNextInstruction(true, false);
 	}
 
-	SetBranchImm(branchTo);
+	SetBranchTaken(branchTo);
 
 	x86SetJ32(j32Ptr[0]);
 
@@ -654,7 +654,7 @@ void recBLTZ()
 		recompileNextInstruction(true, false);
 	}
 
-	SetBranchImm(pc);
+	SetBranchFallthrough(pc);
 }
 
 ////////////////////////////////////////////////////
@@ -685,7 +685,7 @@ void recBGEZ()
 		recompileNextInstruction(true, false);
 	}
 
-	SetBranchImm(branchTo);
+	SetBranchTaken(branchTo);
 
 	x86SetJ32(j32Ptr[0]);
 
@@ -697,7 +697,7 @@ void recBGEZ()
 		recompileNextInstruction(true, false);
 	}
 
-	SetBranchImm(pc);
+	SetBranchFallthrough(pc);
 }
 
 ////////////////////////////////////////////////////
@@ -5,6 +5,7 @@
 #include "vtlb.h"
 #include "x86/iCore.h"
 #include "x86/iR5900.h"
+#include "x86/iR5900CodeCache.h"
 
 #include "common/Perf.h"
 
@@ -38,6 +39,15 @@ static u32 GetAllocatedXMMBitmask()
 	return mask;
 }
 
+static void recAddLoadStoreInfo(uptr code_address, u32 code_size, u32 guest_pc, u32 gpr_bitmask, u32 fpr_bitmask,
+	u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr)
+{
+	vtlb_AddLoadStoreInfo(code_address, code_size, guest_pc, gpr_bitmask, fpr_bitmask, address_register,
+		data_register, size_in_bits, is_signed, is_load, is_fpr);
+	EE::CodeCache::NoteLoadStore(code_address, code_size, guest_pc, gpr_bitmask, fpr_bitmask, address_register,
+		data_register, size_in_bits, is_signed, is_load, is_fpr);
+}
+
 /*
 	// Pseudo-Code For the following Dynarec Implementations -->
 
@@ -431,7 +441,7 @@ int vtlb_DynGenReadNonQuad(u32 bits, bool sign, bool xmm, int addr_reg, vtlb_Rea
 	for (u32 i = 0; i < padding; i++)
 		xNOP();
 
-	vtlb_AddLoadStoreInfo((uptr)codeStart, static_cast<u32>(x86Ptr - codeStart),
+	recAddLoadStoreInfo((uptr)codeStart, static_cast<u32>(x86Ptr - codeStart),
 		pc, GetAllocatedGPRBitmask(), GetAllocatedXMMBitmask(),
 		static_cast<u8>(addr_reg), static_cast<u8>(x86_dest_reg),
 		static_cast<u8>(bits), sign, true, xmm);
@@ -450,6 +460,7 @@ int vtlb_DynGenReadNonQuad(u32 bits, bool sign, bool xmm, int addr_reg, vtlb_Rea
 int vtlb_DynGenReadNonQuad_Const(u32 bits, bool sign, bool xmm, u32 addr_const, vtlb_ReadRegAllocCallback dest_reg_alloc)
 {
 	EE::Profiler.EmitConstMem(addr_const);
+	EE::CodeCache::NoteConstAccess(addr_const);
 
 	int x86_dest_reg;
 	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
@@ -580,7 +591,7 @@ int vtlb_DynGenReadQuad(u32 bits, int addr_reg, vtlb_ReadRegAllocCallback dest_r
 	for (u32 i = 0; i < padding; i++)
 		xNOP();
 
-	vtlb_AddLoadStoreInfo((uptr)codeStart, static_cast<u32>(x86Ptr - codeStart),
+	recAddLoadStoreInfo((uptr)codeStart, static_cast<u32>(x86Ptr - codeStart),
 		pc, GetAllocatedGPRBitmask(), GetAllocatedXMMBitmask(),
 		static_cast<u8>(arg1reg.GetId()), static_cast<u8>(reg),
 		static_cast<u8>(bits), false, true, true);
@@ -597,6 +608,7 @@ int vtlb_DynGenReadQuad_Const(u32 bits, u32 addr_const, vtlb_ReadRegAllocCallbac
 	pxAssert(bits == 128);
 
 	EE::Profiler.EmitConstMem(addr_const);
+	EE::CodeCache::NoteConstAccess(addr_const);
 
 	int reg;
 	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
@@ -734,7 +746,7 @@ void vtlb_DynGenWrite(u32 sz, bool xmm, int addr_reg, int value_reg)
 	for (u32 i = 0; i < padding; i++)
 		xNOP();
 
-	vtlb_AddLoadStoreInfo((uptr)codeStart, static_cast<u32>(x86Ptr - codeStart),
+	recAddLoadStoreInfo((uptr)codeStart, static_cast<u32>(x86Ptr - codeStart),
 		pc, GetAllocatedGPRBitmask(), GetAllocatedXMMBitmask(),
 		static_cast<u8>(addr_reg), static_cast<u8>(value_reg),
 		static_cast<u8>(sz), false, false, xmm);
@@ -748,6 +760,7 @@ void vtlb_DynGenWrite(u32 sz, bool xmm, int addr_reg, int value_reg)
 void vtlb_DynGenWrite_Const(u32 bits, bool xmm, u32 addr_const, int value_reg)
 {
 	EE::Profiler.EmitConstMem(addr_const);
+	EE::CodeCache::NoteConstAccess(addr_const);
 
 #ifdef LOG_STORES
 	{
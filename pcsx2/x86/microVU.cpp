@@ -42,6 +42,8 @@ void mVUreset(microVU& mVU, bool resetReserve)
 		VU0.VI[REG_VPU_STAT].UL &= ~0x100;
 	}
 
+	JitProfiler::InvalidateBlocks(mVU.cache, mVU.index ? SysMemory::GetVU1RecEnd() : SysMemory::GetVU0RecEnd());
+
 	xSetPtr(mVU.cache);
 	mVUdispatcherAB(mVU);
 	mVUdispatcherCD(mVU);
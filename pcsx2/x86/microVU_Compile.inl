@@ -1010,6 +1010,9 @@ perf_and_return:
 			Perf::vu0.RegisterPC(thisPtr, static_cast<u32>(x86Ptr - thisPtr), startPC);
 	}
 
+	JitProfiler::RegisterBlock(mVU.index ? JitProfiler::Source::VU1 : JitProfiler::Source::VU0,
+		thisPtr, static_cast<u32>(x86Ptr - thisPtr), startPC);
+
 	return thisPtr;
 }
 
@@ -3,9 +3,14 @@
 
 #include "pcsx2/GS/GSBlock.h"
 #include "pcsx2/GS/GSClut.h"
+#include "pcsx2/GS/GSLocalMemory.h"
 #include "pcsx2/GS/MultiISA.h"
+#include "common/Timer.h"
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <memory>
 #include <string.h>
+#include <vector>
 
 #include "cpuinfo.h"
 
@@ -587,4 +592,236 @@ MULTI_ISA_TEST(WriteTest, Write4HL)
 	});
 }
 
+/// A whole page of source pixels, and two copies of the same destination page to write to
+struct PageTestData
+{
+	alignas(64) u8 src[GS_PAGE_SIZE];
+	alignas(64) u8 expected[GS_PAGE_SIZE];
+	alignas(64) u8 actual[GS_PAGE_SIZE];
+
+	PageTestData()
+	{
+		srand(0);
+		for (u32 i = 0; i < GS_PAGE_SIZE; i++)
+		{
+			src[i] = rand();
+			expected[i] = actual[i] = rand();
+		}
+	}
+};
+
+struct alignas(64) BenchPage
+{
+	u8 data[GS_PAGE_SIZE];
+};
+
+/// Checks that writing a page at once gives the same result as writing each of its blocks
+template <int pbw, int pbh, int bsx, int bsy, int bpp, typename BlockFn, typename PageFn>
+static void runPageTest(const GSBlockSwizzleTable& table, const char* name, BlockFn&& block, PageFn&& page)
+{
+	std::unique_ptr<PageTestData> data = std::make_unique<PageTestData>();
+	const int pitch = pbw * bsx * bpp / 8;
+
+	for (int by = 0; by < pbh; by++)
+	{
+		for (int bx = 0; bx < pbw; bx++)
+			block(&data->expected[table.lookup(bx, by) * GS_BLOCK_SIZE], &data->src[by * bsy * pitch + bx * bsx * bpp / 8], pitch);
+	}
+
+	page(data->actual, data->src, pitch);
+	GSBlock::StreamFence();
+
+	EXPECT_EQ(0, memcmp(data->expected, data->actual, GS_PAGE_SIZE)) << "Unexpected " << name;
+}
+
+/// Uploads a 32x32 page image, too big for the cache, both a block at a time and a page at a time, and prints the throughput of each
+template <int pbw, int pbh, int bsx, int bsy, int bpp, typename BlockFn, typename PageFn>
+static void runPageBenchmark(const GSBlockSwizzleTable& table, const char* name, BlockFn&& block, PageFn&& page)
+{
+	constexpr int pages_x = 32;
+	constexpr int pages_y = 32;
+	constexpr int iterations = 4;
+
+	const int page_pitch = pbw * bsx * bpp / 8;
+	const int page_rows = pbh * bsy;
+	const int pitch = page_pitch * pages_x;
+	const size_t src_size = static_cast<size_t>(pitch) * page_rows * pages_y;
+
+	std::vector<u8> src(src_size);
+	std::vector<BenchPage> expected(pages_x * pages_y);
+	std::vector<BenchPage> actual(pages_x * pages_y);
+	for (size_t i = 0; i < src_size; i++)
+		src[i] = static_cast<u8>((i * 2654435761u) >> 24);
+
+	Common::Timer timer;
+	for (int i = 0; i < iterations; i++)
+	{
+		for (int py = 0; py < pages_y; py++)
+		{
+			for (int px = 0; px < pages_x; px++)
+			{
+				const u8* s = &src[py * page_rows * pitch + px * page_pitch];
+				u8* d = expected[py * pages_x + px].data;
+				for (int by = 0; by < pbh; by++)
+				{
+					for (int bx = 0; bx < pbw; bx++)
+						block(&d[table.lookup(bx, by) * GS_BLOCK_SIZE], &s[by * bsy * pitch + bx * bsx * bpp / 8], pitch);
+				}
+			}
+		}
+	}
+	const double block_time = timer.GetTimeSecondsAndReset();
+
+	for (int i = 0; i < iterations; i++)
+	{
+		for (int py = 0; py < pages_y; py++)
+		{
+			for (int px = 0; px < pages_x; px++)
+				page(actual[py * pages_x + px].data, &src[py * page_rows * pitch + px * page_pitch], pitch);
+		}
+	}
+	GSBlock::StreamFence();
+	const double page_time = timer.GetTimeSecondsAndReset();
+
+	const double mb = static_cast<double>(src_size) * iterations / 1048576.0;
+	std::printf("[ BENCH    ] %s: %.0f MB/s per block, %.0f MB/s per page\n", name, mb / block_time, mb / page_time);
+
+	for (size_t i = 0; i < expected.size(); i++)
+		EXPECT_EQ(0, memcmp(expected[i].data, actual[i].data, GS_PAGE_SIZE)) << "Unexpected " << name << " page " << i;
+}
+
+static void writeBlock32(u8* dst, const u8* src, int pitch) { GSBlock::WriteBlock32<32, 0xFFFFFFFF>(dst, src, pitch); }
+static void writeBlock16(u8* dst, const u8* src, int pitch) { GSBlock::WriteBlock16<32>(dst, src, pitch); }
+static void writeBlock8(u8* dst, const u8* src, int pitch) { GSBlock::WriteBlock8<32>(dst, src, pitch); }
+static void writeBlock4(u8* dst, const u8* src, int pitch) { GSBlock::WriteBlock4<32>(dst, src, pitch); }
+
+static void writePage32(u8* dst, const u8* src, int pitch) { GSBlock::WritePage32<32>(dst, src, pitch, blockTable32); }
+static void writePage16(u8* dst, const u8* src, int pitch) { GSBlock::WritePage16<32>(dst, src, pitch, blockTable16); }
+static void writePage8(u8* dst, const u8* src, int pitch) { GSBlock::WritePage8<32>(dst, src, pitch, blockTable8); }
+static void writePage4(u8* dst, const u8* src, int pitch) { GSBlock::WritePage4<32>(dst, src, pitch, blockTable4); }
+
+MULTI_ISA_TEST(WritePageTest, Write32)
+{
+	SKIP_IF_UNSUPPORTED();
+	runPageTest<8, 4, 8, 8, 32>(blockTable32, "WritePage32", writeBlock32, writePage32);
+}
+
+MULTI_ISA_TEST(WritePageTest, Write16)
+{
+	SKIP_IF_UNSUPPORTED();
+	runPageTest<4, 8, 16, 8, 16>(blockTable16, "WritePage16", writeBlock16, writePage16);
+}
+
+MULTI_ISA_TEST(WritePageTest, Write8)
+{
+	SKIP_IF_UNSUPPORTED();
+	runPageTest<8, 4, 16, 16, 8>(blockTable8, "WritePage8", writeBlock8, writePage8);
+}
+
+MULTI_ISA_TEST(WritePageTest, Write4)
+{
+	SKIP_IF_UNSUPPORTED();
+	runPageTest<4, 8, 32, 16, 4>(blockTable4, "WritePage4", writeBlock4, writePage4);
+}
+
+/// Uploads an image big enough to be streamed a page at a time through WriteImage, and checks it matches
+/// the same image uploaded as a series of transfers small enough to go through the block path
+static void runWriteImageTest(u32 psm, const char* name)
+{
+	std::unique_ptr<GSLocalMemory> mem = std::make_unique<GSLocalMemory>();
+
+	// The constructor picks the functions for the host CPU, test the ones for this ISA instead.
+	GSLocalMemoryPopulateFunctions(*mem);
+
+	const GSLocalMemory::psm_t& psm_s = GSLocalMemory::m_psm[psm];
+	const int width = 256;
+	const int srcpitch = width * psm_s.trbpp / 8;
+	// 512KB of whole pages, followed by a row of blocks which isn't a whole page.
+	const int rows = (512 * 1024 / srcpitch) + psm_s.bs.y;
+
+	GIFRegBITBLTBUF BITBLTBUF = {};
+	BITBLTBUF.DBP = 0;
+	BITBLTBUF.DBW = width / 64;
+	BITBLTBUF.DPSM = psm;
+	GIFRegTRXPOS TRXPOS = {};
+	GIFRegTRXREG TRXREG = {};
+	TRXREG.RRW = width;
+	TRXREG.RRH = rows;
+
+	std::vector<u8> src(static_cast<size_t>(srcpitch) * rows);
+	for (size_t i = 0; i < src.size(); i++)
+		src[i] = static_cast<u8>((i * 2654435761u) >> 24);
+
+	int tx = 0, ty = 0;
+	for (int y = 0; y < rows; y += psm_s.bs.y)
+		psm_s.wi(*mem, tx, ty, &src[static_cast<size_t>(y) * srcpitch], srcpitch * psm_s.bs.y, BITBLTBUF, TRXPOS, TRXREG);
+
+	const std::vector<u8> expected(mem->vm8(), mem->vm8() + GSLocalMemory::m_vmsize);
+	memset(mem->vm8(), 0, GSLocalMemory::m_vmsize);
+
+	tx = 0;
+	ty = 0;
+	psm_s.wi(*mem, tx, ty, src.data(), static_cast<int>(src.size()), BITBLTBUF, TRXPOS, TRXREG);
+
+	EXPECT_EQ(rows, ty) << "Unexpected " << name << " end row";
+	EXPECT_EQ(0, memcmp(expected.data(), mem->vm8(), GSLocalMemory::m_vmsize)) << "Unexpected " << name;
+
+	MULTI_ISA_SELECT(GSLocalMemoryPopulateFunctions)(*mem);
+}
+
+MULTI_ISA_TEST(WriteImageTest, Write32)
+{
+	SKIP_IF_UNSUPPORTED();
+	runWriteImageTest(PSMCT32, "WriteImage32");
+}
+
+MULTI_ISA_TEST(WriteImageTest, Write16)
+{
+	SKIP_IF_UNSUPPORTED();
+	runWriteImageTest(PSMCT16, "WriteImage16");
+}
+
+MULTI_ISA_TEST(WriteImageTest, Write16S)
+{
+	SKIP_IF_UNSUPPORTED();
+	runWriteImageTest(PSMCT16S, "WriteImage16S");
+}
+
+MULTI_ISA_TEST(WriteImageTest, Write8)
+{
+	SKIP_IF_UNSUPPORTED();
+	runWriteImageTest(PSMT8, "WriteImage8");
+}
+
+MULTI_ISA_TEST(WriteImageTest, Write4)
+{
+	SKIP_IF_UNSUPPORTED();
+	runWriteImageTest(PSMT4, "WriteImage4");
+}
+
+// Too slow to run with the other tests, use --gtest_also_run_disabled_tests to run these.
+MULTI_ISA_TEST(WritePageBenchmark, DISABLED_Write32)
+{
+	SKIP_IF_UNSUPPORTED();
+	runPageBenchmark<8, 4, 8, 8, 32>(blockTable32, "WritePage32", writeBlock32, writePage32);
+}
+
+MULTI_ISA_TEST(WritePageBenchmark, DISABLED_Write16)
+{
+	SKIP_IF_UNSUPPORTED();
+	runPageBenchmark<4, 8, 16, 8, 16>(blockTable16, "WritePage16", writeBlock16, writePage16);
+}
+
+MULTI_ISA_TEST(WritePageBenchmark, DISABLED_Write8)
+{
+	SKIP_IF_UNSUPPORTED();
+	runPageBenchmark<8, 4, 16, 16, 8>(blockTable8, "WritePage8", writeBlock8, writePage8);
+}
+
+MULTI_ISA_TEST(WritePageBenchmark, DISABLED_Write4)
+{
+	SKIP_IF_UNSUPPORTED();
+	runPageBenchmark<4, 8, 32, 16, 4>(blockTable4, "WritePage4", writeBlock4, writePage4);
+}
+
 MULTI_ISA_UNSHARED_END
@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/x86/iR5900CodeCache.h"
+#include <gtest/gtest.h>
+
+#include <set>
+
+TEST(EECodeCache, BlockKeyIncludesFlags)
+{
+	static constexpr u32 code[4] = {0x24020001, 0x14400002, 0x00000000, 0x03e00008};
+	const u8* guest = reinterpret_cast<const u8*>(code);
+	static constexpr u32 startpc = 0x00100000;
+	static constexpr u32 endpc = startpc + sizeof(code);
+
+	// Every combination of flags must give the same range its own key.
+	static constexpr u32 all_flags = EE::CodeCache::BLOCK_FLAG_SPLIT | EE::CodeCache::BLOCK_FLAG_DIE |
+									 EE::CodeCache::BLOCK_FLAG_PROFILE | EE::CodeCache::BLOCK_FLAG_SUPER;
+	std::set<u64> keys;
+	for (u32 flags = 0; flags <= all_flags; flags++)
+		ASSERT_TRUE(keys.insert(EE::CodeCache::GetBlockKey(startpc, endpc, flags, guest)).second) << "flags " << flags;
+
+	ASSERT_EQ(EE::CodeCache::GetBlockKey(startpc, endpc, EE::CodeCache::BLOCK_FLAG_SUPER, guest),
+		EE::CodeCache::GetBlockKey(startpc, endpc, EE::CodeCache::BLOCK_FLAG_SUPER, guest));
+}